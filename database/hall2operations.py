@@ -337,23 +337,28 @@ class HallSymbol:
 
 
 def dump_operations(filename):
+    """Print rows of DatabaseOperation symmetry_operations[] in spg_database.c
+
+    Rotations are printed as they are and translations multiplied by 12.
+
+    """
     hall_symbols = read_spg_csv(filename)
     count = 0
-    print("  0       ,  /* dummy */")
+    print("    {{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}, {0, 0, 0}}, /* dummy */")
     for i in range(len(hall_symbols)):
         hs = HallSymbol(hall_symbols[i][0])
         G_R, G_T = hs.get_operations()
         for j, (r, t) in enumerate(zip(G_R, G_T)):
             count += 1
-            total = encode_symmetry(r, t)
-            r_enc_dec, t_enc_dec = decode_symmetry(total)
+            r_enc_dec, t_enc_dec = decode_symmetry(encode_symmetry(r, t))
             assert np.allclose(r_enc_dec, r.reshape(-1).tolist())
             assert np.allclose(t_enc_dec, t * 12)
 
-            text = "  %-8d," % (total)
-            text += " /* %4d (%3d) [" % (count, i + 1)
-            text += "%2d," * 9 % tuple(r_enc_dec)
-            text += "%2d,%2d,%2d] */" % tuple(t_enc_dec)
+            text = "    {{{%d, %d, %d}, {%d, %d, %d}, {%d, %d, %d}}, " % tuple(
+                r_enc_dec
+            )
+            text += "{%d, %d, %d}}," % tuple(t_enc_dec)
+            text += " /* %4d (%3d) */" % (count, i + 1)
             print(text)
 
 
@@ -0,0 +1,146 @@
+#!/usr/bin/env python
+"""Generate the candidate axes of lattice symmetry in src/axes_database.c.
+
+get_lattice_symmetry in src/symmetry.c looks for the integer matrices that
+keep the metric tensor of the Delaunay reduced lattice. Their columns are
+taken from the 26 relative axes below. Only the 6960 unimodular matrices out
+of 26^3 can be lattice symmetry operations, so they are enumerated here once.
+A matrix whose columns are relative_axes[i], relative_axes[j] and
+relative_axes[k] is encoded as i * 26 * 26 + j * 26 + k, in ascending order.
+
+Usage: python make_axes_db.py > ../src/axes_database.c
+"""
+
+import itertools
+
+import numpy as np
+
+relative_axes = [
+    [1, 0, 0],
+    [0, 1, 0],
+    [0, 0, 1],
+    [-1, 0, 0],
+    [0, -1, 0],
+    [0, 0, -1],
+    [0, 1, 1],
+    [1, 0, 1],
+    [1, 1, 0],
+    [0, -1, -1],
+    [-1, 0, -1],
+    [-1, -1, 0],
+    [0, 1, -1],
+    [-1, 0, 1],
+    [1, -1, 0],
+    [0, -1, 1],
+    [1, 0, -1],
+    [-1, 1, 0],
+    [1, 1, 1],
+    [-1, -1, -1],
+    [-1, 1, 1],
+    [1, -1, 1],
+    [1, 1, -1],
+    [1, -1, -1],
+    [-1, 1, -1],
+    [-1, -1, 1],
+]
+
+header = """/* Copyright (C) 2008 Atsushi Togo */
+/* All rights reserved. */
+
+/* This file is part of spglib. */
+
+/* Redistribution and use in source and binary forms, with or without */
+/* modification, are permitted provided that the following conditions */
+/* are met: */
+
+/* * Redistributions of source code must retain the above copyright */
+/*   notice, this list of conditions and the following disclaimer. */
+
+/* * Redistributions in binary form must reproduce the above copyright */
+/*   notice, this list of conditions and the following disclaimer in */
+/*   the documentation and/or other materials provided with the */
+/*   distribution. */
+
+/* * Neither the name of the spglib project nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission. */
+
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE */
+/* COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, */
+/* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, */
+/* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; */
+/* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER */
+/* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT */
+/* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN */
+/* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
+/* POSSIBILITY OF SUCH DAMAGE. */
+
+/* Generated by database/make_axes_db.py */
+
+#include "axes_database.h"
+"""
+
+footer = """
+int axdb_get_num_unimodular_axes(void) {
+    return sizeof(unimodular_axes) / sizeof(unimodular_axes[0]);
+}
+
+/* Set the indices of relative_axes of the three columns of the index-th */
+/* unimodular candidate. */
+void axdb_get_unimodular_axes(int indices[3], int const index) {
+    indices[0] = unimodular_axes[index] / 676; /* = 26**2 */
+    indices[1] = (unimodular_axes[index] / 26) % 26;
+    indices[2] = unimodular_axes[index] % 26;
+}
+
+void axdb_get_relative_axis(int axis[3], int const index) {
+    axis[0] = relative_axes[index][0];
+    axis[1] = relative_axes[index][1];
+    axis[2] = relative_axes[index][2];
+}
+"""
+
+
+def get_unimodular_axes():
+    """Return the encoded unimodular matrices in ascending order."""
+    encoded = []
+    for i, j, k in itertools.product(range(26), repeat=3):
+        axes = np.transpose([relative_axes[i], relative_axes[j], relative_axes[k]])
+        if abs(round(np.linalg.det(axes))) == 1:
+            encoded.append(i * 26 * 26 + j * 26 + k)
+    return encoded
+
+
+def format_array(values, width=80, indent=4):
+    """Format integers in aligned columns as clang-format does."""
+    column = max(len(str(v)) for v in values) + 2
+    num_columns = (width - indent) // column
+    lines = []
+    for i in range(0, len(values), num_columns):
+        items = [f"{v},".ljust(column) for v in values[i : i + num_columns]]
+        lines.append(" " * indent + "".join(items).rstrip())
+    return "\n".join(lines)
+
+
+def main():
+    print(header)
+    print("static int const relative_axes[][3] = {")
+    for i in range(0, 26, 5):
+        items = [
+            "{%d, %d, %d}," % tuple(axis) for axis in relative_axes[i : i + 5]
+        ]
+        print("    " + " ".join(items))
+    print("};")
+    print("")
+    print("/* Unimodular matrices whose columns are taken from relative_axes. */")
+    print("static int const unimodular_axes[] = {")
+    print(format_array(get_unimodular_axes()))
+    print("};")
+    print(footer, end="")
+
+
+if __name__ == "__main__":
+    main()
@@ -35,6 +35,8 @@
 #ifndef __spglib_H__
 #define __spglib_H__
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -139,6 +141,7 @@ typedef enum {
     SPGERR_NIGGLI_FAILED,
     SPGERR_DELAUNAY_FAILED,
     SPGERR_ARRAY_SIZE_SHORTAGE,
+    SPGERR_WORK_BUDGET_EXCEEDED,
     SPGERR_NONE,
 } SpglibError;
 
@@ -168,8 +171,26 @@ typedef struct {
     int *std_mapping_to_primitive;
     /* int pointgroup_number; */
     char pointgroup_symbol[6];
+    int n_pure_translations;
+    double (*pure_translations)[3];
 } SpglibDataset;
 
+/* Fields of SpglibDataset computed by spg_get_dataset_with_options in */
+/* addition to the space-group type, transformation_matrix, origin_shift, */
+/* primitive_lattice, mapping_to_primitive and pointgroup_symbol. */
+typedef enum {
+    SPGLIB_DATASET_SPACEGROUP_TYPE = 0,
+    /* rotations and translations */
+    SPGLIB_DATASET_OPERATIONS = 1,
+    /* wyckoffs, site_symmetry_symbols, equivalent_atoms and */
+    /* crystallographic_orbits */
+    SPGLIB_DATASET_WYCKOFFS = 2,
+    /* std_lattice, std_types, std_positions, std_rotation_matrix and */
+    /* std_mapping_to_primitive */
+    SPGLIB_DATASET_STD_CELL = 4,
+    SPGLIB_DATASET_ALL = 7,
+} SpglibDatasetOption;
+
 typedef struct {
     int number;
     char international_short[11];
@@ -223,6 +244,9 @@ typedef struct {
     int type;
 } SpglibMagneticSpacegroupType;
 
+/* Opaque storage of temporary memory reused by dataset searches */
+typedef struct SpglibWorkspace SpglibWorkspace;
+
 SPG_API const char *spg_get_version();
 SPG_API const char *spg_get_version_full();
 SPG_API const char *spg_get_commit();
@@ -233,6 +257,14 @@ SPG_API int spg_get_micro_version();
 SPG_API SpglibError spg_get_error_code(void);
 SPG_API char *spg_get_error_message(SpglibError spglib_error);
 
+/* Each subsequent search of the calling thread gives up with */
+/* SPGERR_WORK_BUDGET_EXCEEDED once it takes more than max_seconds of the */
+/* wall-clock time or checks more than max_overlap_checks operations */
+/* against the atoms. Zero or a negative value means unlimited, which is */
+/* the default. */
+SPG_API void spg_set_work_budget(double const max_seconds,
+                                 long long const max_overlap_checks);
+
 SPG_API SpglibDataset *spg_get_dataset(double const lattice[3][3],
                                        double const position[][3],
                                        int const types[], int const num_atom,
@@ -271,9 +303,135 @@ SPG_API SpglibDataset *spgat_get_dataset_with_hall_number(
     int const num_atom, int const hall_number, double const symprec,
     double const angle_tolerance);
 
+/* Datasets of many cells are searched in one call. The cells are packed */
+/* into one array of positions and types: the atoms of the i-th cell are */
+/* those from offsets[i] to offsets[i + 1] - 1, and its lattice is */
+/* lattices[i], i.e., offsets has num_cells + 1 elements starting from 0. */
+/* datasets[i] and error_codes[i] are set in the input order. datasets[i] */
+/* is NULL if the search of the i-th cell failed, and otherwise it has to */
+/* be freed by spg_free_dataset. The cells are processed in parallel when */
+/* spglib is built with OpenMP. The number of cells whose datasets were */
+/* found is returned. */
+SPG_API int spg_get_datasets(SpglibDataset *datasets[],
+                             SpglibError error_codes[],
+                             double const lattices[][3][3],
+                             double const positions[][3], int const types[],
+                             int const offsets[], int const num_cells,
+                             double const symprec);
+
+SPG_API int spgat_get_datasets(SpglibDataset *datasets[],
+                               SpglibError error_codes[],
+                               double const lattices[][3][3],
+                               double const positions[][3], int const types[],
+                               int const offsets[], int const num_cells,
+                               double const symprec,
+                               double const angle_tolerance);
+
+/* Space group number, Hall number and number of symmetry operations are */
+/* searched for each of num_symprec tolerances in symprecs, with the same */
+/* results as spg_get_dataset at each tolerance. They are set to 0 for */
+/* the tolerances where the search failed. The work of the search of the */
+/* cell is shared by the tolerances. The number of tolerances at which */
+/* the space group was found is returned. */
+SPG_API int spg_get_dataset_tolerance_scan(
+    int spacegroup_numbers[], int hall_numbers[], int n_operations[],
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprecs[], int const num_symprec);
+
+SPG_API int spgat_get_dataset_tolerance_scan(
+    int spacegroup_numbers[], int hall_numbers[], int n_operations[],
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprecs[], int const num_symprec,
+    double const angle_tolerance);
+
+/* The symmetry operations of the dataset are factorized into the coset */
+/* representatives in rotations and translations and the pure */
+/* translations p_i in pure_translations, where p_0 = 0. This saves the */
+/* memory by the factor n_pure_translations for supercells. The full set */
+/* of operations is obtained by spg_expand_dataset_operations. */
+SPG_API SpglibDataset *spg_get_factorized_dataset(double const lattice[3][3],
+                                                  double const position[][3],
+                                                  int const types[],
+                                                  int const num_atom,
+                                                  double const symprec);
+
+SPG_API SpglibDataset *spgat_get_factorized_dataset(
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprec, double const angle_tolerance);
+
+/* Symmetry operations of a dataset are expanded by the pure translations */
+/* to those in the order of spg_get_dataset. The number of operations is */
+/* returned, and 0 if it exceeds max_size. */
+SPG_API int spg_expand_dataset_operations(int rotation[][3][3],
+                                          double translation[][3],
+                                          int const max_size,
+                                          SpglibDataset const *dataset);
+
+/* A workspace keeps the temporary memory of dataset searches for the */
+/* next calls instead of releasing it. A workspace must not be used by */
+/* more than one thread at the same time. */
+SPG_API SpglibWorkspace *spg_alloc_workspace(void);
+SPG_API void spg_free_workspace(SpglibWorkspace *workspace);
+
+/* Size in bytes of a buffer that can hold the dataset of any cell with */
+/* num_atom atoms. */
+SPG_API size_t spg_get_dataset_buffer_size(int const num_atom);
+
+/* The dataset is written into buffer of buffer_size bytes instead of */
+/* being allocated, and the returned pointer points into buffer. It must */
+/* not be freed by spg_free_dataset. The temporary memory is kept in */
+/* workspace unless it is NULL, so that repeated calls for cells of */
+/* similar sizes do not allocate memory. */
+SPG_API SpglibDataset *spg_get_dataset_in_buffer(
+    void *buffer, size_t const buffer_size, SpglibWorkspace *workspace,
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprec);
+
+SPG_API SpglibDataset *spgat_get_dataset_in_buffer(
+    void *buffer, size_t const buffer_size, SpglibWorkspace *workspace,
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprec, double const angle_tolerance);
+
+/* Dataset of a cell slightly changed from that of prev_dataset, e.g., the */
+/* next step of a relaxation or molecular dynamics. When the operations of */
+/* prev_dataset still hold, only the space-group type of prev_dataset is */
+/* tried, otherwise the dataset is searched as spg_get_dataset. */
+SPG_API SpglibDataset *spg_update_dataset(SpglibDataset const *prev_dataset,
+                                          double const lattice[3][3],
+                                          double const position[][3],
+                                          int const types[],
+                                          int const num_atom,
+                                          double const symprec);
+SPG_API SpglibDataset *spgat_update_dataset(
+    SpglibDataset const *prev_dataset, double const lattice[3][3],
+    double const position[][3], int const types[], int const num_atom,
+    double const symprec, double const angle_tolerance);
+
+/* Only the fields of options, a bitwise OR of SpglibDatasetOption, are */
+/* computed, and the arrays of the others are NULL with n_operations and */
+/* n_std_atoms of 0. SPGLIB_DATASET_ALL gives the same as spg_get_dataset. */
+SPG_API SpglibDataset *spg_get_dataset_with_options(
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, int const options, double const symprec);
+
+SPG_API SpglibDataset *spgat_get_dataset_with_options(
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, int const options, double const symprec,
+    double const angle_tolerance);
+
 SPG_API void spg_free_dataset(SpglibDataset *dataset);
 SPG_API void spg_free_magnetic_dataset(SpglibMagneticDataset *dataset);
 
+/* A dataset and its arrays are in one memory block of */
+/* spg_get_dataset_size bytes starting at the dataset. The block can be */
+/* copied byte by byte, e.g., by memcpy, to store or send the dataset, */
+/* and spg_rebase_dataset points the arrays of the copy into itself. */
+/* spg_copy_dataset returns such a copy to be freed by spg_free_dataset, */
+/* and NULL if failed. */
+SPG_API size_t spg_get_dataset_size(SpglibDataset const *dataset);
+SPG_API SpglibDataset *spg_copy_dataset(SpglibDataset const *dataset);
+SPG_API SpglibDataset *spg_rebase_dataset(SpglibDataset *dataset);
+
 SPG_DEPRECATED("Use the variables from SpglibDataset (rotations, translations)")
 SPG_API int spg_get_symmetry(int rotation[][3][3], double translation[][3],
                              int const max_size, double const lattice[3][3],
@@ -351,6 +509,34 @@ SPG_API int spgms_get_symmetry_with_site_tensors(
     int const with_time_reversal, int const is_axial, double const symprec,
     double const angle_tolerance, double const mag_symprec);
 
+/**
+ * @brief Check given symmetry operations against a cell
+ *
+ * @param[out] is_symmetry 1 if the i-th operation maps the cell onto itself,
+ * otherwise 0
+ * @param[out] permutations The i-th operation maps atom j onto atom
+ * permutations[i * num_atom + j], or -1 if it is not a symmetry. Can be NULL.
+ * @param[out] max_displacements Largest Cartesian distance between the atoms
+ * mapped by the i-th operation, or -1 if it is not a symmetry. Can be NULL.
+ * @param rotation Matrix parts of the operations
+ * @param translation Vector parts of the operations
+ * @param num_operations Number of the operations
+ * @param lattice
+ * @param position
+ * @param types
+ * @param num_atom
+ * @param symprec
+ * @return int Number of the operations that are symmetry of the cell. Return
+ * -1 if failed, e.g., when the work budget is exceeded, and the reason is set
+ * to the error code.
+ */
+SPG_API int spg_verify_symmetry_operations(
+    int is_symmetry[], int permutations[], double max_displacements[],
+    int const rotation[][3][3], double const translation[][3],
+    int const num_operations, double const lattice[3][3],
+    double const position[][3], int const types[], int const num_atom,
+    double const symprec);
+
 // spg_get_spacegroup_type_from_symmetry is a direct replacement
 SPG_DEPRECATED(
     "Use the variable from SpglibSpacegroupType instead (hall_number)")
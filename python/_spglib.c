@@ -43,6 +43,9 @@ static PyObject *py_get_version_string(PyObject *self, PyObject *args);
 static PyObject *py_get_version_full(PyObject *self, PyObject *args);
 static PyObject *py_get_commit(PyObject *self, PyObject *args);
 static PyObject *py_get_dataset(PyObject *self, PyObject *args);
+static PyObject *py_get_factorized_dataset(PyObject *self, PyObject *args);
+static PyObject *py_get_datasets(PyObject *self, PyObject *args);
+static PyObject *py_get_dataset_tolerance_scan(PyObject *self, PyObject *args);
 static PyObject *py_get_layerdataset(PyObject *self, PyObject *args);
 static PyObject *py_get_magnetic_dataset(PyObject *self, PyObject *args);
 static PyObject *py_get_spacegroup_type(PyObject *self, PyObject *args);
@@ -56,6 +59,7 @@ static PyObject *py_get_pointgroup(PyObject *self, PyObject *args);
 static PyObject *py_standardize_cell(PyObject *self, PyObject *args);
 static PyObject *py_refine_cell(PyObject *self, PyObject *args);
 static PyObject *py_get_symmetry(PyObject *self, PyObject *args);
+static PyObject *py_verify_symmetry_operations(PyObject *self, PyObject *args);
 static PyObject *py_get_symmetry_with_collinear_spin(PyObject *self,
                                                      PyObject *args);
 static PyObject *py_get_symmetry_with_site_tensors(PyObject *self,
@@ -78,6 +82,7 @@ static PyObject *py_niggli_reduce(PyObject *self, PyObject *args);
 static PyObject *py_get_hall_number_from_symmetry(PyObject *self,
                                                   PyObject *args);
 static PyObject *py_get_error_message(PyObject *self, PyObject *args);
+static PyObject *py_set_work_budget(PyObject *self, PyObject *args);
 
 struct module_state {
     PyObject *error;
@@ -96,6 +101,12 @@ static PyMethodDef _spglib_methods[] = {
     {"version_full", py_get_version_full, METH_NOARGS, "Spglib version"},
     {"commit", py_get_commit, METH_NOARGS, "Spglib version"},
     {"dataset", py_get_dataset, METH_VARARGS, "Dataset for crystal symmetry"},
+    {"factorized_dataset", py_get_factorized_dataset, METH_VARARGS,
+     "Dataset with symmetry operations factorized by pure translations"},
+    {"datasets", py_get_datasets, METH_VARARGS,
+     "Datasets for crystal symmetry of many cells"},
+    {"dataset_tolerance_scan", py_get_dataset_tolerance_scan, METH_VARARGS,
+     "Space group types and numbers of operations over tolerances"},
     {"layerdataset", py_get_layerdataset, METH_VARARGS,
      "Dataset for layer symmetry"},
     {"magnetic_dataset", py_get_magnetic_dataset, METH_VARARGS,
@@ -118,6 +129,8 @@ static PyMethodDef _spglib_methods[] = {
     {"standardize_cell", py_standardize_cell, METH_VARARGS, "Standardize cell"},
     {"refine_cell", py_refine_cell, METH_VARARGS, "Refine cell"},
     {"symmetry", py_get_symmetry, METH_VARARGS, "Symmetry operations"},
+    {"verify_symmetry_operations", py_verify_symmetry_operations, METH_VARARGS,
+     "Check given symmetry operations against a cell"},
     {"symmetry_with_collinear_spin", py_get_symmetry_with_collinear_spin,
      METH_VARARGS, "Symmetry operations with collinear spin magnetic moments"},
     {"symmetry_with_site_tensors", py_get_symmetry_with_site_tensors,
@@ -141,6 +154,8 @@ static PyMethodDef _spglib_methods[] = {
     {"hall_number_from_symmetry", py_get_hall_number_from_symmetry,
      METH_VARARGS, "Space group type is searched from symmetry operations."},
     {"error_message", py_get_error_message, METH_VARARGS, "Error message"},
+    {"work_budget", py_set_work_budget, METH_VARARGS,
+     "Set work budget of searches"},
 
     {NULL, NULL, 0, NULL}};
 
@@ -214,17 +229,53 @@ static PyObject *py_get_commit(PyObject *self, PyObject *args) {
     return PyUnicode_FromString(spg_get_commit());
 }
 
-PyObject *build_python_list_from_dataset(SpglibDataset *dataset) {
-    int len_list = 21;
-    PyObject *array, *vec, *mat, *rot, *trans, *wyckoffs, *equiv_atoms;
-    PyObject *crystallographic_orbits;
-    PyObject *site_symmetry_symbols, *primitive_lattice, *mapping_to_primitive;
-    PyObject *std_lattice, *std_types, *std_positions,
-        *std_mapping_to_primitive;
+static void free_dataset_capsule(PyObject *capsule) {
+    spg_free_dataset(
+        (SpglibDataset *)PyCapsule_GetPointer(capsule, "spglib.dataset"));
+}
 
-    PyObject *std_rotation;
+/* Return a NumPy array viewing data in the dataset owned by capsule, */
+/* which is kept alive as the base object of the array. */
+static PyObject *build_array_view(PyObject *capsule, void *data,
+                                  int const ndim, npy_intp const *dims,
+                                  int const typenum) {
+    PyObject *view;
+
+    if ((view = PyArray_SimpleNewFromData(ndim, (npy_intp *)dims, typenum,
+                                          data)) == NULL) {
+        return NULL;
+    }
+    Py_INCREF(capsule);
+    if (PyArray_SetBaseObject((PyArrayObject *)view, capsule) < 0) {
+        Py_DECREF(view);
+        return NULL;
+    }
+    return view;
+}
+
+/* The ownership of the dataset is moved to the returned list. Its arrays */
+/* are NumPy arrays viewing the dataset, which is freed by */
+/* spg_free_dataset after all of them are released. */
+PyObject *build_python_list_from_dataset(SpglibDataset *dataset) {
+    int len_list = 22;
+    PyObject *array, *capsule, *wyckoffs, *site_symmetry_symbols;
+    npy_intp const dims_3[1] = {3};
+    npy_intp const dims_3x3[2] = {3, 3};
+    npy_intp const dims_rot[3] = {dataset->n_operations, 3, 3};
+    npy_intp const dims_trans[2] = {dataset->n_operations, 3};
+    npy_intp const dims_pure_trans[2] = {dataset->n_pure_translations, 3};
+    npy_intp const dims_atoms[1] = {dataset->n_atoms};
+    npy_intp const dims_std_atoms[1] = {dataset->n_std_atoms};
+    npy_intp const dims_std_pos[2] = {dataset->n_std_atoms, 3};
+
+    int i, n;
+
+    if ((capsule = PyCapsule_New(dataset, "spglib.dataset",
+                                 free_dataset_capsule)) == NULL) {
+        spg_free_dataset(dataset);
+        return NULL;
+    }
 
-    int i, j, k, n;
     array = PyList_New(len_list);
     n = 0;
 
@@ -242,147 +293,84 @@ PyObject *build_python_list_from_dataset(SpglibDataset *dataset) {
     n++;
 
     /* Transformation matrix */
-    mat = PyList_New(3);
-    for (i = 0; i < 3; i++) {
-        vec = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            PyList_SetItem(
-                vec, j,
-                PyFloat_FromDouble(dataset->transformation_matrix[i][j]));
-        }
-        PyList_SetItem(mat, i, vec);
-    }
-    PyList_SetItem(array, n, mat);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->transformation_matrix,
+                                    2, dims_3x3, NPY_DOUBLE));
     n++;
 
     /* Origin shift */
-    vec = PyList_New(3);
-    for (i = 0; i < 3; i++) {
-        PyList_SetItem(vec, i, PyFloat_FromDouble(dataset->origin_shift[i]));
-    }
-    PyList_SetItem(array, n, vec);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->origin_shift, 1, dims_3,
+                                    NPY_DOUBLE));
     n++;
 
     /* Rotation matrices */
-    rot = PyList_New(dataset->n_operations);
-    for (i = 0; i < dataset->n_operations; i++) {
-        mat = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            vec = PyList_New(3);
-            for (k = 0; k < 3; k++) {
-                PyList_SetItem(
-                    vec, k, PyLong_FromLong((long)dataset->rotations[i][j][k]));
-            }
-            PyList_SetItem(mat, j, vec);
-        }
-        PyList_SetItem(rot, i, mat);
-    }
-    PyList_SetItem(array, n, rot);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->rotations, 3, dims_rot,
+                                    NPY_INT));
     n++;
 
     /* Translation vectors */
-    trans = PyList_New(dataset->n_operations);
-    for (i = 0; i < dataset->n_operations; i++) {
-        vec = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            PyList_SetItem(vec, j,
-                           PyFloat_FromDouble(dataset->translations[i][j]));
-        }
-        PyList_SetItem(trans, i, vec);
-    }
-    PyList_SetItem(array, n, trans);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->translations, 2,
+                                    dims_trans, NPY_DOUBLE));
     n++;
 
     /* Wyckoff letters, Equivalent atoms */
     wyckoffs = PyList_New(dataset->n_atoms);
     site_symmetry_symbols = PyList_New(dataset->n_atoms);
-    crystallographic_orbits = PyList_New(dataset->n_atoms);
-    equiv_atoms = PyList_New(dataset->n_atoms);
-    mapping_to_primitive = PyList_New(dataset->n_atoms);
     for (i = 0; i < dataset->n_atoms; i++) {
         PyList_SetItem(wyckoffs, i,
                        PyLong_FromLong((long)dataset->wyckoffs[i]));
         PyList_SetItem(site_symmetry_symbols, i,
                        PyUnicode_FromString(dataset->site_symmetry_symbols[i]));
-        PyList_SetItem(equiv_atoms, i,
-                       PyLong_FromLong((long)dataset->equivalent_atoms[i]));
-        PyList_SetItem(
-            crystallographic_orbits, i,
-            PyLong_FromLong((long)dataset->crystallographic_orbits[i]));
-        PyList_SetItem(mapping_to_primitive, i,
-                       PyLong_FromLong((long)dataset->mapping_to_primitive[i]));
     }
     PyList_SetItem(array, n, wyckoffs);
     n++;
     PyList_SetItem(array, n, site_symmetry_symbols);
     n++;
-    PyList_SetItem(array, n, crystallographic_orbits);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->crystallographic_orbits,
+                                    1, dims_atoms, NPY_INT));
     n++;
-    PyList_SetItem(array, n, equiv_atoms);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->equivalent_atoms, 1,
+                                    dims_atoms, NPY_INT));
     n++;
 
-    primitive_lattice = PyList_New(3);
-    for (i = 0; i < 3; i++) {
-        vec = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            PyList_SetItem(
-                vec, j, PyFloat_FromDouble(dataset->primitive_lattice[i][j]));
-        }
-        PyList_SetItem(primitive_lattice, i, vec);
-    }
-    PyList_SetItem(array, n, primitive_lattice);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->primitive_lattice, 2,
+                                    dims_3x3, NPY_DOUBLE));
     n++;
 
-    PyList_SetItem(array, n, mapping_to_primitive);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->mapping_to_primitive, 1,
+                                    dims_atoms, NPY_INT));
     n++;
 
-    std_lattice = PyList_New(3);
-    for (i = 0; i < 3; i++) {
-        vec = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            PyList_SetItem(vec, j,
-                           PyFloat_FromDouble(dataset->std_lattice[i][j]));
-        }
-        PyList_SetItem(std_lattice, i, vec);
-    }
-    PyList_SetItem(array, n, std_lattice);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->std_lattice, 2, dims_3x3,
+                                    NPY_DOUBLE));
     n++;
 
     /* Standardized unit cell */
-    std_types = PyList_New(dataset->n_std_atoms);
-    std_positions = PyList_New(dataset->n_std_atoms);
-    std_mapping_to_primitive = PyList_New(dataset->n_std_atoms);
-    for (i = 0; i < dataset->n_std_atoms; i++) {
-        vec = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            PyList_SetItem(vec, j,
-                           PyFloat_FromDouble(dataset->std_positions[i][j]));
-        }
-        PyList_SetItem(std_types, i,
-                       PyLong_FromLong((long)dataset->std_types[i]));
-        PyList_SetItem(std_positions, i, vec);
-        PyList_SetItem(
-            std_mapping_to_primitive, i,
-            PyLong_FromLong((long)dataset->std_mapping_to_primitive[i]));
-    }
-    PyList_SetItem(array, n, std_types);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->std_types, 1,
+                                    dims_std_atoms, NPY_INT));
     n++;
-    PyList_SetItem(array, n, std_positions);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->std_positions, 2,
+                                    dims_std_pos, NPY_DOUBLE));
     n++;
 
-    std_rotation = PyList_New(3);
-    for (i = 0; i < 3; i++) {
-        vec = PyList_New(3);
-        for (j = 0; j < 3; j++) {
-            PyList_SetItem(
-                vec, j, PyFloat_FromDouble(dataset->std_rotation_matrix[i][j]));
-        }
-        PyList_SetItem(std_rotation, i, vec);
-    }
-    PyList_SetItem(array, n, std_rotation);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->std_rotation_matrix, 2,
+                                    dims_3x3, NPY_DOUBLE));
     n++;
 
-    PyList_SetItem(array, n, std_mapping_to_primitive);
+    PyList_SetItem(array, n,
+                   build_array_view(capsule, dataset->std_mapping_to_primitive,
+                                    1, dims_std_atoms, NPY_INT));
     n++;
 
     /* Point group */
@@ -392,6 +380,19 @@ PyObject *build_python_list_from_dataset(SpglibDataset *dataset) {
     PyList_SetItem(array, n, PyUnicode_FromString(dataset->pointgroup_symbol));
     n++;
 
+    /* Pure translations of factorized dataset */
+    if (dataset->n_pure_translations > 0) {
+        PyList_SetItem(array, n,
+                       build_array_view(capsule, dataset->pure_translations, 2,
+                                        dims_pure_trans, NPY_DOUBLE));
+    } else {
+        Py_INCREF(Py_None);
+        PyList_SetItem(array, n, Py_None);
+    }
+    n++;
+
+    Py_DECREF(capsule);
+
     assert(n == len_list);
     return array;
 }
@@ -420,18 +421,161 @@ static PyObject *py_get_dataset(PyObject *self, PyObject *args) {
     num_atom = PyArray_DIMS(py_positions)[0];
     typat = (int *)PyArray_DATA(py_atom_types);
 
-    if ((dataset = spgat_get_dataset_with_hall_number(
-             lat, pos, typat, num_atom, hall_number, symprec,
-             angle_tolerance)) == NULL) {
+    Py_BEGIN_ALLOW_THREADS
+    dataset = spgat_get_dataset_with_hall_number(
+        lat, pos, typat, num_atom, hall_number, symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
+
+    if (dataset == NULL) {
         Py_RETURN_NONE;
     }
 
     array = build_python_list_from_dataset(dataset);
-    spg_free_dataset(dataset);
 
     return array;
 }
 
+static PyObject *py_get_factorized_dataset(PyObject *self, PyObject *args) {
+    double symprec, angle_tolerance;
+    PyArrayObject *py_lattice;
+    PyArrayObject *py_positions;
+    PyArrayObject *py_atom_types;
+    PyObject *array;
+    double(*lat)[3];
+    double(*pos)[3];
+    int num_atom;
+    int *typat;
+    SpglibDataset *dataset;
+
+    if (!PyArg_ParseTuple(args, "OOOdd", &py_lattice, &py_positions,
+                          &py_atom_types, &symprec, &angle_tolerance)) {
+        return NULL;
+    }
+
+    lat = (double(*)[3])PyArray_DATA(py_lattice);
+    pos = (double(*)[3])PyArray_DATA(py_positions);
+    num_atom = PyArray_DIMS(py_positions)[0];
+    typat = (int *)PyArray_DATA(py_atom_types);
+
+    Py_BEGIN_ALLOW_THREADS
+    dataset = spgat_get_factorized_dataset(lat, pos, typat, num_atom, symprec,
+                                           angle_tolerance);
+    Py_END_ALLOW_THREADS
+
+    if (dataset == NULL) {
+        Py_RETURN_NONE;
+    }
+
+    array = build_python_list_from_dataset(dataset);
+
+    return array;
+}
+
+static PyObject *py_get_datasets(PyObject *self, PyObject *args) {
+    double symprec, angle_tolerance;
+    PyArrayObject *py_lattices;
+    PyArrayObject *py_positions;
+    PyArrayObject *py_atom_types;
+    PyArrayObject *py_offsets;
+    PyObject *array;
+    double(*lat)[3][3];
+    double(*pos)[3];
+    int *typat;
+    int *offsets;
+    int i, num_cells;
+    SpglibDataset **datasets;
+    SpglibError *error_codes;
+
+    if (!PyArg_ParseTuple(args, "OOOOdd", &py_lattices, &py_positions,
+                          &py_atom_types, &py_offsets, &symprec,
+                          &angle_tolerance)) {
+        return NULL;
+    }
+
+    lat = (double(*)[3][3])PyArray_DATA(py_lattices);
+    pos = (double(*)[3])PyArray_DATA(py_positions);
+    typat = (int *)PyArray_DATA(py_atom_types);
+    offsets = (int *)PyArray_DATA(py_offsets);
+    num_cells = PyArray_DIMS(py_lattices)[0];
+
+    datasets = (SpglibDataset **)malloc(sizeof(SpglibDataset *) * num_cells);
+    error_codes = (SpglibError *)malloc(sizeof(SpglibError) * num_cells);
+    if (datasets == NULL || error_codes == NULL) {
+        free(datasets);
+        free(error_codes);
+        return PyErr_NoMemory();
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    spgat_get_datasets(datasets, error_codes, lat, pos, typat, offsets,
+                       num_cells, symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
+
+    array = PyList_New(num_cells);
+    for (i = 0; i < num_cells; i++) {
+        if (datasets[i] == NULL) {
+            Py_INCREF(Py_None);
+            PyList_SetItem(array, i, Py_None);
+        } else {
+            PyList_SetItem(array, i,
+                           build_python_list_from_dataset(datasets[i]));
+        }
+    }
+
+    free(datasets);
+    free(error_codes);
+
+    return array;
+}
+
+static PyObject *py_get_dataset_tolerance_scan(PyObject *self,
+                                               PyObject *args) {
+    double angle_tolerance;
+    PyArrayObject *py_spacegroup_numbers;
+    PyArrayObject *py_hall_numbers;
+    PyArrayObject *py_n_operations;
+    PyArrayObject *py_lattice;
+    PyArrayObject *py_positions;
+    PyArrayObject *py_atom_types;
+    PyArrayObject *py_symprecs;
+
+    int *spacegroup_numbers;
+    int *hall_numbers;
+    int *n_operations;
+    double(*lat)[3];
+    double(*pos)[3];
+    int num_atom;
+    int *typat;
+    double *symprecs;
+    int num_symprec;
+    int num_found;
+
+    if (!PyArg_ParseTuple(args, "OOOOOOOd", &py_spacegroup_numbers,
+                          &py_hall_numbers, &py_n_operations, &py_lattice,
+                          &py_positions, &py_atom_types, &py_symprecs,
+                          &angle_tolerance)) {
+        return NULL;
+    }
+
+    spacegroup_numbers = (int *)PyArray_DATA(py_spacegroup_numbers);
+    hall_numbers = (int *)PyArray_DATA(py_hall_numbers);
+    n_operations = (int *)PyArray_DATA(py_n_operations);
+    lat = (double(*)[3])PyArray_DATA(py_lattice);
+    pos = (double(*)[3])PyArray_DATA(py_positions);
+    num_atom = PyArray_DIMS(py_positions)[0];
+    typat = (int *)PyArray_DATA(py_atom_types);
+    symprecs = (double *)PyArray_DATA(py_symprecs);
+    num_symprec = PyArray_DIMS(py_symprecs)[0];
+
+    Py_BEGIN_ALLOW_THREADS
+    num_found = spgat_get_dataset_tolerance_scan(
+        spacegroup_numbers, hall_numbers, n_operations, lat, pos, typat,
+        num_atom, symprecs, num_symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
+
+    return PyLong_FromLong((long)num_found);
+}
+
 static PyObject *py_get_layerdataset(PyObject *self, PyObject *args) {
     int aperiodic_dir;
     double symprec;
@@ -472,8 +616,10 @@ static PyObject *py_get_layerdataset(PyObject *self, PyObject *args) {
     num_atom = PyArray_DIMS(py_positions)[0];
     typat = (int *)PyArray_DATA(py_atom_types);
 
+    Py_BEGIN_ALLOW_THREADS
     dataset = spg_get_layer_dataset(lat, pos, typat, num_atom, aperiodic_dir,
                                     symprec);
+    Py_END_ALLOW_THREADS
 
     if (!dataset) {
         Py_RETURN_NONE;
@@ -483,7 +629,6 @@ static PyObject *py_get_layerdataset(PyObject *self, PyObject *args) {
     // from layer dataset exactly as it would from normal dataset.
     // It should be checked that all of this information makes sense.
     array = build_python_list_from_dataset(dataset);
-    spg_free_dataset(dataset);
 
     return array;
 }
@@ -518,9 +663,13 @@ static PyObject *py_get_magnetic_dataset(PyObject *self, PyObject *args) {
     typeat = (int *)PyArray_DATA(py_atom_types);
     tensors = (double *)PyArray_DATA(py_magmoms);
 
-    if ((dataset = spgms_get_magnetic_dataset(
-             lat, pos, typeat, tensors, tensor_rank, num_atom, is_axial,
-             symprec, angle_tolerance, mag_symprec)) == NULL) {
+    Py_BEGIN_ALLOW_THREADS
+    dataset = spgms_get_magnetic_dataset(lat, pos, typeat, tensors,
+                                         tensor_rank, num_atom, is_axial,
+                                         symprec, angle_tolerance, mag_symprec);
+    Py_END_ALLOW_THREADS
+
+    if (dataset == NULL) {
         Py_RETURN_NONE;
     }
 
@@ -805,8 +954,10 @@ static PyObject *py_get_spacegroup_type_from_symmetry(PyObject *self,
     lat = (double(*)[3])PyArray_DATA(py_lattice);
     num_sym = PyArray_DIMS(py_rotations)[0];
 
+    Py_BEGIN_ALLOW_THREADS
     spg_type = spg_get_spacegroup_type_from_symmetry(rot, trans, num_sym, lat,
                                                      symprec);
+    Py_END_ALLOW_THREADS
     if (spg_type.number == 0) {
         Py_RETURN_NONE;
     }
@@ -904,9 +1055,11 @@ static PyObject *py_get_magnetic_spacegroup_type_from_symmetry(PyObject *self,
     lattice = (double(*)[3])PyArray_DATA(py_lattice);
     num_operations = PyArray_DIMS(py_rotations)[0];
 
+    Py_BEGIN_ALLOW_THREADS
     msg_type = spg_get_magnetic_spacegroup_type_from_symmetry(
         rotations, translations, time_reversals, num_operations, lattice,
         symprec);
+    Py_END_ALLOW_THREADS
     if (msg_type.number == 0) {
         Py_RETURN_NONE;
     }
@@ -982,9 +1135,11 @@ static PyObject *py_standardize_cell(PyObject *self, PyObject *args) {
     pos = (double(*)[3])PyArray_DATA(py_positions);
     typat = (int *)PyArray_DATA(py_atom_types);
 
+    Py_BEGIN_ALLOW_THREADS
     num_atom_std =
         spgat_standardize_cell(lat, pos, typat, num_atom, to_primitive,
                                no_idealize, symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromLong((long)num_atom_std);
 }
@@ -1011,8 +1166,10 @@ static PyObject *py_refine_cell(PyObject *self, PyObject *args) {
     pos = (double(*)[3])PyArray_DATA(py_positions);
     typat = (int *)PyArray_DATA(py_atom_types);
 
+    Py_BEGIN_ALLOW_THREADS
     num_atom_std =
         spgat_refine_cell(lat, pos, typat, num_atom, symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromLong((long)num_atom_std);
 }
@@ -1039,8 +1196,10 @@ static PyObject *py_find_primitive(PyObject *self, PyObject *args) {
     num_atom = PyArray_DIMS(py_positions)[0];
     types = (int *)PyArray_DATA(py_atom_types);
 
+    Py_BEGIN_ALLOW_THREADS
     num_atom_prim = spgat_find_primitive(lat, pos, types, num_atom, symprec,
                                          angle_tolerance);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromLong((long)num_atom_prim);
 }
@@ -1077,8 +1236,60 @@ static PyObject *py_get_symmetry(PyObject *self, PyObject *args) {
     num_sym_from_array_size = PyArray_DIMS(py_rotations)[0];
 
     /* num_sym has to be larger than num_sym_from_array_size. */
+    Py_BEGIN_ALLOW_THREADS
     num_sym = spgat_get_symmetry(rot, trans, num_sym_from_array_size, lat, pos,
                                  types, num_atom, symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong((long)num_sym);
+}
+
+static PyObject *py_verify_symmetry_operations(PyObject *self,
+                                               PyObject *args) {
+    double symprec;
+    PyArrayObject *py_is_symmetry;
+    PyArrayObject *py_permutations;
+    PyArrayObject *py_max_displacements;
+    PyArrayObject *py_rotations;
+    PyArrayObject *py_translations;
+    PyArrayObject *py_lattice;
+    PyArrayObject *py_positions;
+    PyArrayObject *py_atom_types;
+
+    int *is_symmetry;
+    int *permutations;
+    double *max_displacements;
+    int(*rot)[3][3];
+    double(*trans)[3];
+    int num_operations;
+    double(*lat)[3];
+    double(*pos)[3];
+    int *types;
+    int num_atom;
+    int num_sym;
+
+    if (!PyArg_ParseTuple(args, "OOOOOOOOd", &py_is_symmetry, &py_permutations,
+                          &py_max_displacements, &py_rotations,
+                          &py_translations, &py_lattice, &py_positions,
+                          &py_atom_types, &symprec)) {
+        return NULL;
+    }
+
+    is_symmetry = (int *)PyArray_DATA(py_is_symmetry);
+    permutations = (int *)PyArray_DATA(py_permutations);
+    max_displacements = (double *)PyArray_DATA(py_max_displacements);
+    rot = (int(*)[3][3])PyArray_DATA(py_rotations);
+    trans = (double(*)[3])PyArray_DATA(py_translations);
+    num_operations = PyArray_DIMS(py_rotations)[0];
+    lat = (double(*)[3])PyArray_DATA(py_lattice);
+    pos = (double(*)[3])PyArray_DATA(py_positions);
+    types = (int *)PyArray_DATA(py_atom_types);
+    num_atom = PyArray_DIMS(py_positions)[0];
+
+    Py_BEGIN_ALLOW_THREADS
+    num_sym = spg_verify_symmetry_operations(
+        is_symmetry, permutations, max_displacements, rot, trans,
+        num_operations, lat, pos, types, num_atom, symprec);
+    Py_END_ALLOW_THREADS
     return PyLong_FromLong((long)num_sym);
 }
 
@@ -1122,9 +1333,11 @@ static PyObject *py_get_symmetry_with_collinear_spin(PyObject *self,
     num_sym_from_array_size = PyArray_DIMS(py_rotations)[0];
 
     /* num_sym has to be larger than num_sym_from_array_size. */
+    Py_BEGIN_ALLOW_THREADS
     num_sym = spgat_get_symmetry_with_collinear_spin(
         rot, trans, equiv_atoms, num_sym_from_array_size, lat, pos, types,
         spins, num_atom, symprec, angle_tolerance);
+    Py_END_ALLOW_THREADS
     return PyLong_FromLong((long)num_sym);
 }
 
@@ -1183,11 +1396,13 @@ static PyObject *py_get_symmetry_with_site_tensors(PyObject *self,
     }
 
     /* num_sym has to be larger than num_sym_from_array_size. */
+    Py_BEGIN_ALLOW_THREADS
     num_sym = spgms_get_symmetry_with_site_tensors(
         rot, trans, equiv_atoms, primitive_lattice, spin_flips,
         num_sym_from_array_size, lat, pos, types, tensors, tensor_rank,
         num_atom, with_time_reversal, is_axial, symprec, angle_tolerance,
         mag_symprec);
+    Py_END_ALLOW_THREADS
     return PyLong_FromLong((long)num_sym);
 }
 
@@ -1252,17 +1467,21 @@ static PyObject *py_get_ir_reciprocal_mesh(PyObject *self, PyObject *args) {
     if (PyArray_TYPE(py_grid_mapping_table) == NPY_UINTP) {
         grid_mapping_table_size_t =
             (size_t *)PyArray_DATA(py_grid_mapping_table);
+        Py_BEGIN_ALLOW_THREADS
         num_ir_size_t = spg_get_dense_ir_reciprocal_mesh(
             grid_address, grid_mapping_table_size_t, mesh, is_shift,
             is_time_reversal, lat, pos, types, num_atom, symprec);
+        Py_END_ALLOW_THREADS
         return PyLong_FromSize_t(num_ir_size_t);
     }
     if (PyArray_TYPE(py_grid_mapping_table) == NPY_INT) {
         grid_mapping_table_int = (int *)PyArray_DATA(py_grid_mapping_table);
         /* num_sym has to be larger than num_sym_from_array_size. */
+        Py_BEGIN_ALLOW_THREADS
         num_ir_int = spg_get_ir_reciprocal_mesh(
             grid_address, grid_mapping_table_int, mesh, is_shift,
             is_time_reversal, lat, pos, types, num_atom, symprec);
+        Py_END_ALLOW_THREADS
         return PyLong_FromLong((long)num_ir_int);
     }
 
@@ -1309,16 +1528,20 @@ static PyObject *py_get_stabilized_reciprocal_mesh(PyObject *self,
     if (PyArray_TYPE(py_grid_mapping_table) == NPY_UINTP) {
         grid_mapping_table_size_t =
             (size_t *)PyArray_DATA(py_grid_mapping_table);
+        Py_BEGIN_ALLOW_THREADS
         num_ir_size_t = spg_get_dense_stabilized_reciprocal_mesh(
             grid_address, grid_mapping_table_size_t, mesh, is_shift,
             is_time_reversal, num_rot, rot, num_q, q);
+        Py_END_ALLOW_THREADS
         return PyLong_FromSize_t(num_ir_size_t);
     }
     if (PyArray_TYPE(py_grid_mapping_table) == NPY_INT) {
         grid_mapping_table_int = (int *)PyArray_DATA(py_grid_mapping_table);
+        Py_BEGIN_ALLOW_THREADS
         num_ir_int = spg_get_stabilized_reciprocal_mesh(
             grid_address, grid_mapping_table_int, mesh, is_shift,
             is_time_reversal, num_rot, rot, num_q, q);
+        Py_END_ALLOW_THREADS
         return PyLong_FromLong((long)num_ir_int);
     }
 
@@ -1352,8 +1575,10 @@ static PyObject *py_get_grid_points_by_rotations(PyObject *self,
     mesh = (int *)PyArray_DATA(py_mesh);
     is_shift = (int *)PyArray_DATA(py_is_shift);
 
+    Py_BEGIN_ALLOW_THREADS
     spg_get_dense_grid_points_by_rotations(
         rot_grid_points, address_orig, num_rot, rot_reciprocal, mesh, is_shift);
+    Py_END_ALLOW_THREADS
     Py_RETURN_NONE;
 }
 
@@ -1388,9 +1613,11 @@ static PyObject *py_get_BZ_grid_points_by_rotations(PyObject *self,
     is_shift = (int *)PyArray_DATA(py_is_shift);
     bz_map = (size_t *)PyArray_DATA(py_bz_map);
 
+    Py_BEGIN_ALLOW_THREADS
     spg_get_dense_BZ_grid_points_by_rotations(rot_grid_points, address_orig,
                                               num_rot, rot_reciprocal, mesh,
                                               is_shift, bz_map);
+    Py_END_ALLOW_THREADS
     Py_RETURN_NONE;
 }
 
@@ -1423,9 +1650,11 @@ static PyObject *py_relocate_BZ_grid_address(PyObject *self, PyObject *args) {
     is_shift = (int *)PyArray_DATA(py_is_shift);
     reciprocal_lattice = (double(*)[3])PyArray_DATA(py_reciprocal_lattice);
 
+    Py_BEGIN_ALLOW_THREADS
     num_ir_gp = spg_relocate_dense_BZ_grid_address(
         bz_grid_address, bz_map, grid_address, mesh, reciprocal_lattice,
         is_shift);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromSize_t(num_ir_gp);
 }
@@ -1443,7 +1672,9 @@ static PyObject *py_delaunay_reduce(PyObject *self, PyObject *args) {
 
     lattice = (double(*)[3])PyArray_DATA(py_lattice);
 
+    Py_BEGIN_ALLOW_THREADS
     result = spg_delaunay_reduce(lattice, symprec);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromLong((long)result);
 }
@@ -1461,7 +1692,9 @@ static PyObject *py_niggli_reduce(PyObject *self, PyObject *args) {
 
     lattice = (double(*)[3])PyArray_DATA(py_lattice);
 
+    Py_BEGIN_ALLOW_THREADS
     result = spg_niggli_reduce(lattice, eps);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromLong((long)result);
 }
@@ -1487,8 +1720,10 @@ static PyObject *py_get_hall_number_from_symmetry(PyObject *self,
     trans = (double(*)[3])PyArray_DATA(py_translations);
     num_sym = PyArray_DIMS(py_rotations)[0];
 
+    Py_BEGIN_ALLOW_THREADS
     hall_number =
         spg_get_hall_number_from_symmetry(rot, trans, num_sym, symprec);
+    Py_END_ALLOW_THREADS
 
     return PyLong_FromLong((long)hall_number);
 }
@@ -1504,3 +1739,16 @@ static PyObject *py_get_error_message(PyObject *self, PyObject *args) {
 
     return PyUnicode_FromString(spg_get_error_message(error));
 }
+
+static PyObject *py_set_work_budget(PyObject *self, PyObject *args) {
+    double max_seconds;
+    long long max_overlap_checks;
+
+    if (!PyArg_ParseTuple(args, "dL", &max_seconds, &max_overlap_checks)) {
+        return NULL;
+    }
+
+    spg_set_work_budget(max_seconds, max_overlap_checks);
+
+    Py_RETURN_NONE;
+}
@@ -42,9 +42,11 @@ from .spglib import (  # noqa: F401
     SpglibDataset,
     SpglibMagneticDataset,
     delaunay_reduce,
+    expand_symmetry_operations,
     find_primitive,
     get_BZ_grid_points_by_rotations,
     get_error_message,
+    get_factorized_symmetry_dataset,
     get_grid_point_from_address,
     get_grid_points_by_rotations,
     get_hall_number_from_symmetry,
@@ -62,15 +64,19 @@ from .spglib import (  # noqa: F401
     get_stabilized_reciprocal_mesh,
     get_symmetry,
     get_symmetry_dataset,
+    get_symmetry_dataset_tolerance_scan,
+    get_symmetry_datasets,
     get_symmetry_from_database,
     get_version,
     niggli_reduce,
     refine_cell,
     relocate_BZ_grid_address,
+    set_work_budget,
     spg_get_commit,
     spg_get_version,
     spg_get_version_full,
     standardize_cell,
+    verify_symmetry_operations,
 )
 
 # fmt: on
@@ -272,6 +272,17 @@ class SpglibDataset(DictInterface):
     standardized cell."""
     pointgroup: str
     """Pointgroup symbol in Hermann-Mauguin notation."""
+    pure_translations: NDArray[np.double] | None = None
+    """Pure translations of a factorized dataset.
+
+    shape=(n_pure_translations, 3), order='C', dtype='double'
+
+    This is given only by :func:`get_factorized_symmetry_dataset`, where
+    ``rotations`` and ``translations`` are the coset representatives of the
+    pure translations. Otherwise None.
+
+    .. versionadded:: 2.6.0
+    """
 
 
 @dataclasses.dataclass(eq=False, frozen=True)
@@ -651,6 +662,88 @@ def get_symmetry(
         )
 
 
+def verify_symmetry_operations(
+    cell: Cell,
+    rotations: ArrayLike[np.intc],
+    translations: ArrayLike[np.double],
+    symprec=1e-5,
+) -> tuple[NDArray[np.bool_], NDArray[np.intc], NDArray[np.double]] | None:
+    """Check which of given symmetry operations map a cell onto itself.
+
+    This is much cheaper than searching the symmetry of the cell when the
+    candidate operations are known, e.g., from a previous calculation or a
+    parent structure.
+
+    Parameters
+    ----------
+    cell : Cell
+        See :func:`get_symmetry`.
+    rotations : array_like[int], shape=(n_operations, 3, 3)
+        Matrix parts of the operations.
+    translations : array_like[float], shape=(n_operations, 3)
+        Vector parts of the operations.
+    symprec : float
+        See :func:`get_symmetry`.
+
+    Returns
+    -------
+    is_symmetry : ndarray[bool], shape=(n_operations,)
+        Whether each operation is a symmetry operation of the cell.
+    permutations : ndarray[int], shape=(n_operations, n_atoms)
+        The i-th operation maps the j-th atom onto the
+        ``permutations[i, j]``-th atom. -1 for the operations that are not
+        symmetry operations.
+    max_displacements : ndarray[float], shape=(n_operations,)
+        Largest Cartesian distance between the atoms mapped by each
+        operation. -1 for the operations that are not symmetry operations.
+
+        None is returned if the check failed, e.g., when the work budget is
+        exceeded. See :func:`get_error_message`.
+
+    Raises
+    ------
+    ValueError
+        If the numbers of rotations and translations differ.
+
+    Notes
+    -----
+    .. versionadded:: 2.6.0
+
+    """
+    _set_no_error()
+
+    lattice, positions, numbers, _ = _expand_cell(cell)
+    rotations = np.array(rotations, dtype="intc", order="C").reshape(-1, 3, 3)
+    translations = np.array(translations, dtype="double", order="C")
+    translations = translations.reshape(-1, 3)
+    if len(translations) != len(rotations):
+        raise ValueError(
+            "rotations and translations have to have the same number of "
+            "operations."
+        )
+    num_operations = len(rotations)
+    is_symmetry = np.zeros(num_operations, dtype="intc")
+    permutations = np.zeros((num_operations, len(positions)), dtype="intc")
+    max_displacements = np.zeros(num_operations, dtype="double")
+
+    num_sym = _spglib.verify_symmetry_operations(
+        is_symmetry,
+        permutations,
+        max_displacements,
+        rotations,
+        translations,
+        lattice,
+        positions,
+        numbers,
+        symprec,
+    )
+    _set_error_message()
+    if num_sym < 0:
+        return None
+
+    return is_symmetry.astype(bool), permutations, max_displacements
+
+
 def get_magnetic_symmetry(
     cell: Cell,
     symprec=1e-5,
@@ -815,6 +908,8 @@ def get_magnetic_symmetry(
 
 
 def _build_dataset_dict(spg_ds: list) -> SpglibDataset:
+    # The arrays given by _spglib are views of the dataset allocated in C,
+    # which is freed when all of them are released.
     letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
 
     dataset = SpglibDataset(
@@ -823,47 +918,31 @@ def _build_dataset_dict(spg_ds: list) -> SpglibDataset:
         international=spg_ds[2].strip(),
         hall=spg_ds[3].strip(),
         choice=spg_ds[4].strip(),
-        transformation_matrix=np.array(
-            spg_ds[5],
-            dtype="double",
-            order="C",
-        ),
-        origin_shift=np.array(spg_ds[6], dtype="double"),
-        rotations=np.array(spg_ds[7], dtype="intc", order="C"),
-        translations=np.array(spg_ds[8], dtype="double", order="C"),
+        transformation_matrix=spg_ds[5],
+        origin_shift=spg_ds[6],
+        rotations=spg_ds[7],
+        translations=spg_ds[8],
         wyckoffs=[letters[x] for x in spg_ds[9]],
         site_symmetry_symbols=[s.strip() for s in spg_ds[10]],
-        crystallographic_orbits=np.array(
-            spg_ds[11],
-            dtype="intc",
-        ),
-        equivalent_atoms=np.array(spg_ds[12], dtype="intc"),
+        crystallographic_orbits=spg_ds[11],
+        equivalent_atoms=spg_ds[12],
         primitive_lattice=np.array(
             np.transpose(spg_ds[13]),
             dtype="double",
             order="C",
         ),
-        mapping_to_primitive=np.array(
-            spg_ds[14],
-            dtype="intc",
-        ),
+        mapping_to_primitive=spg_ds[14],
         std_lattice=np.array(
             np.transpose(spg_ds[15]),
             dtype="double",
             order="C",
         ),
-        std_types=np.array(spg_ds[16], dtype="intc"),
-        std_positions=np.array(spg_ds[17], dtype="double", order="C"),
-        std_rotation_matrix=np.array(
-            spg_ds[18],
-            dtype="double",
-            order="C",
-        ),
-        std_mapping_to_primitive=np.array(
-            spg_ds[19],
-            dtype="intc",
-        ),
+        std_types=spg_ds[16],
+        std_positions=spg_ds[17],
+        std_rotation_matrix=spg_ds[18],
+        std_mapping_to_primitive=spg_ds[19],
         pointgroup=spg_ds[20].strip(),
+        pure_translations=spg_ds[21],
     )
     return dataset
 
@@ -929,6 +1008,217 @@ def get_symmetry_dataset(
     return dataset
 
 
+def get_symmetry_datasets(
+    cells: Sequence[Cell],
+    symprec=1e-5,
+    angle_tolerance=-1.0,
+) -> list[SpglibDataset | None]:
+    """Search symmetry datasets of many cells in one call.
+
+    The cells are passed to the C library at once and, when spglib is built
+    with OpenMP, their datasets are searched in parallel.
+
+    Parameters
+    ----------
+    cells : Sequence[Cell]
+        Crystal structures. See :func:`get_symmetry` for a cell.
+    symprec, angle_tolerance:
+        See :func:`get_symmetry`.
+
+    Returns
+    -------
+    datasets: list[:class:`SpglibDataset` | None]
+        Datasets in the order of ``cells``. None is set for the cells whose
+        symmetry search failed, and the error message is that of the first
+        failed cell.
+
+    Notes
+    -----
+    .. versionadded:: 2.6.0
+
+    """
+    _set_no_error()
+
+    lattices = []
+    positions = []
+    numbers = []
+    offsets = [0]
+    for cell in cells:
+        lattice, cell_positions, cell_numbers, _ = _expand_cell(cell)
+        lattices.append(lattice)
+        positions.append(cell_positions)
+        numbers.append(cell_numbers)
+        offsets.append(offsets[-1] + len(cell_numbers))
+
+    if not lattices:
+        return []
+
+    spg_ds_list = _spglib.datasets(
+        np.array(lattices, dtype="double", order="C"),
+        np.array(np.concatenate(positions), dtype="double", order="C"),
+        np.array(np.concatenate(numbers), dtype="intc"),
+        np.array(offsets, dtype="intc"),
+        symprec,
+        angle_tolerance,
+    )
+
+    datasets = []
+    for spg_ds in spg_ds_list:
+        if spg_ds is None:
+            datasets.append(None)
+        else:
+            datasets.append(_build_dataset_dict(spg_ds))
+    if None in datasets:
+        _set_error_message()
+
+    return datasets
+
+
+def get_symmetry_dataset_tolerance_scan(
+    cell: Cell,
+    symprecs: Sequence[float],
+    angle_tolerance=-1.0,
+) -> tuple[NDArray[np.intc], NDArray[np.intc], NDArray[np.intc]]:
+    """Search space group types and numbers of symmetry operations of a cell
+    for many tolerances in one call.
+
+    Every tolerance gives the same result as :func:`get_symmetry_dataset`
+    with that ``symprec``, and the work of the search of the cell is shared
+    by the tolerances.
+
+    Parameters
+    ----------
+    cell : Cell
+        See :func:`get_symmetry`.
+    symprecs : Sequence[float]
+        Distance tolerances in Cartesian coordinates in any order.
+    angle_tolerance:
+        See :func:`get_symmetry`.
+
+    Returns
+    -------
+    spacegroup_numbers: ndarray[int], shape=(len(symprecs),)
+        International space group numbers. 0 where the search failed.
+    hall_numbers: ndarray[int], shape=(len(symprecs),)
+        Hall numbers. 0 where the search failed.
+    n_operations: ndarray[int], shape=(len(symprecs),)
+        Numbers of symmetry operations of the cell. 0 where the search failed.
+
+    Notes
+    -----
+    .. versionadded:: 2.6.0
+
+    """
+    _set_no_error()
+
+    lattice, positions, numbers, _ = _expand_cell(cell)
+    symprecs = np.array(symprecs, dtype="double", order="C")
+    spacegroup_numbers = np.zeros(len(symprecs), dtype="intc")
+    hall_numbers = np.zeros(len(symprecs), dtype="intc")
+    n_operations = np.zeros(len(symprecs), dtype="intc")
+
+    num_found = _spglib.dataset_tolerance_scan(
+        spacegroup_numbers,
+        hall_numbers,
+        n_operations,
+        lattice,
+        positions,
+        numbers,
+        symprecs,
+        angle_tolerance,
+    )
+    if len(symprecs) > 0 and num_found == 0:
+        _set_error_message()
+
+    return spacegroup_numbers, hall_numbers, n_operations
+
+
+def get_factorized_symmetry_dataset(
+    cell: Cell,
+    symprec=1e-5,
+    angle_tolerance=-1.0,
+) -> SpglibDataset | None:
+    """Search symmetry dataset whose operations are factorized by the pure
+    translations.
+
+    For a supercell of a primitive cell, ``rotations`` and ``translations``
+    contain only the coset representatives of the pure translations, which
+    are given by ``pure_translations``. This makes the dataset smaller by
+    the factor of the number of pure translations. The full set of
+    operations is obtained by :func:`expand_symmetry_operations`.
+
+    Parameters
+    ----------
+    cell, symprec, angle_tolerance:
+        See :func:`get_symmetry`.
+
+    Returns
+    -------
+    dataset: :class:`SpglibDataset` | None
+        If it fails, None is returned.
+
+    Notes
+    -----
+    .. versionadded:: 2.6.0
+
+    """
+    _set_no_error()
+
+    lattice, positions, numbers, _ = _expand_cell(cell)
+
+    spg_ds = _spglib.factorized_dataset(
+        lattice,
+        positions,
+        numbers,
+        symprec,
+        angle_tolerance,
+    )
+    if spg_ds is None:
+        _set_error_message()
+        return None
+
+    return _build_dataset_dict(spg_ds)
+
+
+def expand_symmetry_operations(
+    dataset: SpglibDataset,
+) -> tuple[NDArray[np.intc], NDArray[np.double]]:
+    """Return symmetry operations of a factorized dataset in full.
+
+    The operations are ordered as those of :func:`get_symmetry_dataset`.
+    For a dataset that is not factorized, its operations are returned.
+
+    Parameters
+    ----------
+    dataset : :class:`SpglibDataset`
+        Dataset given by :func:`get_factorized_symmetry_dataset`.
+
+    Returns
+    -------
+    rotations: ndarray[int], shape=(n_operations, 3, 3)
+    translations: ndarray[float], shape=(n_operations, 3)
+
+    Notes
+    -----
+    .. versionadded:: 2.6.0
+
+    """
+    if dataset.pure_translations is None:
+        return dataset.rotations, dataset.translations
+
+    pure_translations = dataset.pure_translations[:, None, :]
+    rotations = np.tile(dataset.rotations, (len(pure_translations), 1, 1))
+    translations = dataset.translations + pure_translations
+    reduced = translations - np.rint(translations)
+    reduced[reduced < -1e-10] += 1
+    # Zero components, e.g., along the aperiodic axis, are not reduced.
+    translations = np.where(pure_translations == 0, translations, reduced)
+    return (
+        np.array(rotations, dtype="intc", order="C"),
+        np.array(translations.reshape(-1, 3), dtype="double", order="C"),
+    )
+
+
 def get_symmetry_layerdataset(
     cell: Cell, aperiodic_dir=2, symprec=1e-5
 ) -> SpglibDataset | None:
@@ -2059,6 +2349,32 @@ def get_error_message():
     return spglib_error.message
 
 
+def set_work_budget(max_seconds=0.0, max_overlap_checks=0):
+    """Bound the work of the subsequent symmetry searches.
+
+    A search giving up on the budget returns ``None`` as other failed
+    searches, and :func:`get_error_message` returns "work budget exceeded".
+    The budget is set per thread and applies to each call separately, e.g.,
+    to each cell of :func:`get_symmetry_datasets`.
+
+    Parameters
+    ----------
+    max_seconds : float
+        Wall-clock time allowed for each call in seconds.
+    max_overlap_checks : int
+        Number of symmetry operations that each call may check against the
+        atoms.
+
+    Zero or a negative value means unlimited, which is the default.
+
+    Notes
+    -----
+    .. versionadded:: 2.6.0
+
+    """
+    _spglib.work_budget(float(max_seconds), int(max_overlap_checks))
+
+
 def _expand_cell(
     cell: Cell,
 ) -> tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray | None]:
@@ -0,0 +1,265 @@
+/* Copyright (C) 2008 Atsushi Togo */
+/* All rights reserved. */
+
+/* This file is part of spglib. */
+
+/* Redistribution and use in source and binary forms, with or without */
+/* modification, are permitted provided that the following conditions */
+/* are met: */
+
+/* * Redistributions of source code must retain the above copyright */
+/*   notice, this list of conditions and the following disclaimer. */
+
+/* * Redistributions in binary form must reproduce the above copyright */
+/*   notice, this list of conditions and the following disclaimer in */
+/*   the documentation and/or other materials provided with the */
+/*   distribution. */
+
+/* * Neither the name of the spglib project nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission. */
+
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE */
+/* COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, */
+/* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, */
+/* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; */
+/* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER */
+/* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT */
+/* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN */
+/* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
+/* POSSIBILITY OF SUCH DAMAGE. */
+
+#include "arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_BLOCK_SIZE 131072
+#define ARENA_MAX_REQUEST 16384
+
+/* Every allocation is preceded by this header, so that arn_free and */
+/* arn_realloc can tell the memory in the arena from that in the heap. */
+typedef union {
+    struct {
+        size_t size;
+        int is_in_arena;
+    } info;
+    double align[2];
+} ArenaHeader;
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;
+    size_t used;
+} ArenaBlock;
+
+/* Blocks are taken from spare before new ones are allocated. The blocks */
+/* are returned to workspace at the end of the outermost scope if given. */
+typedef struct {
+    ArenaBlock *blocks;
+    ArenaBlock *spare;
+    SpglibWorkspace *workspace;
+    int depth;
+} Arena;
+
+struct SpglibWorkspace {
+    ArenaBlock *blocks;
+};
+
+static thread_local Arena arena = {NULL, NULL, NULL, 0};
+
+static size_t round_up(size_t const size);
+static ArenaHeader *alloc_in_arena(size_t const size);
+static ArenaHeader *alloc_in_heap(size_t const size);
+static ArenaHeader *get_header(void *ptr);
+static void free_blocks(ArenaBlock *blocks);
+
+void arn_begin(void) { arn_begin_with_workspace(NULL); }
+
+/* The workspace is used only by the outermost scope. */
+void arn_begin_with_workspace(SpglibWorkspace *workspace) {
+    if (arena.depth == 0 && workspace != NULL) {
+        arena.spare = workspace->blocks;
+        arena.workspace = workspace;
+        workspace->blocks = NULL;
+    }
+    arena.depth++;
+}
+
+void arn_end(void) {
+    ArenaBlock *block, *next;
+
+    if (arena.depth == 0) {
+        return;
+    }
+    arena.depth--;
+    if (arena.depth > 0) {
+        return;
+    }
+
+    if (arena.workspace == NULL) {
+        free_blocks(arena.blocks);
+    } else {
+        for (block = arena.blocks; block != NULL; block = next) {
+            next = block->next;
+            block->next = arena.spare;
+            arena.spare = block;
+        }
+        arena.workspace->blocks = arena.spare;
+    }
+    arena.blocks = NULL;
+    arena.spare = NULL;
+    arena.workspace = NULL;
+}
+
+/* Return NULL if failed */
+SpglibWorkspace *arn_alloc_workspace(void) {
+    SpglibWorkspace *workspace;
+
+    if ((workspace = (SpglibWorkspace *)malloc(sizeof(SpglibWorkspace))) ==
+        NULL) {
+        return NULL;
+    }
+    workspace->blocks = NULL;
+    return workspace;
+}
+
+void arn_free_workspace(SpglibWorkspace *workspace) {
+    if (workspace == NULL) {
+        return;
+    }
+    free_blocks(workspace->blocks);
+    free(workspace);
+}
+
+/* Return NULL if failed */
+void *arn_malloc(size_t const size) {
+    ArenaHeader *header;
+
+    if (arena.depth > 0 && size <= ARENA_MAX_REQUEST) {
+        header = alloc_in_arena(size);
+    } else {
+        header = alloc_in_heap(size);
+    }
+
+    if (header == NULL) {
+        return NULL;
+    }
+    return header + 1;
+}
+
+/* Return NULL if failed */
+void *arn_calloc(size_t const num, size_t const size) {
+    void *ptr;
+
+    if (size > 0 && num > ((size_t)-1 - sizeof(ArenaHeader)) / size) {
+        return NULL;
+    }
+    if ((ptr = arn_malloc(num * size)) == NULL) {
+        return NULL;
+    }
+    memset(ptr, 0, num * size);
+    return ptr;
+}
+
+/* Return NULL if failed. The original memory is kept in that case. */
+void *arn_realloc(void *ptr, size_t const size) {
+    ArenaHeader *header;
+    void *new_ptr;
+
+    if (ptr == NULL) {
+        return arn_malloc(size);
+    }
+
+    header = get_header(ptr);
+    if (!header->info.is_in_arena) {
+        if ((header = realloc(header, sizeof(ArenaHeader) + size)) == NULL) {
+            return NULL;
+        }
+        header->info.size = size;
+        return header + 1;
+    }
+
+    if (size <= header->info.size) {
+        return ptr;
+    }
+    if ((new_ptr = arn_malloc(size)) == NULL) {
+        return NULL;
+    }
+    memcpy(new_ptr, ptr, header->info.size);
+    return new_ptr;
+}
+
+void arn_free(void *ptr) {
+    ArenaHeader *header;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    header = get_header(ptr);
+    if (!header->info.is_in_arena) {
+        free(header);
+    }
+}
+
+static size_t round_up(size_t const size) {
+    return (size + sizeof(ArenaHeader) - 1) / sizeof(ArenaHeader) *
+           sizeof(ArenaHeader);
+}
+
+/* Return NULL if failed */
+static ArenaHeader *alloc_in_arena(size_t const size) {
+    size_t required;
+    ArenaBlock *block;
+    ArenaHeader *header;
+
+    required = sizeof(ArenaHeader) + round_up(size);
+    block = arena.blocks;
+    if (block == NULL || block->size - block->used < required) {
+        if (arena.spare != NULL) {
+            block = arena.spare;
+            arena.spare = block->next;
+        } else if ((block = malloc(round_up(sizeof(ArenaBlock)) +
+                                   ARENA_BLOCK_SIZE)) == NULL) {
+            return NULL;
+        }
+        block->next = arena.blocks;
+        block->size = ARENA_BLOCK_SIZE;
+        block->used = 0;
+        arena.blocks = block;
+    }
+
+    header = (ArenaHeader *)((char *)block + round_up(sizeof(ArenaBlock)) +
+                             block->used);
+    block->used += required;
+    header->info.size = size;
+    header->info.is_in_arena = 1;
+    return header;
+}
+
+/* Return NULL if failed */
+static ArenaHeader *alloc_in_heap(size_t const size) {
+    ArenaHeader *header;
+
+    if ((header = malloc(sizeof(ArenaHeader) + size)) == NULL) {
+        return NULL;
+    }
+    header->info.size = size;
+    header->info.is_in_arena = 0;
+    return header;
+}
+
+static ArenaHeader *get_header(void *ptr) { return (ArenaHeader *)ptr - 1; }
+
+static void free_blocks(ArenaBlock *blocks) {
+    ArenaBlock *block, *next;
+
+    for (block = blocks; block != NULL; block = next) {
+        next = block->next;
+        free(block);
+    }
+}
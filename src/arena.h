@@ -0,0 +1,61 @@
+/* Copyright (C) 2008 Atsushi Togo */
+/* All rights reserved. */
+
+/* This file is part of spglib. */
+
+/* Redistribution and use in source and binary forms, with or without */
+/* modification, are permitted provided that the following conditions */
+/* are met: */
+
+/* * Redistributions of source code must retain the above copyright */
+/*   notice, this list of conditions and the following disclaimer. */
+
+/* * Redistributions in binary form must reproduce the above copyright */
+/*   notice, this list of conditions and the following disclaimer in */
+/*   the documentation and/or other materials provided with the */
+/*   distribution. */
+
+/* * Neither the name of the spglib project nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission. */
+
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE */
+/* COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, */
+/* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, */
+/* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; */
+/* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER */
+/* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT */
+/* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN */
+/* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
+/* POSSIBILITY OF SUCH DAMAGE. */
+
+#ifndef __arena_H__
+#define __arena_H__
+
+#include <stddef.h>
+
+#include "base.h"
+
+/* Temporary memory of the symmetry search is taken from a per-thread */
+/* arena between arn_begin and arn_end, and is released at once by */
+/* arn_end of the outermost scope. Outside of the scopes, the memory is */
+/* taken from the heap. Memory obtained by arn_malloc, arn_calloc and */
+/* arn_realloc has to be released by arn_free, which does nothing for */
+/* the memory in the arena. */
+/* The blocks of the arena are kept in a workspace given to the outermost */
+/* scope for the next computations instead of being freed. A workspace */
+/* must not be used by more than one thread at the same time. */
+SPG_API_TEST void arn_begin(void);
+SPG_API_TEST void arn_begin_with_workspace(SpglibWorkspace *workspace);
+SPG_API_TEST void arn_end(void);
+SPG_API_TEST void *arn_malloc(size_t const size);
+SPG_API_TEST void *arn_calloc(size_t const num, size_t const size);
+SPG_API_TEST void *arn_realloc(void *ptr, size_t const size);
+SPG_API_TEST void arn_free(void *ptr);
+SPG_API_TEST SpglibWorkspace *arn_alloc_workspace(void);
+SPG_API_TEST void arn_free_workspace(SpglibWorkspace *workspace);
+
+#endif
@@ -0,0 +1,764 @@
+/* Copyright (C) 2008 Atsushi Togo */
+/* All rights reserved. */
+
+/* This file is part of spglib. */
+
+/* Redistribution and use in source and binary forms, with or without */
+/* modification, are permitted provided that the following conditions */
+/* are met: */
+
+/* * Redistributions of source code must retain the above copyright */
+/*   notice, this list of conditions and the following disclaimer. */
+
+/* * Redistributions in binary form must reproduce the above copyright */
+/*   notice, this list of conditions and the following disclaimer in */
+/*   the documentation and/or other materials provided with the */
+/*   distribution. */
+
+/* * Neither the name of the spglib project nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission. */
+
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE */
+/* COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, */
+/* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, */
+/* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; */
+/* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER */
+/* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT */
+/* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN */
+/* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
+/* POSSIBILITY OF SUCH DAMAGE. */
+
+/* Generated by database/make_axes_db.py */
+
+#include "axes_database.h"
+
+static int const relative_axes[][3] = {
+    {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {-1, 0, 0}, {0, -1, 0},
+    {0, 0, -1}, {0, 1, 1}, {1, 0, 1}, {1, 1, 0}, {0, -1, -1},
+    {-1, 0, -1}, {-1, -1, 0}, {0, 1, -1}, {-1, 0, 1}, {1, -1, 0},
+    {0, -1, 1}, {1, 0, -1}, {-1, 1, 0}, {1, 1, 1}, {-1, -1, -1},
+    {-1, 1, 1}, {1, -1, 1}, {1, 1, -1}, {1, -1, -1}, {-1, 1, -1},
+    {-1, -1, 1},
+};
+
+/* Unimodular matrices whose columns are taken from relative_axes. */
+static int const unimodular_axes[] = {
+    28,    31,    32,    33,    35,    36,    38,    39,    41,    42,
+    44,    45,    46,    47,    48,    49,    50,    51,    53,    56,
+    58,    60,    61,    63,    64,    66,    67,    69,    70,    71,
+    72,    73,    74,    75,    76,    77,    106,   109,   110,   111,
+    113,   114,   116,   117,   119,   120,   122,   123,   124,   125,
+    126,   127,   128,   129,   131,   134,   136,   138,   139,   141,
+    142,   144,   145,   147,   148,   149,   150,   151,   152,   153,
+    154,   155,   157,   158,   160,   161,   163,   164,   166,   167,
+    169,   170,   172,   173,   183,   186,   188,   190,   191,   193,
+    194,   196,   197,   199,   200,   201,   202,   203,   204,   205,
+    206,   207,   210,   213,   214,   215,   217,   218,   220,   221,
+    223,   224,   226,   227,   228,   229,   230,   231,   232,   233,
+    235,   236,   238,   239,   241,   242,   244,   245,   247,   248,
+    250,   251,   261,   264,   266,   268,   269,   271,   272,   274,
+    275,   277,   278,   279,   280,   281,   282,   283,   284,   285,
+    288,   291,   292,   293,   295,   296,   298,   299,   301,   302,
+    304,   305,   306,   307,   308,   309,   310,   311,   313,   314,
+    316,   317,   319,   320,   322,   323,   325,   326,   328,   329,
+    339,   342,   344,   346,   347,   349,   350,   352,   353,   355,
+    356,   357,   358,   359,   360,   361,   362,   363,   366,   369,
+    370,   371,   373,   374,   376,   377,   379,   380,   382,   383,
+    384,   385,   386,   387,   388,   389,   391,   392,   394,   395,
+    397,   398,   400,   401,   403,   404,   406,   407,   417,   420,
+    422,   424,   425,   427,   428,   430,   431,   433,   434,   435,
+    436,   437,   438,   439,   440,   441,   444,   447,   448,   449,
+    451,   452,   454,   455,   457,   458,   460,   461,   462,   463,
+    464,   465,   466,   467,   469,   470,   472,   473,   475,   476,
+    478,   479,   481,   482,   484,   485,   495,   496,   498,   499,
+    501,   502,   504,   505,   507,   508,   510,   511,   521,   522,
+    524,   525,   527,   528,   530,   531,   533,   534,   536,   537,
+    547,   548,   550,   551,   553,   554,   556,   557,   559,   560,
+    562,   563,   573,   574,   576,   577,   579,   580,   582,   583,
+    585,   586,   588,   589,   599,   600,   602,   603,   605,   606,
+    608,   609,   611,   612,   614,   615,   625,   626,   628,   629,
+    631,   632,   634,   635,   637,   638,   640,   641,   651,   652,
+    654,   655,   657,   658,   660,   661,   663,   664,   666,   667,
+    678,   681,   682,   683,   685,   686,   688,   689,   691,   692,
+    694,   695,   696,   697,   698,   699,   700,   701,   728,   731,
+    735,   736,   738,   739,   741,   742,   744,   745,   746,   747,
+    748,   749,   750,   751,   752,   753,   756,   759,   760,   761,
+    763,   764,   766,   767,   769,   770,   772,   773,   774,   775,
+    776,   777,   778,   779,   806,   809,   813,   814,   816,   817,
+    819,   820,   822,   823,   824,   825,   826,   827,   828,   829,
+    830,   831,   832,   835,   839,   840,   842,   843,   845,   846,
+    848,   849,   850,   851,   852,   853,   854,   855,   856,   857,
+    858,   860,   861,   863,   864,   866,   867,   869,   870,   872,
+    873,   875,   886,   889,   890,   891,   893,   894,   896,   897,
+    899,   900,   902,   903,   904,   905,   906,   907,   908,   909,
+    910,   913,   917,   918,   920,   921,   923,   924,   926,   927,
+    928,   929,   930,   931,   932,   933,   934,   935,   936,   938,
+    939,   941,   942,   944,   945,   947,   948,   950,   951,   953,
+    964,   967,   968,   969,   971,   972,   974,   975,   977,   978,
+    980,   981,   982,   983,   984,   985,   986,   987,   988,   991,
+    995,   996,   998,   999,   1001,  1002,  1004,  1005,  1006,  1007,
+    1008,  1009,  1010,  1011,  1012,  1013,  1014,  1016,  1017,  1019,
+    1020,  1022,  1023,  1025,  1026,  1028,  1029,  1031,  1042,  1045,
+    1046,  1047,  1049,  1050,  1052,  1053,  1055,  1056,  1058,  1059,
+    1060,  1061,  1062,  1063,  1064,  1065,  1066,  1069,  1073,  1074,
+    1076,  1077,  1079,  1080,  1082,  1083,  1084,  1085,  1086,  1087,
+    1088,  1089,  1090,  1091,  1092,  1094,  1095,  1097,  1098,  1100,
+    1101,  1103,  1104,  1106,  1107,  1109,  1120,  1123,  1124,  1125,
+    1127,  1128,  1130,  1131,  1133,  1134,  1136,  1137,  1138,  1139,
+    1140,  1141,  1142,  1143,  1144,  1146,  1147,  1149,  1150,  1152,
+    1153,  1155,  1156,  1158,  1159,  1161,  1170,  1172,  1173,  1175,
+    1176,  1178,  1179,  1181,  1182,  1184,  1185,  1187,  1196,  1198,
+    1199,  1201,  1202,  1204,  1205,  1207,  1208,  1210,  1211,  1213,
+    1222,  1224,  1225,  1227,  1228,  1230,  1231,  1233,  1234,  1236,
+    1237,  1239,  1248,  1250,  1251,  1253,  1254,  1256,  1257,  1259,
+    1260,  1262,  1263,  1265,  1274,  1276,  1277,  1279,  1280,  1282,
+    1283,  1285,  1286,  1288,  1289,  1291,  1300,  1302,  1303,  1305,
+    1306,  1308,  1309,  1311,  1312,  1314,  1315,  1317,  1326,  1328,
+    1329,  1331,  1332,  1334,  1335,  1337,  1338,  1340,  1341,  1343,
+    1353,  1356,  1358,  1360,  1361,  1363,  1364,  1366,  1367,  1369,
+    1370,  1371,  1372,  1373,  1374,  1375,  1376,  1377,  1378,  1381,
+    1385,  1386,  1388,  1389,  1391,  1392,  1394,  1395,  1396,  1397,
+    1398,  1399,  1400,  1401,  1402,  1403,  1431,  1434,  1436,  1438,
+    1439,  1441,  1442,  1444,  1445,  1447,  1448,  1449,  1450,  1451,
+    1452,  1453,  1454,  1455,  1456,  1459,  1463,  1464,  1466,  1467,
+    1469,  1470,  1472,  1473,  1474,  1475,  1476,  1477,  1478,  1479,
+    1480,  1481,  1508,  1511,  1515,  1516,  1518,  1519,  1521,  1522,
+    1524,  1525,  1526,  1527,  1528,  1529,  1530,  1531,  1532,  1533,
+    1535,  1538,  1540,  1542,  1543,  1545,  1546,  1548,  1549,  1551,
+    1552,  1553,  1554,  1555,  1556,  1557,  1558,  1559,  1560,  1561,
+    1563,  1564,  1566,  1567,  1569,  1570,  1572,  1573,  1575,  1576,
+    1586,  1589,  1593,  1594,  1596,  1597,  1599,  1600,  1602,  1603,
+    1604,  1605,  1606,  1607,  1608,  1609,  1610,  1611,  1613,  1616,
+    1618,  1620,  1621,  1623,  1624,  1626,  1627,  1629,  1630,  1631,
+    1632,  1633,  1634,  1635,  1636,  1637,  1638,  1639,  1641,  1642,
+    1644,  1645,  1647,  1648,  1650,  1651,  1653,  1654,  1664,  1667,
+    1671,  1672,  1674,  1675,  1677,  1678,  1680,  1681,  1682,  1683,
+    1684,  1685,  1686,  1687,  1688,  1689,  1691,  1694,  1696,  1698,
+    1699,  1701,  1702,  1704,  1705,  1707,  1708,  1709,  1710,  1711,
+    1712,  1713,  1714,  1715,  1716,  1717,  1719,  1720,  1722,  1723,
+    1725,  1726,  1728,  1729,  1731,  1732,  1742,  1745,  1749,  1750,
+    1752,  1753,  1755,  1756,  1758,  1759,  1760,  1761,  1762,  1763,
+    1764,  1765,  1766,  1767,  1769,  1772,  1774,  1776,  1777,  1779,
+    1780,  1782,  1783,  1785,  1786,  1787,  1788,  1789,  1790,  1791,
+    1792,  1793,  1794,  1795,  1797,  1798,  1800,  1801,  1803,  1804,
+    1806,  1807,  1809,  1810,  1820,  1821,  1823,  1824,  1826,  1827,
+    1829,  1830,  1832,  1833,  1835,  1836,  1846,  1847,  1849,  1850,
+    1852,  1853,  1855,  1856,  1858,  1859,  1861,  1862,  1872,  1873,
+    1875,  1876,  1878,  1879,  1881,  1882,  1884,  1885,  1887,  1888,
+    1898,  1899,  1901,  1902,  1904,  1905,  1907,  1908,  1910,  1911,
+    1913,  1914,  1924,  1925,  1927,  1928,  1930,  1931,  1933,  1934,
+    1936,  1937,  1939,  1940,  1950,  1951,  1953,  1954,  1956,  1957,
+    1959,  1960,  1962,  1963,  1965,  1966,  1976,  1977,  1979,  1980,
+    1982,  1983,  1985,  1986,  1988,  1989,  1991,  1992,  2002,  2003,
+    2005,  2006,  2008,  2009,  2011,  2012,  2014,  2015,  2017,  2018,
+    2056,  2059,  2060,  2061,  2063,  2064,  2066,  2067,  2069,  2070,
+    2072,  2073,  2074,  2075,  2076,  2077,  2078,  2079,  2081,  2084,
+    2086,  2088,  2089,  2091,  2092,  2094,  2095,  2097,  2098,  2099,
+    2100,  2101,  2102,  2103,  2104,  2105,  2134,  2137,  2138,  2139,
+    2141,  2142,  2144,  2145,  2147,  2148,  2150,  2151,  2152,  2153,
+    2154,  2155,  2156,  2157,  2159,  2162,  2164,  2166,  2167,  2169,
+    2170,  2172,  2173,  2175,  2176,  2177,  2178,  2179,  2180,  2181,
+    2182,  2183,  2185,  2186,  2188,  2189,  2191,  2192,  2194,  2195,
+    2197,  2198,  2200,  2201,  2211,  2214,  2216,  2218,  2219,  2221,
+    2222,  2224,  2225,  2227,  2228,  2229,  2230,  2231,  2232,  2233,
+    2234,  2235,  2238,  2241,  2242,  2243,  2245,  2246,  2248,  2249,
+    2251,  2252,  2254,  2255,  2256,  2257,  2258,  2259,  2260,  2261,
+    2263,  2264,  2266,  2267,  2269,  2270,  2272,  2273,  2275,  2276,
+    2278,  2279,  2289,  2292,  2294,  2296,  2297,  2299,  2300,  2302,
+    2303,  2305,  2306,  2307,  2308,  2309,  2310,  2311,  2312,  2313,
+    2316,  2319,  2320,  2321,  2323,  2324,  2326,  2327,  2329,  2330,
+    2332,  2333,  2334,  2335,  2336,  2337,  2338,  2339,  2341,  2342,
+    2344,  2345,  2347,  2348,  2350,  2351,  2353,  2354,  2356,  2357,
+    2367,  2370,  2372,  2374,  2375,  2377,  2378,  2380,  2381,  2383,
+    2384,  2385,  2386,  2387,  2388,  2389,  2390,  2391,  2394,  2397,
+    2398,  2399,  2401,  2402,  2404,  2405,  2407,  2408,  2410,  2411,
+    2412,  2413,  2414,  2415,  2416,  2417,  2419,  2420,  2422,  2423,
+    2425,  2426,  2428,  2429,  2431,  2432,  2434,  2435,  2445,  2448,
+    2450,  2452,  2453,  2455,  2456,  2458,  2459,  2461,  2462,  2463,
+    2464,  2465,  2466,  2467,  2468,  2469,  2472,  2475,  2476,  2477,
+    2479,  2480,  2482,  2483,  2485,  2486,  2488,  2489,  2490,  2491,
+    2492,  2493,  2494,  2495,  2497,  2498,  2500,  2501,  2503,  2504,
+    2506,  2507,  2509,  2510,  2512,  2513,  2523,  2524,  2526,  2527,
+    2529,  2530,  2532,  2533,  2535,  2536,  2538,  2539,  2549,  2550,
+    2552,  2553,  2555,  2556,  2558,  2559,  2561,  2562,  2564,  2565,
+    2575,  2576,  2578,  2579,  2581,  2582,  2584,  2585,  2587,  2588,
+    2590,  2591,  2601,  2602,  2604,  2605,  2607,  2608,  2610,  2611,
+    2613,  2614,  2616,  2617,  2627,  2628,  2630,  2631,  2633,  2634,
+    2636,  2637,  2639,  2640,  2642,  2643,  2653,  2654,  2656,  2657,
+    2659,  2660,  2662,  2663,  2665,  2666,  2668,  2669,  2679,  2680,
+    2682,  2683,  2685,  2686,  2688,  2689,  2691,  2692,  2694,  2695,
+    2706,  2709,  2710,  2711,  2713,  2714,  2716,  2717,  2719,  2720,
+    2722,  2723,  2724,  2725,  2726,  2727,  2728,  2729,  2756,  2759,
+    2763,  2764,  2766,  2767,  2769,  2770,  2772,  2773,  2774,  2775,
+    2776,  2777,  2778,  2779,  2780,  2781,  2784,  2787,  2788,  2789,
+    2791,  2792,  2794,  2795,  2797,  2798,  2800,  2801,  2802,  2803,
+    2804,  2805,  2806,  2807,  2834,  2837,  2841,  2842,  2844,  2845,
+    2847,  2848,  2850,  2851,  2852,  2853,  2854,  2855,  2856,  2857,
+    2858,  2859,  2860,  2863,  2867,  2868,  2870,  2871,  2873,  2874,
+    2876,  2877,  2878,  2879,  2880,  2881,  2882,  2883,  2884,  2885,
+    2886,  2888,  2889,  2891,  2892,  2894,  2895,  2897,  2898,  2900,
+    2901,  2903,  2914,  2917,  2918,  2919,  2921,  2922,  2924,  2925,
+    2927,  2928,  2930,  2931,  2932,  2933,  2934,  2935,  2936,  2937,
+    2938,  2941,  2945,  2946,  2948,  2949,  2951,  2952,  2954,  2955,
+    2956,  2957,  2958,  2959,  2960,  2961,  2962,  2963,  2964,  2966,
+    2967,  2969,  2970,  2972,  2973,  2975,  2976,  2978,  2979,  2981,
+    2992,  2995,  2996,  2997,  2999,  3000,  3002,  3003,  3005,  3006,
+    3008,  3009,  3010,  3011,  3012,  3013,  3014,  3015,  3016,  3019,
+    3023,  3024,  3026,  3027,  3029,  3030,  3032,  3033,  3034,  3035,
+    3036,  3037,  3038,  3039,  3040,  3041,  3042,  3044,  3045,  3047,
+    3048,  3050,  3051,  3053,  3054,  3056,  3057,  3059,  3070,  3073,
+    3074,  3075,  3077,  3078,  3080,  3081,  3083,  3084,  3086,  3087,
+    3088,  3089,  3090,  3091,  3092,  3093,  3094,  3097,  3101,  3102,
+    3104,  3105,  3107,  3108,  3110,  3111,  3112,  3113,  3114,  3115,
+    3116,  3117,  3118,  3119,  3120,  3122,  3123,  3125,  3126,  3128,
+    3129,  3131,  3132,  3134,  3135,  3137,  3148,  3151,  3152,  3153,
+    3155,  3156,  3158,  3159,  3161,  3162,  3164,  3165,  3166,  3167,
+    3168,  3169,  3170,  3171,  3172,  3174,  3175,  3177,  3178,  3180,
+    3181,  3183,  3184,  3186,  3187,  3189,  3198,  3200,  3201,  3203,
+    3204,  3206,  3207,  3209,  3210,  3212,  3213,  3215,  3224,  3226,
+    3227,  3229,  3230,  3232,  3233,  3235,  3236,  3238,  3239,  3241,
+    3250,  3252,  3253,  3255,  3256,  3258,  3259,  3261,  3262,  3264,
+    3265,  3267,  3276,  3278,  3279,  3281,  3282,  3284,  3285,  3287,
+    3288,  3290,  3291,  3293,  3302,  3304,  3305,  3307,  3308,  3310,
+    3311,  3313,  3314,  3316,  3317,  3319,  3328,  3330,  3331,  3333,
+    3334,  3336,  3337,  3339,  3340,  3342,  3343,  3345,  3354,  3356,
+    3357,  3359,  3360,  3362,  3363,  3365,  3366,  3368,  3369,  3371,
+    3381,  3384,  3386,  3388,  3389,  3391,  3392,  3394,  3395,  3397,
+    3398,  3399,  3400,  3401,  3402,  3403,  3404,  3405,  3406,  3409,
+    3413,  3414,  3416,  3417,  3419,  3420,  3422,  3423,  3424,  3425,
+    3426,  3427,  3428,  3429,  3430,  3431,  3459,  3462,  3464,  3466,
+    3467,  3469,  3470,  3472,  3473,  3475,  3476,  3477,  3478,  3479,
+    3480,  3481,  3482,  3483,  3484,  3487,  3491,  3492,  3494,  3495,
+    3497,  3498,  3500,  3501,  3502,  3503,  3504,  3505,  3506,  3507,
+    3508,  3509,  3536,  3539,  3543,  3544,  3546,  3547,  3549,  3550,
+    3552,  3553,  3554,  3555,  3556,  3557,  3558,  3559,  3560,  3561,
+    3563,  3566,  3568,  3570,  3571,  3573,  3574,  3576,  3577,  3579,
+    3580,  3581,  3582,  3583,  3584,  3585,  3586,  3587,  3588,  3589,
+    3591,  3592,  3594,  3595,  3597,  3598,  3600,  3601,  3603,  3604,
+    3614,  3617,  3621,  3622,  3624,  3625,  3627,  3628,  3630,  3631,
+    3632,  3633,  3634,  3635,  3636,  3637,  3638,  3639,  3641,  3644,
+    3646,  3648,  3649,  3651,  3652,  3654,  3655,  3657,  3658,  3659,
+    3660,  3661,  3662,  3663,  3664,  3665,  3666,  3667,  3669,  3670,
+    3672,  3673,  3675,  3676,  3678,  3679,  3681,  3682,  3692,  3695,
+    3699,  3700,  3702,  3703,  3705,  3706,  3708,  3709,  3710,  3711,
+    3712,  3713,  3714,  3715,  3716,  3717,  3719,  3722,  3724,  3726,
+    3727,  3729,  3730,  3732,  3733,  3735,  3736,  3737,  3738,  3739,
+    3740,  3741,  3742,  3743,  3744,  3745,  3747,  3748,  3750,  3751,
+    3753,  3754,  3756,  3757,  3759,  3760,  3770,  3773,  3777,  3778,
+    3780,  3781,  3783,  3784,  3786,  3787,  3788,  3789,  3790,  3791,
+    3792,  3793,  3794,  3795,  3797,  3800,  3802,  3804,  3805,  3807,
+    3808,  3810,  3811,  3813,  3814,  3815,  3816,  3817,  3818,  3819,
+    3820,  3821,  3822,  3823,  3825,  3826,  3828,  3829,  3831,  3832,
+    3834,  3835,  3837,  3838,  3848,  3849,  3851,  3852,  3854,  3855,
+    3857,  3858,  3860,  3861,  3863,  3864,  3874,  3875,  3877,  3878,
+    3880,  3881,  3883,  3884,  3886,  3887,  3889,  3890,  3900,  3901,
+    3903,  3904,  3906,  3907,  3909,  3910,  3912,  3913,  3915,  3916,
+    3926,  3927,  3929,  3930,  3932,  3933,  3935,  3936,  3938,  3939,
+    3941,  3942,  3952,  3953,  3955,  3956,  3958,  3959,  3961,  3962,
+    3964,  3965,  3967,  3968,  3978,  3979,  3981,  3982,  3984,  3985,
+    3987,  3988,  3990,  3991,  3993,  3994,  4004,  4005,  4007,  4008,
+    4010,  4011,  4013,  4014,  4016,  4017,  4019,  4020,  4030,  4031,
+    4033,  4034,  4036,  4037,  4039,  4040,  4042,  4043,  4045,  4046,
+    4057,  4058,  4060,  4061,  4063,  4064,  4066,  4067,  4069,  4070,
+    4072,  4073,  4082,  4085,  4089,  4090,  4092,  4093,  4095,  4096,
+    4098,  4099,  4100,  4101,  4102,  4103,  4104,  4105,  4106,  4107,
+    4108,  4111,  4115,  4116,  4118,  4119,  4121,  4122,  4124,  4125,
+    4126,  4127,  4128,  4129,  4130,  4131,  4132,  4133,  4135,  4136,
+    4138,  4139,  4141,  4142,  4144,  4145,  4147,  4148,  4150,  4151,
+    4160,  4163,  4167,  4168,  4170,  4171,  4173,  4174,  4176,  4177,
+    4178,  4179,  4180,  4181,  4182,  4183,  4184,  4185,  4186,  4189,
+    4193,  4194,  4196,  4197,  4199,  4200,  4202,  4203,  4204,  4205,
+    4206,  4207,  4208,  4209,  4210,  4211,  4238,  4239,  4240,  4241,
+    4242,  4243,  4256,  4257,  4258,  4259,  4261,  4262,  4264,  4265,
+    4266,  4267,  4268,  4269,  4282,  4283,  4284,  4286,  4287,  4289,
+    4316,  4317,  4318,  4319,  4320,  4321,  4334,  4335,  4336,  4337,
+    4339,  4340,  4342,  4343,  4344,  4345,  4346,  4347,  4360,  4361,
+    4362,  4364,  4365,  4367,  4394,  4395,  4396,  4397,  4398,  4399,
+    4412,  4413,  4414,  4416,  4417,  4419,  4420,  4421,  4422,  4423,
+    4424,  4425,  4438,  4439,  4440,  4441,  4443,  4444,  4472,  4473,
+    4474,  4475,  4476,  4477,  4490,  4491,  4492,  4494,  4495,  4497,
+    4498,  4499,  4500,  4501,  4502,  4503,  4516,  4517,  4518,  4519,
+    4521,  4522,  4525,  4526,  4528,  4529,  4531,  4532,  4534,  4535,
+    4537,  4538,  4540,  4541,  4551,  4552,  4554,  4555,  4557,  4558,
+    4560,  4561,  4563,  4564,  4566,  4567,  4577,  4578,  4580,  4581,
+    4583,  4584,  4586,  4587,  4589,  4590,  4592,  4593,  4603,  4604,
+    4606,  4607,  4609,  4612,  4616,  4619,  4629,  4630,  4632,  4633,
+    4636,  4639,  4641,  4644,  4655,  4656,  4658,  4659,  4661,  4662,
+    4664,  4665,  4667,  4668,  4670,  4671,  4681,  4682,  4684,  4685,
+    4687,  4690,  4694,  4697,  4707,  4708,  4710,  4711,  4714,  4717,
+    4719,  4722,  4733,  4736,  4738,  4740,  4741,  4743,  4744,  4746,
+    4747,  4749,  4750,  4751,  4752,  4753,  4754,  4755,  4756,  4757,
+    4758,  4760,  4761,  4763,  4764,  4766,  4767,  4769,  4770,  4772,
+    4773,  4775,  4785,  4788,  4790,  4792,  4793,  4795,  4796,  4798,
+    4799,  4801,  4802,  4803,  4804,  4805,  4806,  4807,  4808,  4809,
+    4811,  4814,  4816,  4818,  4819,  4821,  4822,  4824,  4825,  4827,
+    4828,  4829,  4830,  4831,  4832,  4833,  4834,  4835,  4836,  4838,
+    4839,  4841,  4842,  4844,  4845,  4847,  4848,  4850,  4851,  4853,
+    4863,  4866,  4868,  4870,  4871,  4873,  4874,  4876,  4877,  4879,
+    4880,  4881,  4882,  4883,  4884,  4885,  4886,  4887,  4888,  4889,
+    4890,  4891,  4892,  4893,  4906,  4907,  4908,  4909,  4911,  4912,
+    4940,  4941,  4942,  4943,  4944,  4945,  4958,  4959,  4961,  4962,
+    4964,  4965,  4966,  4967,  4968,  4969,  4970,  4971,  4984,  4985,
+    4986,  4987,  4989,  4990,  5018,  5019,  5020,  5021,  5022,  5023,
+    5036,  5037,  5039,  5040,  5042,  5043,  5044,  5045,  5046,  5047,
+    5048,  5049,  5062,  5063,  5065,  5066,  5068,  5069,  5096,  5097,
+    5098,  5099,  5100,  5101,  5114,  5115,  5116,  5117,  5119,  5120,
+    5122,  5123,  5124,  5125,  5126,  5127,  5140,  5141,  5143,  5144,
+    5146,  5147,  5174,  5175,  5176,  5177,  5178,  5179,  5192,  5193,
+    5194,  5195,  5197,  5198,  5200,  5202,  5203,  5205,  5206,  5208,
+    5209,  5211,  5212,  5214,  5215,  5217,  5226,  5228,  5229,  5231,
+    5232,  5234,  5235,  5237,  5238,  5240,  5241,  5243,  5252,  5254,
+    5255,  5257,  5258,  5261,  5266,  5269,  5278,  5280,  5281,  5283,
+    5284,  5286,  5287,  5289,  5290,  5292,  5293,  5295,  5304,  5306,
+    5307,  5309,  5312,  5315,  5316,  5319,  5330,  5332,  5333,  5335,
+    5336,  5339,  5344,  5347,  5356,  5358,  5359,  5361,  5362,  5364,
+    5365,  5367,  5368,  5370,  5371,  5373,  5382,  5384,  5385,  5387,
+    5390,  5393,  5394,  5397,  5410,  5413,  5414,  5415,  5417,  5418,
+    5420,  5421,  5423,  5424,  5426,  5427,  5428,  5429,  5430,  5431,
+    5432,  5433,  5436,  5439,  5440,  5441,  5443,  5444,  5446,  5447,
+    5449,  5450,  5452,  5453,  5454,  5455,  5456,  5457,  5458,  5459,
+    5460,  5461,  5463,  5464,  5466,  5467,  5469,  5470,  5472,  5473,
+    5475,  5476,  5488,  5491,  5492,  5493,  5495,  5496,  5498,  5499,
+    5501,  5502,  5504,  5505,  5506,  5507,  5508,  5509,  5510,  5511,
+    5514,  5517,  5518,  5519,  5521,  5522,  5524,  5525,  5527,  5528,
+    5530,  5531,  5532,  5533,  5534,  5535,  5536,  5537,  5538,  5539,
+    5541,  5542,  5544,  5545,  5547,  5548,  5550,  5551,  5553,  5554,
+    5564,  5565,  5566,  5567,  5568,  5569,  5582,  5583,  5584,  5586,
+    5587,  5589,  5590,  5591,  5592,  5593,  5594,  5595,  5608,  5609,
+    5611,  5612,  5614,  5615,  5642,  5643,  5644,  5645,  5646,  5647,
+    5660,  5661,  5662,  5664,  5665,  5667,  5668,  5669,  5670,  5671,
+    5672,  5673,  5686,  5687,  5689,  5690,  5692,  5693,  5720,  5721,
+    5722,  5723,  5724,  5725,  5738,  5739,  5741,  5742,  5744,  5745,
+    5746,  5747,  5748,  5749,  5750,  5751,  5764,  5765,  5766,  5768,
+    5769,  5771,  5798,  5799,  5800,  5801,  5802,  5803,  5816,  5817,
+    5819,  5820,  5822,  5823,  5824,  5825,  5826,  5827,  5828,  5829,
+    5842,  5843,  5844,  5846,  5847,  5849,  5876,  5877,  5879,  5880,
+    5882,  5883,  5885,  5886,  5888,  5889,  5891,  5892,  5902,  5903,
+    5905,  5906,  5908,  5909,  5911,  5912,  5914,  5915,  5917,  5918,
+    5928,  5929,  5931,  5932,  5934,  5937,  5941,  5944,  5954,  5955,
+    5957,  5958,  5961,  5964,  5966,  5969,  5980,  5981,  5983,  5984,
+    5986,  5987,  5989,  5990,  5992,  5993,  5995,  5996,  6006,  6007,
+    6009,  6010,  6012,  6015,  6019,  6022,  6032,  6033,  6035,  6036,
+    6039,  6042,  6044,  6047,  6058,  6059,  6061,  6062,  6064,  6065,
+    6067,  6068,  6070,  6071,  6073,  6074,  6085,  6086,  6088,  6089,
+    6091,  6092,  6094,  6095,  6097,  6098,  6100,  6101,  6110,  6113,
+    6117,  6118,  6120,  6121,  6123,  6124,  6126,  6127,  6128,  6129,
+    6130,  6131,  6132,  6133,  6134,  6135,  6136,  6139,  6143,  6144,
+    6146,  6147,  6149,  6150,  6152,  6153,  6154,  6155,  6156,  6157,
+    6158,  6159,  6160,  6161,  6163,  6164,  6166,  6167,  6169,  6170,
+    6172,  6173,  6175,  6176,  6178,  6179,  6188,  6191,  6195,  6196,
+    6198,  6199,  6201,  6202,  6204,  6205,  6206,  6207,  6208,  6209,
+    6210,  6211,  6212,  6213,  6214,  6217,  6221,  6222,  6224,  6225,
+    6227,  6228,  6230,  6231,  6232,  6233,  6234,  6235,  6236,  6237,
+    6238,  6239,  6266,  6267,  6268,  6269,  6270,  6271,  6284,  6285,
+    6286,  6287,  6289,  6290,  6292,  6293,  6294,  6295,  6296,  6297,
+    6310,  6311,  6312,  6314,  6315,  6317,  6344,  6345,  6346,  6347,
+    6348,  6349,  6362,  6363,  6364,  6365,  6367,  6368,  6370,  6371,
+    6372,  6373,  6374,  6375,  6388,  6389,  6390,  6392,  6393,  6395,
+    6422,  6423,  6424,  6425,  6426,  6427,  6440,  6441,  6442,  6444,
+    6445,  6447,  6448,  6449,  6450,  6451,  6452,  6453,  6466,  6467,
+    6468,  6469,  6471,  6472,  6500,  6501,  6502,  6503,  6504,  6505,
+    6518,  6519,  6520,  6522,  6523,  6525,  6526,  6527,  6528,  6529,
+    6530,  6531,  6544,  6545,  6546,  6547,  6549,  6550,  6553,  6554,
+    6556,  6557,  6559,  6560,  6562,  6563,  6565,  6566,  6568,  6569,
+    6579,  6580,  6582,  6583,  6585,  6586,  6588,  6589,  6591,  6592,
+    6594,  6595,  6605,  6606,  6608,  6609,  6611,  6612,  6614,  6615,
+    6617,  6618,  6620,  6621,  6631,  6632,  6634,  6635,  6637,  6640,
+    6644,  6647,  6657,  6658,  6660,  6661,  6664,  6667,  6669,  6672,
+    6683,  6684,  6686,  6687,  6689,  6690,  6692,  6693,  6695,  6696,
+    6698,  6699,  6709,  6710,  6712,  6713,  6715,  6718,  6722,  6725,
+    6735,  6736,  6738,  6739,  6742,  6745,  6747,  6750,  6761,  6764,
+    6766,  6768,  6769,  6771,  6772,  6774,  6775,  6777,  6778,  6779,
+    6780,  6781,  6782,  6783,  6784,  6785,  6786,  6788,  6789,  6791,
+    6792,  6794,  6795,  6797,  6798,  6800,  6801,  6803,  6813,  6816,
+    6818,  6820,  6821,  6823,  6824,  6826,  6827,  6829,  6830,  6831,
+    6832,  6833,  6834,  6835,  6836,  6837,  6839,  6842,  6844,  6846,
+    6847,  6849,  6850,  6852,  6853,  6855,  6856,  6857,  6858,  6859,
+    6860,  6861,  6862,  6863,  6864,  6866,  6867,  6869,  6870,  6872,
+    6873,  6875,  6876,  6878,  6879,  6881,  6891,  6894,  6896,  6898,
+    6899,  6901,  6902,  6904,  6905,  6907,  6908,  6909,  6910,  6911,
+    6912,  6913,  6914,  6915,  6916,  6917,  6918,  6919,  6920,  6921,
+    6934,  6935,  6936,  6937,  6939,  6940,  6968,  6969,  6970,  6971,
+    6972,  6973,  6986,  6987,  6989,  6990,  6992,  6993,  6994,  6995,
+    6996,  6997,  6998,  6999,  7012,  7013,  7014,  7015,  7017,  7018,
+    7046,  7047,  7048,  7049,  7050,  7051,  7064,  7065,  7067,  7068,
+    7070,  7071,  7072,  7073,  7074,  7075,  7076,  7077,  7090,  7091,
+    7093,  7094,  7096,  7097,  7124,  7125,  7126,  7127,  7128,  7129,
+    7142,  7143,  7144,  7145,  7147,  7148,  7150,  7151,  7152,  7153,
+    7154,  7155,  7168,  7169,  7171,  7172,  7174,  7175,  7202,  7203,
+    7204,  7205,  7206,  7207,  7220,  7221,  7222,  7223,  7225,  7226,
+    7228,  7230,  7231,  7233,  7234,  7236,  7237,  7239,  7240,  7242,
+    7243,  7245,  7254,  7256,  7257,  7259,  7260,  7262,  7263,  7265,
+    7266,  7268,  7269,  7271,  7280,  7282,  7283,  7285,  7286,  7289,
+    7294,  7297,  7306,  7308,  7309,  7311,  7312,  7314,  7315,  7317,
+    7318,  7320,  7321,  7323,  7332,  7334,  7335,  7337,  7340,  7343,
+    7344,  7347,  7358,  7360,  7361,  7363,  7364,  7367,  7372,  7375,
+    7384,  7386,  7387,  7389,  7390,  7392,  7393,  7395,  7396,  7398,
+    7399,  7401,  7410,  7412,  7413,  7415,  7418,  7421,  7422,  7425,
+    7438,  7441,  7442,  7443,  7445,  7446,  7448,  7449,  7451,  7452,
+    7454,  7455,  7456,  7457,  7458,  7459,  7460,  7461,  7464,  7467,
+    7468,  7469,  7471,  7472,  7474,  7475,  7477,  7478,  7480,  7481,
+    7482,  7483,  7484,  7485,  7486,  7487,  7488,  7489,  7491,  7492,
+    7494,  7495,  7497,  7498,  7500,  7501,  7503,  7504,  7516,  7519,
+    7520,  7521,  7523,  7524,  7526,  7527,  7529,  7530,  7532,  7533,
+    7534,  7535,  7536,  7537,  7538,  7539,  7542,  7545,  7546,  7547,
+    7549,  7550,  7552,  7553,  7555,  7556,  7558,  7559,  7560,  7561,
+    7562,  7563,  7564,  7565,  7566,  7567,  7569,  7570,  7572,  7573,
+    7575,  7576,  7578,  7579,  7581,  7582,  7592,  7593,  7594,  7595,
+    7596,  7597,  7610,  7611,  7612,  7614,  7615,  7617,  7618,  7619,
+    7620,  7621,  7622,  7623,  7636,  7637,  7639,  7640,  7642,  7643,
+    7670,  7671,  7672,  7673,  7674,  7675,  7688,  7689,  7690,  7692,
+    7693,  7695,  7696,  7697,  7698,  7699,  7700,  7701,  7714,  7715,
+    7717,  7718,  7720,  7721,  7748,  7749,  7750,  7751,  7752,  7753,
+    7766,  7767,  7769,  7770,  7772,  7773,  7774,  7775,  7776,  7777,
+    7778,  7779,  7792,  7793,  7794,  7796,  7797,  7799,  7826,  7827,
+    7828,  7829,  7830,  7831,  7844,  7845,  7847,  7848,  7850,  7851,
+    7852,  7853,  7854,  7855,  7856,  7857,  7870,  7871,  7872,  7874,
+    7875,  7877,  7904,  7905,  7907,  7908,  7910,  7911,  7913,  7914,
+    7916,  7917,  7919,  7920,  7930,  7931,  7933,  7934,  7936,  7937,
+    7939,  7940,  7942,  7943,  7945,  7946,  7956,  7957,  7959,  7960,
+    7962,  7965,  7969,  7972,  7982,  7983,  7985,  7986,  7989,  7992,
+    7994,  7997,  8008,  8009,  8011,  8012,  8014,  8015,  8017,  8018,
+    8020,  8021,  8023,  8024,  8034,  8035,  8037,  8038,  8040,  8043,
+    8047,  8050,  8060,  8061,  8063,  8064,  8067,  8070,  8072,  8075,
+    8086,  8087,  8089,  8090,  8092,  8093,  8095,  8096,  8098,  8099,
+    8101,  8102,  8113,  8114,  8116,  8117,  8119,  8120,  8122,  8123,
+    8125,  8126,  8128,  8129,  8138,  8141,  8145,  8146,  8148,  8149,
+    8151,  8152,  8154,  8155,  8156,  8157,  8158,  8159,  8160,  8161,
+    8162,  8163,  8164,  8167,  8171,  8172,  8174,  8175,  8177,  8178,
+    8180,  8181,  8182,  8183,  8184,  8185,  8186,  8187,  8188,  8189,
+    8191,  8192,  8194,  8195,  8197,  8198,  8200,  8201,  8203,  8204,
+    8206,  8207,  8216,  8219,  8223,  8224,  8226,  8227,  8229,  8230,
+    8232,  8233,  8234,  8235,  8236,  8237,  8238,  8239,  8240,  8241,
+    8242,  8245,  8249,  8250,  8252,  8253,  8255,  8256,  8258,  8259,
+    8260,  8261,  8262,  8263,  8264,  8265,  8266,  8267,  8294,  8295,
+    8296,  8297,  8298,  8299,  8312,  8313,  8315,  8316,  8318,  8319,
+    8320,  8321,  8322,  8323,  8324,  8325,  8338,  8339,  8341,  8342,
+    8344,  8345,  8372,  8373,  8374,  8375,  8376,  8377,  8390,  8391,
+    8393,  8394,  8396,  8397,  8398,  8399,  8400,  8401,  8402,  8403,
+    8416,  8417,  8419,  8420,  8422,  8423,  8450,  8451,  8452,  8453,
+    8454,  8455,  8470,  8471,  8472,  8473,  8474,  8475,  8476,  8477,
+    8478,  8479,  8480,  8481,  8496,  8497,  8498,  8499,  8500,  8501,
+    8528,  8529,  8530,  8531,  8532,  8533,  8548,  8549,  8550,  8551,
+    8552,  8553,  8554,  8555,  8556,  8557,  8558,  8559,  8574,  8575,
+    8576,  8577,  8578,  8579,  8581,  8582,  8584,  8585,  8587,  8588,
+    8590,  8591,  8607,  8608,  8610,  8611,  8613,  8614,  8616,  8617,
+    8633,  8634,  8636,  8637,  8645,  8646,  8648,  8649,  8659,  8660,
+    8662,  8663,  8665,  8666,  8668,  8669,  8671,  8672,  8674,  8675,
+    8685,  8686,  8688,  8689,  8691,  8692,  8694,  8695,  8697,  8698,
+    8700,  8701,  8711,  8712,  8714,  8715,  8723,  8724,  8726,  8727,
+    8737,  8738,  8740,  8741,  8743,  8744,  8746,  8747,  8749,  8750,
+    8752,  8753,  8763,  8764,  8766,  8767,  8769,  8770,  8772,  8773,
+    8775,  8776,  8778,  8779,  8789,  8792,  8794,  8796,  8797,  8799,
+    8800,  8802,  8803,  8805,  8806,  8807,  8808,  8809,  8810,  8811,
+    8812,  8813,  8814,  8816,  8817,  8819,  8820,  8822,  8823,  8825,
+    8826,  8828,  8829,  8831,  8841,  8844,  8846,  8848,  8849,  8851,
+    8852,  8854,  8855,  8857,  8858,  8859,  8860,  8861,  8862,  8863,
+    8864,  8865,  8867,  8870,  8872,  8874,  8875,  8877,  8878,  8880,
+    8881,  8883,  8884,  8885,  8886,  8887,  8888,  8889,  8890,  8891,
+    8892,  8894,  8895,  8897,  8898,  8900,  8901,  8903,  8904,  8906,
+    8907,  8909,  8919,  8922,  8924,  8926,  8927,  8929,  8930,  8932,
+    8933,  8935,  8936,  8937,  8938,  8939,  8940,  8941,  8942,  8943,
+    8944,  8945,  8946,  8947,  8948,  8949,  8962,  8963,  8964,  8966,
+    8967,  8969,  8996,  8997,  8998,  8999,  9000,  9001,  9014,  9015,
+    9016,  9018,  9019,  9021,  9022,  9023,  9024,  9025,  9026,  9027,
+    9040,  9041,  9042,  9044,  9045,  9047,  9074,  9075,  9076,  9077,
+    9078,  9079,  9092,  9093,  9094,  9096,  9097,  9099,  9100,  9101,
+    9102,  9103,  9104,  9105,  9120,  9121,  9122,  9123,  9124,  9125,
+    9152,  9153,  9154,  9155,  9156,  9157,  9172,  9173,  9174,  9175,
+    9176,  9177,  9178,  9179,  9180,  9181,  9182,  9183,  9198,  9199,
+    9200,  9201,  9202,  9203,  9230,  9231,  9232,  9233,  9234,  9235,
+    9250,  9251,  9252,  9253,  9254,  9255,  9256,  9258,  9259,  9261,
+    9262,  9264,  9265,  9267,  9282,  9284,  9285,  9287,  9288,  9290,
+    9291,  9293,  9308,  9310,  9311,  9313,  9314,  9316,  9317,  9319,
+    9320,  9322,  9323,  9325,  9334,  9336,  9337,  9339,  9346,  9348,
+    9349,  9351,  9360,  9362,  9363,  9365,  9366,  9368,  9369,  9371,
+    9372,  9374,  9375,  9377,  9386,  9388,  9389,  9391,  9392,  9394,
+    9395,  9397,  9398,  9400,  9401,  9403,  9412,  9414,  9415,  9417,
+    9424,  9426,  9427,  9429,  9438,  9440,  9441,  9443,  9444,  9446,
+    9447,  9449,  9450,  9452,  9453,  9455,  9466,  9469,  9470,  9471,
+    9473,  9474,  9476,  9477,  9479,  9480,  9482,  9483,  9484,  9485,
+    9486,  9487,  9488,  9489,  9492,  9495,  9496,  9497,  9499,  9500,
+    9502,  9503,  9505,  9506,  9508,  9509,  9510,  9511,  9512,  9513,
+    9514,  9515,  9516,  9517,  9519,  9520,  9522,  9523,  9525,  9526,
+    9528,  9529,  9531,  9532,  9544,  9547,  9548,  9549,  9551,  9552,
+    9554,  9555,  9557,  9558,  9560,  9561,  9562,  9563,  9564,  9565,
+    9566,  9567,  9570,  9573,  9574,  9575,  9577,  9578,  9580,  9581,
+    9583,  9584,  9586,  9587,  9588,  9589,  9590,  9591,  9592,  9593,
+    9594,  9595,  9597,  9598,  9600,  9601,  9603,  9604,  9606,  9607,
+    9609,  9610,  9620,  9621,  9622,  9623,  9624,  9625,  9638,  9639,
+    9640,  9641,  9643,  9644,  9646,  9647,  9648,  9649,  9650,  9651,
+    9664,  9665,  9666,  9667,  9669,  9670,  9698,  9699,  9700,  9701,
+    9702,  9703,  9716,  9717,  9718,  9719,  9721,  9722,  9724,  9725,
+    9726,  9727,  9728,  9729,  9742,  9743,  9744,  9745,  9747,  9748,
+    9776,  9777,  9778,  9779,  9780,  9781,  9796,  9797,  9798,  9799,
+    9800,  9801,  9802,  9803,  9804,  9805,  9806,  9807,  9822,  9823,
+    9824,  9825,  9826,  9827,  9854,  9855,  9856,  9857,  9858,  9859,
+    9874,  9875,  9876,  9877,  9878,  9879,  9880,  9881,  9882,  9883,
+    9884,  9885,  9900,  9901,  9902,  9903,  9904,  9905,  9932,  9933,
+    9935,  9936,  9938,  9939,  9941,  9942,  9958,  9959,  9961,  9962,
+    9964,  9965,  9967,  9968,  9984,  9985,  9987,  9988,  9990,  9991,
+    9993,  9994,  9996,  9997,  9999,  10000, 10010, 10011, 10013, 10014,
+    10016, 10017, 10019, 10020, 10022, 10023, 10025, 10026, 10036, 10037,
+    10039, 10040, 10048, 10049, 10051, 10052, 10062, 10063, 10065, 10066,
+    10068, 10069, 10071, 10072, 10074, 10075, 10077, 10078, 10088, 10089,
+    10091, 10092, 10094, 10095, 10097, 10098, 10100, 10101, 10103, 10104,
+    10114, 10115, 10117, 10118, 10126, 10127, 10129, 10130, 10141, 10142,
+    10144, 10145, 10147, 10148, 10150, 10151, 10153, 10154, 10156, 10157,
+    10166, 10169, 10173, 10174, 10176, 10177, 10179, 10180, 10182, 10183,
+    10184, 10185, 10186, 10187, 10188, 10189, 10190, 10191, 10192, 10195,
+    10199, 10200, 10202, 10203, 10205, 10206, 10208, 10209, 10210, 10211,
+    10212, 10213, 10214, 10215, 10216, 10217, 10219, 10220, 10222, 10223,
+    10225, 10226, 10228, 10229, 10231, 10232, 10234, 10235, 10244, 10247,
+    10251, 10252, 10254, 10255, 10257, 10258, 10260, 10261, 10262, 10263,
+    10264, 10265, 10266, 10267, 10268, 10269, 10270, 10273, 10277, 10278,
+    10280, 10281, 10283, 10284, 10286, 10287, 10288, 10289, 10290, 10291,
+    10292, 10293, 10294, 10295, 10322, 10323, 10324, 10325, 10326, 10327,
+    10340, 10341, 10343, 10344, 10346, 10347, 10348, 10349, 10350, 10351,
+    10352, 10353, 10366, 10367, 10369, 10370, 10372, 10373, 10400, 10401,
+    10402, 10403, 10404, 10405, 10418, 10419, 10421, 10422, 10424, 10425,
+    10426, 10427, 10428, 10429, 10430, 10431, 10444, 10445, 10447, 10448,
+    10450, 10451, 10478, 10479, 10480, 10481, 10482, 10483, 10498, 10499,
+    10500, 10501, 10502, 10503, 10504, 10505, 10506, 10507, 10508, 10509,
+    10524, 10525, 10526, 10527, 10528, 10529, 10556, 10557, 10558, 10559,
+    10560, 10561, 10576, 10577, 10578, 10579, 10580, 10581, 10582, 10583,
+    10584, 10585, 10586, 10587, 10602, 10603, 10604, 10605, 10606, 10607,
+    10609, 10610, 10612, 10613, 10615, 10616, 10618, 10619, 10635, 10636,
+    10638, 10639, 10641, 10642, 10644, 10645, 10661, 10662, 10664, 10665,
+    10673, 10674, 10676, 10677, 10687, 10688, 10690, 10691, 10693, 10694,
+    10696, 10697, 10699, 10700, 10702, 10703, 10713, 10714, 10716, 10717,
+    10719, 10720, 10722, 10723, 10725, 10726, 10728, 10729, 10739, 10740,
+    10742, 10743, 10751, 10752, 10754, 10755, 10765, 10766, 10768, 10769,
+    10771, 10772, 10774, 10775, 10777, 10778, 10780, 10781, 10791, 10792,
+    10794, 10795, 10797, 10798, 10800, 10801, 10803, 10804, 10806, 10807,
+    10817, 10820, 10822, 10824, 10825, 10827, 10828, 10830, 10831, 10833,
+    10834, 10835, 10836, 10837, 10838, 10839, 10840, 10841, 10842, 10844,
+    10845, 10847, 10848, 10850, 10851, 10853, 10854, 10856, 10857, 10859,
+    10869, 10872, 10874, 10876, 10877, 10879, 10880, 10882, 10883, 10885,
+    10886, 10887, 10888, 10889, 10890, 10891, 10892, 10893, 10895, 10898,
+    10900, 10902, 10903, 10905, 10906, 10908, 10909, 10911, 10912, 10913,
+    10914, 10915, 10916, 10917, 10918, 10919, 10920, 10922, 10923, 10925,
+    10926, 10928, 10929, 10931, 10932, 10934, 10935, 10937, 10947, 10950,
+    10952, 10954, 10955, 10957, 10958, 10960, 10961, 10963, 10964, 10965,
+    10966, 10967, 10968, 10969, 10970, 10971, 10972, 10973, 10974, 10975,
+    10976, 10977, 10990, 10991, 10992, 10994, 10995, 10997, 11024, 11025,
+    11026, 11027, 11028, 11029, 11042, 11043, 11044, 11046, 11047, 11049,
+    11050, 11051, 11052, 11053, 11054, 11055, 11068, 11069, 11070, 11072,
+    11073, 11075, 11102, 11103, 11104, 11105, 11106, 11107, 11120, 11121,
+    11122, 11124, 11125, 11127, 11128, 11129, 11130, 11131, 11132, 11133,
+    11148, 11149, 11150, 11151, 11152, 11153, 11180, 11181, 11182, 11183,
+    11184, 11185, 11200, 11201, 11202, 11203, 11204, 11205, 11206, 11207,
+    11208, 11209, 11210, 11211, 11226, 11227, 11228, 11229, 11230, 11231,
+    11258, 11259, 11260, 11261, 11262, 11263, 11278, 11279, 11280, 11281,
+    11282, 11283, 11284, 11286, 11287, 11289, 11290, 11292, 11293, 11295,
+    11310, 11312, 11313, 11315, 11316, 11318, 11319, 11321, 11336, 11338,
+    11339, 11341, 11342, 11344, 11345, 11347, 11348, 11350, 11351, 11353,
+    11362, 11364, 11365, 11367, 11374, 11376, 11377, 11379, 11388, 11390,
+    11391, 11393, 11394, 11396, 11397, 11399, 11400, 11402, 11403, 11405,
+    11414, 11416, 11417, 11419, 11420, 11422, 11423, 11425, 11426, 11428,
+    11429, 11431, 11440, 11442, 11443, 11445, 11452, 11454, 11455, 11457,
+    11466, 11468, 11469, 11471, 11472, 11474, 11475, 11477, 11478, 11480,
+    11481, 11483, 11494, 11497, 11498, 11499, 11501, 11502, 11504, 11505,
+    11507, 11508, 11510, 11511, 11512, 11513, 11514, 11515, 11516, 11517,
+    11520, 11523, 11524, 11525, 11527, 11528, 11530, 11531, 11533, 11534,
+    11536, 11537, 11538, 11539, 11540, 11541, 11542, 11543, 11544, 11545,
+    11547, 11548, 11550, 11551, 11553, 11554, 11556, 11557, 11559, 11560,
+    11572, 11575, 11576, 11577, 11579, 11580, 11582, 11583, 11585, 11586,
+    11588, 11589, 11590, 11591, 11592, 11593, 11594, 11595, 11598, 11601,
+    11602, 11603, 11605, 11606, 11608, 11609, 11611, 11612, 11614, 11615,
+    11616, 11617, 11618, 11619, 11620, 11621, 11622, 11623, 11625, 11626,
+    11628, 11629, 11631, 11632, 11634, 11635, 11637, 11638, 11648, 11649,
+    11650, 11651, 11652, 11653, 11666, 11667, 11668, 11669, 11671, 11672,
+    11674, 11675, 11676, 11677, 11678, 11679, 11692, 11693, 11694, 11695,
+    11697, 11698, 11726, 11727, 11728, 11729, 11730, 11731, 11744, 11745,
+    11746, 11747, 11749, 11750, 11752, 11753, 11754, 11755, 11756, 11757,
+    11770, 11771, 11772, 11773, 11775, 11776, 11804, 11805, 11806, 11807,
+    11808, 11809, 11824, 11825, 11826, 11827, 11828, 11829, 11830, 11831,
+    11832, 11833, 11834, 11835, 11850, 11851, 11852, 11853, 11854, 11855,
+    11882, 11883, 11884, 11885, 11886, 11887, 11902, 11903, 11904, 11905,
+    11906, 11907, 11908, 11909, 11910, 11911, 11912, 11913, 11928, 11929,
+    11930, 11931, 11932, 11933, 11960, 11961, 11963, 11964, 11966, 11967,
+    11969, 11970, 11986, 11987, 11989, 11990, 11992, 11993, 11995, 11996,
+    12012, 12013, 12015, 12016, 12018, 12019, 12021, 12022, 12024, 12025,
+    12027, 12028, 12038, 12039, 12041, 12042, 12044, 12045, 12047, 12048,
+    12050, 12051, 12053, 12054, 12064, 12065, 12067, 12068, 12076, 12077,
+    12079, 12080, 12090, 12091, 12093, 12094, 12096, 12097, 12099, 12100,
+    12102, 12103, 12105, 12106, 12116, 12117, 12119, 12120, 12122, 12123,
+    12125, 12126, 12128, 12129, 12131, 12132, 12142, 12143, 12145, 12146,
+    12154, 12155, 12157, 12158, 12169, 12170, 12172, 12173, 12175, 12176,
+    12178, 12179, 12181, 12182, 12184, 12185, 12194, 12196, 12197, 12199,
+    12200, 12202, 12203, 12205, 12206, 12208, 12209, 12211, 12220, 12221,
+    12223, 12224, 12226, 12227, 12229, 12230, 12232, 12233, 12235, 12236,
+    12247, 12248, 12250, 12251, 12253, 12254, 12256, 12257, 12259, 12260,
+    12262, 12263, 12272, 12274, 12275, 12277, 12278, 12280, 12281, 12283,
+    12284, 12286, 12287, 12289, 12298, 12299, 12301, 12302, 12304, 12305,
+    12307, 12308, 12310, 12311, 12313, 12314, 12325, 12326, 12328, 12329,
+    12331, 12332, 12334, 12335, 12337, 12338, 12340, 12341, 12350, 12352,
+    12353, 12355, 12356, 12358, 12359, 12361, 12362, 12364, 12365, 12367,
+    12376, 12377, 12379, 12380, 12382, 12383, 12385, 12386, 12388, 12389,
+    12391, 12392, 12403, 12404, 12406, 12407, 12409, 12410, 12412, 12413,
+    12415, 12416, 12418, 12419, 12428, 12430, 12431, 12433, 12434, 12436,
+    12437, 12439, 12440, 12442, 12443, 12445, 12454, 12455, 12457, 12458,
+    12460, 12461, 12463, 12464, 12466, 12467, 12469, 12470, 12481, 12482,
+    12484, 12485, 12487, 12488, 12490, 12491, 12506, 12508, 12509, 12511,
+    12512, 12514, 12515, 12517, 12532, 12533, 12535, 12536, 12538, 12539,
+    12541, 12542, 12559, 12560, 12562, 12563, 12565, 12566, 12568, 12569,
+    12584, 12586, 12587, 12589, 12590, 12592, 12593, 12595, 12610, 12611,
+    12613, 12614, 12616, 12617, 12619, 12620, 12845, 12846, 12848, 12849,
+    12851, 12852, 12854, 12855, 12857, 12858, 12860, 12861, 12870, 12872,
+    12873, 12875, 12876, 12878, 12879, 12881, 12882, 12884, 12885, 12887,
+    12896, 12897, 12899, 12900, 12902, 12903, 12905, 12906, 12908, 12909,
+    12911, 12912, 12923, 12924, 12926, 12927, 12929, 12930, 12932, 12933,
+    12935, 12936, 12938, 12939, 12948, 12950, 12951, 12953, 12954, 12956,
+    12957, 12959, 12960, 12962, 12963, 12965, 12974, 12975, 12977, 12978,
+    12980, 12981, 12983, 12984, 12986, 12987, 12989, 12990, 13001, 13002,
+    13004, 13005, 13007, 13008, 13010, 13011, 13013, 13014, 13016, 13017,
+    13026, 13028, 13029, 13031, 13032, 13034, 13035, 13037, 13038, 13040,
+    13041, 13043, 13052, 13053, 13055, 13056, 13058, 13059, 13061, 13062,
+    13064, 13065, 13067, 13068, 13079, 13080, 13082, 13083, 13085, 13086,
+    13088, 13089, 13091, 13092, 13094, 13095, 13104, 13106, 13107, 13109,
+    13110, 13112, 13113, 13115, 13116, 13118, 13119, 13121, 13130, 13131,
+    13133, 13134, 13136, 13137, 13139, 13140, 13142, 13143, 13145, 13146,
+    13157, 13158, 13160, 13161, 13163, 13164, 13166, 13167, 13182, 13184,
+    13185, 13187, 13188, 13190, 13191, 13193, 13208, 13209, 13211, 13212,
+    13214, 13215, 13217, 13218, 13235, 13236, 13238, 13239, 13241, 13242,
+    13244, 13245, 13260, 13262, 13263, 13265, 13266, 13268, 13269, 13271,
+    13286, 13287, 13289, 13290, 13292, 13293, 13295, 13296, 13521, 13522,
+    13524, 13525, 13527, 13528, 13530, 13531, 13533, 13534, 13536, 13537,
+    13546, 13548, 13549, 13551, 13552, 13554, 13555, 13557, 13558, 13560,
+    13561, 13563, 13572, 13573, 13575, 13576, 13578, 13579, 13581, 13582,
+    13584, 13585, 13587, 13588, 13599, 13600, 13602, 13603, 13605, 13606,
+    13608, 13609, 13611, 13612, 13614, 13615, 13624, 13626, 13627, 13629,
+    13630, 13632, 13633, 13635, 13636, 13638, 13639, 13641, 13650, 13651,
+    13653, 13654, 13656, 13657, 13659, 13660, 13662, 13663, 13665, 13666,
+    13677, 13678, 13680, 13681, 13683, 13684, 13686, 13687, 13689, 13690,
+    13692, 13693, 13702, 13704, 13705, 13707, 13708, 13711, 13716, 13719,
+    13728, 13729, 13731, 13732, 13734, 13737, 13741, 13744, 13755, 13756,
+    13758, 13759, 13761, 13762, 13764, 13765, 13767, 13768, 13770, 13771,
+    13780, 13782, 13783, 13785, 13786, 13789, 13794, 13797, 13806, 13807,
+    13809, 13810, 13812, 13815, 13819, 13822, 13833, 13834, 13836, 13837,
+    13845, 13846, 13848, 13849, 13858, 13860, 13861, 13863, 13864, 13866,
+    13867, 13869, 13870, 13872, 13873, 13875, 13884, 13885, 13887, 13888,
+    13890, 13891, 13893, 13894, 13896, 13897, 13899, 13900, 13911, 13912,
+    13914, 13915, 13923, 13924, 13926, 13927, 13936, 13938, 13939, 13941,
+    13942, 13944, 13945, 13947, 13948, 13950, 13951, 13953, 13962, 13963,
+    13965, 13966, 13968, 13969, 13971, 13972, 13974, 13975, 13977, 13978,
+    14197, 14198, 14200, 14201, 14203, 14204, 14206, 14207, 14209, 14210,
+    14212, 14213, 14222, 14224, 14225, 14227, 14228, 14230, 14231, 14233,
+    14234, 14236, 14237, 14239, 14248, 14249, 14251, 14252, 14254, 14255,
+    14257, 14258, 14260, 14261, 14263, 14264, 14275, 14276, 14278, 14279,
+    14281, 14282, 14284, 14285, 14287, 14288, 14290, 14291, 14300, 14302,
+    14303, 14305, 14306, 14308, 14309, 14311, 14312, 14314, 14315, 14317,
+    14326, 14327, 14329, 14330, 14332, 14333, 14335, 14336, 14338, 14339,
+    14341, 14342, 14353, 14354, 14356, 14357, 14359, 14362, 14366, 14369,
+    14378, 14380, 14381, 14383, 14384, 14386, 14387, 14389, 14390, 14392,
+    14393, 14395, 14404, 14405, 14407, 14408, 14411, 14414, 14416, 14419,
+    14431, 14432, 14434, 14435, 14437, 14440, 14444, 14447, 14456, 14458,
+    14459, 14461, 14462, 14464, 14465, 14467, 14468, 14470, 14471, 14473,
+    14482, 14483, 14485, 14486, 14489, 14492, 14494, 14497, 14509, 14510,
+    14512, 14513, 14515, 14516, 14518, 14519, 14521, 14522, 14524, 14525,
+    14534, 14536, 14537, 14539, 14546, 14548, 14549, 14551, 14560, 14561,
+    14563, 14564, 14566, 14567, 14569, 14570, 14572, 14573, 14575, 14576,
+    14587, 14588, 14590, 14591, 14593, 14594, 14596, 14597, 14599, 14600,
+    14602, 14603, 14612, 14614, 14615, 14617, 14624, 14626, 14627, 14629,
+    14638, 14639, 14641, 14642, 14644, 14645, 14647, 14648, 14650, 14651,
+    14653, 14654, 14873, 14874, 14876, 14877, 14879, 14880, 14882, 14883,
+    14885, 14886, 14888, 14889, 14898, 14900, 14901, 14903, 14904, 14906,
+    14907, 14909, 14910, 14912, 14913, 14915, 14924, 14925, 14927, 14928,
+    14930, 14931, 14933, 14934, 14936, 14937, 14939, 14940, 14951, 14952,
+    14954, 14955, 14957, 14958, 14960, 14961, 14963, 14964, 14966, 14967,
+    14976, 14978, 14979, 14981, 14982, 14984, 14985, 14987, 14988, 14990,
+    14991, 14993, 15002, 15003, 15005, 15006, 15008, 15009, 15011, 15012,
+    15014, 15015, 15017, 15018, 15029, 15030, 15032, 15033, 15036, 15039,
+    15041, 15044, 15054, 15056, 15057, 15059, 15062, 15065, 15066, 15069,
+    15080, 15081, 15083, 15084, 15086, 15087, 15089, 15090, 15092, 15093,
+    15095, 15096, 15107, 15108, 15110, 15111, 15114, 15117, 15119, 15122,
+    15132, 15134, 15135, 15137, 15140, 15143, 15144, 15147, 15158, 15159,
+    15161, 15162, 15164, 15165, 15167, 15168, 15170, 15171, 15173, 15174,
+    15185, 15186, 15188, 15189, 15191, 15192, 15194, 15195, 15197, 15198,
+    15200, 15201, 15210, 15212, 15213, 15215, 15216, 15218, 15219, 15221,
+    15222, 15224, 15225, 15227, 15236, 15237, 15239, 15240, 15248, 15249,
+    15251, 15252, 15263, 15264, 15266, 15267, 15269, 15270, 15272, 15273,
+    15275, 15276, 15278, 15279, 15288, 15290, 15291, 15293, 15294, 15296,
+    15297, 15299, 15300, 15302, 15303, 15305, 15314, 15315, 15317, 15318,
+    15326, 15327, 15329, 15330, 15549, 15550, 15552, 15553, 15555, 15556,
+    15558, 15559, 15561, 15562, 15564, 15565, 15574, 15576, 15577, 15579,
+    15580, 15582, 15583, 15585, 15586, 15588, 15589, 15591, 15600, 15601,
+    15603, 15604, 15606, 15607, 15609, 15610, 15612, 15613, 15615, 15616,
+    15627, 15628, 15630, 15631, 15633, 15634, 15636, 15637, 15639, 15640,
+    15642, 15643, 15652, 15654, 15655, 15657, 15658, 15660, 15661, 15663,
+    15664, 15666, 15667, 15669, 15678, 15679, 15681, 15682, 15684, 15685,
+    15687, 15688, 15690, 15691, 15693, 15694, 15705, 15706, 15708, 15709,
+    15711, 15712, 15714, 15715, 15717, 15718, 15720, 15721, 15730, 15732,
+    15733, 15735, 15736, 15739, 15744, 15747, 15756, 15757, 15759, 15760,
+    15762, 15765, 15769, 15772, 15783, 15784, 15786, 15787, 15789, 15790,
+    15792, 15793, 15795, 15796, 15798, 15799, 15808, 15810, 15811, 15813,
+    15814, 15817, 15822, 15825, 15834, 15835, 15837, 15838, 15840, 15843,
+    15847, 15850, 15861, 15862, 15864, 15865, 15873, 15874, 15876, 15877,
+    15886, 15888, 15889, 15891, 15892, 15894, 15895, 15897, 15898, 15900,
+    15901, 15903, 15912, 15913, 15915, 15916, 15918, 15919, 15921, 15922,
+    15924, 15925, 15927, 15928, 15939, 15940, 15942, 15943, 15951, 15952,
+    15954, 15955, 15964, 15966, 15967, 15969, 15970, 15972, 15973, 15975,
+    15976, 15978, 15979, 15981, 15990, 15991, 15993, 15994, 15996, 15997,
+    15999, 16000, 16002, 16003, 16005, 16006, 16225, 16226, 16228, 16229,
+    16231, 16232, 16234, 16235, 16237, 16238, 16240, 16241, 16250, 16252,
+    16253, 16255, 16256, 16258, 16259, 16261, 16262, 16264, 16265, 16267,
+    16276, 16277, 16279, 16280, 16282, 16283, 16285, 16286, 16288, 16289,
+    16291, 16292, 16303, 16304, 16306, 16307, 16309, 16310, 16312, 16313,
+    16315, 16316, 16318, 16319, 16328, 16330, 16331, 16333, 16334, 16336,
+    16337, 16339, 16340, 16342, 16343, 16345, 16354, 16355, 16357, 16358,
+    16360, 16361, 16363, 16364, 16366, 16367, 16369, 16370, 16381, 16382,
+    16384, 16385, 16387, 16390, 16394, 16397, 16406, 16408, 16409, 16411,
+    16412, 16414, 16415, 16417, 16418, 16420, 16421, 16423, 16432, 16433,
+    16435, 16436, 16439, 16442, 16444, 16447, 16459, 16460, 16462, 16463,
+    16465, 16468, 16472, 16475, 16484, 16486, 16487, 16489, 16490, 16492,
+    16493, 16495, 16496, 16498, 16499, 16501, 16510, 16511, 16513, 16514,
+    16517, 16520, 16522, 16525, 16537, 16538, 16540, 16541, 16543, 16544,
+    16546, 16547, 16549, 16550, 16552, 16553, 16562, 16564, 16565, 16567,
+    16574, 16576, 16577, 16579, 16588, 16589, 16591, 16592, 16594, 16595,
+    16597, 16598, 16600, 16601, 16603, 16604, 16615, 16616, 16618, 16619,
+    16621, 16622, 16624, 16625, 16627, 16628, 16630, 16631, 16640, 16642,
+    16643, 16645, 16652, 16654, 16655, 16657, 16666, 16667, 16669, 16670,
+    16672, 16673, 16675, 16676, 16678, 16679, 16681, 16682, 16901, 16902,
+    16904, 16905, 16907, 16908, 16910, 16911, 16913, 16914, 16916, 16917,
+    16926, 16928, 16929, 16931, 16932, 16934, 16935, 16937, 16938, 16940,
+    16941, 16943, 16952, 16953, 16955, 16956, 16958, 16959, 16961, 16962,
+    16964, 16965, 16967, 16968, 16979, 16980, 16982, 16983, 16985, 16986,
+    16988, 16989, 16991, 16992, 16994, 16995, 17004, 17006, 17007, 17009,
+    17010, 17012, 17013, 17015, 17016, 17018, 17019, 17021, 17030, 17031,
+    17033, 17034, 17036, 17037, 17039, 17040, 17042, 17043, 17045, 17046,
+    17057, 17058, 17060, 17061, 17064, 17067, 17069, 17072, 17082, 17084,
+    17085, 17087, 17090, 17093, 17094, 17097, 17108, 17109, 17111, 17112,
+    17114, 17115, 17117, 17118, 17120, 17121, 17123, 17124, 17135, 17136,
+    17138, 17139, 17142, 17145, 17147, 17150, 17160, 17162, 17163, 17165,
+    17168, 17171, 17172, 17175, 17186, 17187, 17189, 17190, 17192, 17193,
+    17195, 17196, 17198, 17199, 17201, 17202, 17213, 17214, 17216, 17217,
+    17219, 17220, 17222, 17223, 17225, 17226, 17228, 17229, 17238, 17240,
+    17241, 17243, 17244, 17246, 17247, 17249, 17250, 17252, 17253, 17255,
+    17264, 17265, 17267, 17268, 17276, 17277, 17279, 17280, 17291, 17292,
+    17294, 17295, 17297, 17298, 17300, 17301, 17303, 17304, 17306, 17307,
+    17316, 17318, 17319, 17321, 17322, 17324, 17325, 17327, 17328, 17330,
+    17331, 17333, 17342, 17343, 17345, 17346, 17354, 17355, 17357, 17358,
+};
+
+int axdb_get_num_unimodular_axes(void) {
+    return sizeof(unimodular_axes) / sizeof(unimodular_axes[0]);
+}
+
+/* Set the indices of relative_axes of the three columns of the index-th */
+/* unimodular candidate. */
+void axdb_get_unimodular_axes(int indices[3], int const index) {
+    indices[0] = unimodular_axes[index] / 676; /* = 26**2 */
+    indices[1] = (unimodular_axes[index] / 26) % 26;
+    indices[2] = unimodular_axes[index] % 26;
+}
+
+void axdb_get_relative_axis(int axis[3], int const index) {
+    axis[0] = relative_axes[index][0];
+    axis[1] = relative_axes[index][1];
+    axis[2] = relative_axes[index][2];
+}
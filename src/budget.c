@@ -0,0 +1,179 @@
+/* Copyright (C) 2008 Atsushi Togo */
+/* All rights reserved. */
+
+/* This file is part of spglib. */
+
+/* Redistribution and use in source and binary forms, with or without */
+/* modification, are permitted provided that the following conditions */
+/* are met: */
+
+/* * Redistributions of source code must retain the above copyright */
+/*   notice, this list of conditions and the following disclaimer. */
+
+/* * Redistributions in binary form must reproduce the above copyright */
+/*   notice, this list of conditions and the following disclaimer in */
+/*   the documentation and/or other materials provided with the */
+/*   distribution. */
+
+/* * Neither the name of the spglib project nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission. */
+
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE */
+/* COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, */
+/* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, */
+/* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; */
+/* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER */
+/* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT */
+/* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN */
+/* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
+/* POSSIBILITY OF SUCH DAMAGE. */
+
+
+#include "budget.h"
+
+#include <time.h>
+
+/* The clock is read only every this number of the overlap checks. */
+#define CLOCK_CHECK_INTERVAL 64
+
+/* deadline and max_overlap_checks of zero or less are unlimited. */
+struct WorkBudget {
+    double deadline;
+    long long max_overlap_checks;
+    long long num_overlap_checks;
+    int is_exceeded;
+};
+
+static thread_local double limit_seconds = 0;
+static thread_local long long limit_overlap_checks = 0;
+static thread_local WorkBudget own_budget = {0, 0, 0, 0};
+static thread_local WorkBudget *current_budget = NULL;
+static thread_local int depth = 0;
+
+static double get_time(void);
+static int get_exceeded(WorkBudget *budget);
+static void set_exceeded(WorkBudget *budget);
+
+/* The limits apply to the computations begun after this call. */
+void bdg_set_limits(double const max_seconds,
+                    long long const max_overlap_checks) {
+    limit_seconds = max_seconds;
+    limit_overlap_checks = max_overlap_checks;
+}
+
+void bdg_get_limits(double *max_seconds, long long *max_overlap_checks) {
+    *max_seconds = limit_seconds;
+    *max_overlap_checks = limit_overlap_checks;
+}
+
+/* Without the limits no budget is kept, and nothing is counted. */
+void bdg_begin(void) {
+    if (depth == 0 && (limit_seconds > 0 || limit_overlap_checks > 0)) {
+        own_budget.deadline =
+            limit_seconds > 0 ? get_time() + limit_seconds : 0;
+        own_budget.max_overlap_checks = limit_overlap_checks;
+        own_budget.num_overlap_checks = 0;
+        own_budget.is_exceeded = 0;
+        current_budget = &own_budget;
+    }
+    depth++;
+}
+
+/* The budget is used only by the outermost scope. */
+void bdg_begin_shared(WorkBudget *budget) {
+    if (depth == 0) {
+        current_budget = budget;
+    }
+    depth++;
+}
+
+void bdg_end(void) {
+    if (depth == 0) {
+        return;
+    }
+    depth--;
+    if (depth == 0) {
+        current_budget = NULL;
+    }
+}
+
+/* Return NULL if the work is unlimited. */
+WorkBudget *bdg_get_budget(void) { return current_budget; }
+
+/* Counts an operation checked against the atoms. */
+/* Return 0 if the budget is exceeded, otherwise 1. */
+int bdg_count_overlap_check(void) {
+    long long num_checks;
+
+    if (current_budget == NULL) {
+        return 1;
+    }
+
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+    num_checks = ++current_budget->num_overlap_checks;
+
+    if (current_budget->max_overlap_checks > 0 &&
+        num_checks > current_budget->max_overlap_checks) {
+        set_exceeded(current_budget);
+        return 0;
+    }
+    if (num_checks % CLOCK_CHECK_INTERVAL == 0) {
+        return !bdg_is_exceeded();
+    }
+    return !get_exceeded(current_budget);
+}
+
+/* Return 1 if the budget is exceeded, otherwise 0. */
+int bdg_is_exceeded(void) {
+    if (current_budget == NULL) {
+        return 0;
+    }
+    if (get_exceeded(current_budget)) {
+        return 1;
+    }
+    if (current_budget->deadline > 0 && get_time() > current_budget->deadline) {
+        set_exceeded(current_budget);
+        return 1;
+    }
+    return 0;
+}
+
+/* Return 1 if the budget was found to be exceeded, otherwise 0. */
+int bdg_has_exceeded(void) {
+    if (current_budget == NULL) {
+        return 0;
+    }
+    return get_exceeded(current_budget);
+}
+
+/* Wall-clock time in seconds. */
+static double get_time(void) {
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int get_exceeded(WorkBudget *budget) {
+    int is_exceeded;
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+    is_exceeded = budget->is_exceeded;
+
+    return is_exceeded;
+}
+
+static void set_exceeded(WorkBudget *budget) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+    budget->is_exceeded = 1;
+}
@@ -0,0 +1,65 @@
+/* Copyright (C) 2008 Atsushi Togo */
+/* All rights reserved. */
+
+/* This file is part of spglib. */
+
+/* Redistribution and use in source and binary forms, with or without */
+/* modification, are permitted provided that the following conditions */
+/* are met: */
+
+/* * Redistributions of source code must retain the above copyright */
+/*   notice, this list of conditions and the following disclaimer. */
+
+/* * Redistributions in binary form must reproduce the above copyright */
+/*   notice, this list of conditions and the following disclaimer in */
+/*   the documentation and/or other materials provided with the */
+/*   distribution. */
+
+/* * Neither the name of the spglib project nor the names of its */
+/*   contributors may be used to endorse or promote products derived */
+/*   from this software without specific prior written permission. */
+
+/* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS */
+/* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT */
+/* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS */
+/* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE */
+/* COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, */
+/* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, */
+/* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; */
+/* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER */
+/* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT */
+/* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN */
+/* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
+/* POSSIBILITY OF SUCH DAMAGE. */
+
+
+#ifndef __budget_H__
+#define __budget_H__
+
+#include "base.h"
+
+/* The work of a computation between bdg_begin and bdg_end of the */
+/* outermost scope is bounded by the limits set by bdg_set_limits on the */
+/* thread, i.e., its wall-clock time and the number of the operations */
+/* checked against the atoms. Once a limit is exceeded, bdg_is_exceeded */
+/* returns 1 until the end of the scope, and the loops of the search give */
+/* up. bdg_has_exceeded tells if so without reading the clock, with which */
+/* the results of the computation are discarded. A limit of zero or less */
+/* means unlimited, which is the default. */
+/* Threads working for the computation share its budget by */
+/* bdg_begin_shared with the budget obtained by bdg_get_budget. */
+typedef struct WorkBudget WorkBudget;
+
+SPG_API_TEST void bdg_set_limits(double const max_seconds,
+                                 long long const max_overlap_checks);
+SPG_API_TEST void bdg_get_limits(double *max_seconds,
+                                 long long *max_overlap_checks);
+SPG_API_TEST void bdg_begin(void);
+SPG_API_TEST void bdg_begin_shared(WorkBudget *budget);
+SPG_API_TEST void bdg_end(void);
+SPG_API_TEST WorkBudget *bdg_get_budget(void);
+SPG_API_TEST int bdg_count_overlap_check(void);
+SPG_API_TEST int bdg_is_exceeded(void);
+SPG_API_TEST int bdg_has_exceeded(void);
+
+#endif
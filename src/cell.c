@@ -38,12 +38,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "arena.h"
 #include "debug.h"
 #include "mathfunc.h"
 
 #define INCREASE_RATE 2.0
 #define REDUCE_RATE 0.95
 #define NUM_ATTEMPT 100
+/* Number of atoms copied at once into the structure-of-arrays buffers */
+/* of any_overlap. */
+#define OVERLAP_BLOCK_SIZE 256
+/* Cells of at least this number of atoms are checked by any_overlap_by_sweep */
+#define OVERLAP_SWEEP_MIN_SIZE 1024
+
+typedef struct {
+    double key;
+    int index;
+} KeyWithIndex;
 
 static Cell *trim_cell(int *mapping_table, double const trimmed_lattice[3][3],
                        Cell const *cell, double const symprec);
@@ -58,6 +69,19 @@ static VecDBL *translate_atoms_in_trimmed_lattice(Cell const *cell,
 static int *get_overlap_table(VecDBL const *position, int const cell_size,
                               int const *cell_types, Cell const *trimmed_cell,
                               double const symprec);
+static int any_overlap(Cell const *cell, int const is_periodic[3],
+                       int const is_same_type, double const symprec);
+static int any_overlap_in_all_pairs(Cell const *cell, int const is_periodic[3],
+                                    int const is_same_type,
+                                    double const symprec);
+static int any_overlap_by_sweep(Cell const *cell, int const is_periodic[3],
+                                int const is_same_type, double const symprec);
+static int count_overlaps(double const pos[3], int const type,
+                          double const x[], double const y[],
+                          double const z[], int const types[], int const n,
+                          double const lattice[3][3], double const wrap[3],
+                          double const symprec2);
+static int KeyWithIndex_comparator(void const *pa, void const *pb);
 
 // @brief Allocate Cell. NULL is returned if failed
 // @param size number of atoms
@@ -72,11 +96,12 @@ Cell *cel_alloc_cell(int const size, SiteTensorType const tensor_rank) {
         return NULL;
     }
 
-    if ((cell = (Cell *)malloc(sizeof(Cell))) == NULL) {
+    if ((cell = (Cell *)arn_malloc(sizeof(Cell))) == NULL) {
         goto fail;
     }
 
-    if ((cell->lattice = (double(*)[3])malloc(sizeof(double[3]) * 3)) == NULL) {
+    if ((cell->lattice = (double(*)[3])arn_malloc(sizeof(double[3]) * 3)) ==
+        NULL) {
         goto fail;
     }
 
@@ -84,10 +109,10 @@ Cell *cel_alloc_cell(int const size, SiteTensorType const tensor_rank) {
 
     cell->aperiodic_axis = -1;
 
-    if ((cell->types = (int *)malloc(sizeof(int) * size)) == NULL) {
+    if ((cell->types = (int *)arn_malloc(sizeof(int) * size)) == NULL) {
         goto fail;
     }
-    if ((cell->position = (double(*)[3])malloc(sizeof(double[3]) * size)) ==
+    if ((cell->position = (double(*)[3])arn_malloc(sizeof(double[3]) * size)) ==
         NULL) {
         goto fail;
     }
@@ -95,13 +120,14 @@ Cell *cel_alloc_cell(int const size, SiteTensorType const tensor_rank) {
     cell->tensor_rank = tensor_rank;
     if (tensor_rank == COLLINEAR) {
         // Collinear case
-        if ((cell->tensors = (double *)malloc(sizeof(double) * size)) == NULL) {
+        if ((cell->tensors = (double *)arn_malloc(sizeof(double) * size)) ==
+            NULL) {
             goto fail;
         }
     }
     if (tensor_rank == NONCOLLINEAR) {
         // Non-collinear case
-        if ((cell->tensors = (double *)malloc(sizeof(double) * size * 3)) ==
+        if ((cell->tensors = (double *)arn_malloc(sizeof(double) * size * 3)) ==
             NULL) {
             goto fail;
         }
@@ -119,24 +145,24 @@ fail:
 void cel_free_cell(Cell *cell) {
     if (cell != NULL) {
         if (cell->lattice != NULL) {
-            free(cell->lattice);
+            arn_free(cell->lattice);
             cell->lattice = NULL;
         }
         if (cell->position != NULL) {
-            free(cell->position);
+            arn_free(cell->position);
             cell->position = NULL;
         }
         if (cell->types != NULL) {
-            free(cell->types);
+            arn_free(cell->types);
             cell->types = NULL;
         }
         if ((cell->tensor_rank != NOSPIN) && (cell->tensors != NULL)) {
             // When cell->tensor_rank==NOSPIN, cell->tensors is already
             // NULL.
-            free(cell->tensors);
+            arn_free(cell->tensors);
             cell->tensors = NULL;
         }
-        free(cell);
+        arn_free(cell);
     }
 }
 
@@ -213,16 +239,14 @@ Cell *cel_copy_cell(Cell const *cell) {
 
 int cel_is_overlap(double const a[3], double const b[3],
                    double const lattice[3][3], double const symprec) {
-    int i;
+    double const wrap[3] = {1, 1, 1};
     double v_diff[3];
 
-    for (i = 0; i < 3; i++) {
-        v_diff[i] = a[i] - b[i];
-        v_diff[i] -= mat_Nint(v_diff[i]);
-    }
+    v_diff[0] = a[0] - b[0];
+    v_diff[1] = a[1] - b[1];
+    v_diff[2] = a[2] - b[2];
 
-    mat_multiply_matrix_vector_d3(v_diff, lattice, v_diff);
-    if (sqrt(mat_norm_squared_d3(v_diff)) < symprec) {
+    if (cel_get_distance2(lattice, v_diff, wrap) < symprec * symprec) {
         return 1;
     } else {
         return 0;
@@ -243,34 +267,17 @@ int cel_is_overlap_with_same_type(double const a[3], double const b[3],
 /* 1: At least one overlap of a pair of atoms was found. */
 /* 0: No overlap of atoms was found. */
 int cel_any_overlap(Cell const *cell, double const symprec) {
-    int i, j;
+    int const is_periodic[3] = {1, 1, 1};
 
-    for (i = 0; i < cell->size; i++) {
-        for (j = i + 1; j < cell->size; j++) {
-            if (cel_is_overlap(cell->position[i], cell->position[j],
-                               cell->lattice, symprec)) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return any_overlap(cell, is_periodic, 0, symprec);
 }
 
 /* 1: At least one overlap of a pair of atoms with same type was found. */
 /* 0: No overlap of atoms was found. */
 int cel_any_overlap_with_same_type(Cell const *cell, double const symprec) {
-    int i, j;
+    int const is_periodic[3] = {1, 1, 1};
 
-    for (i = 0; i < cell->size; i++) {
-        for (j = i + 1; j < cell->size; j++) {
-            if (cel_is_overlap_with_same_type(
-                    cell->position[i], cell->position[j], cell->types[i],
-                    cell->types[j], cell->lattice, symprec)) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return any_overlap(cell, is_periodic, 1, symprec);
 }
 
 /* Modified from cel_is_overlap */
@@ -278,17 +285,17 @@ int cel_any_overlap_with_same_type(Cell const *cell, double const symprec) {
 int cel_layer_is_overlap(double const a[3], double const b[3],
                          double const lattice[3][3], int const periodic_axes[2],
                          double const symprec) {
+    double wrap[3] = {0, 0, 0};
     double v_diff[3];
 
     v_diff[0] = a[0] - b[0];
     v_diff[1] = a[1] - b[1];
     v_diff[2] = a[2] - b[2];
 
-    v_diff[periodic_axes[0]] -= mat_Nint(v_diff[periodic_axes[0]]);
-    v_diff[periodic_axes[1]] -= mat_Nint(v_diff[periodic_axes[1]]);
+    wrap[periodic_axes[0]] = 1;
+    wrap[periodic_axes[1]] = 1;
 
-    mat_multiply_matrix_vector_d3(v_diff, lattice, v_diff);
-    if (sqrt(mat_norm_squared_d3(v_diff)) < symprec) {
+    if (cel_get_distance2(lattice, v_diff, wrap) < symprec * symprec) {
         return 1;
     } else {
         return 0;
@@ -312,18 +319,11 @@ int cel_layer_is_overlap_with_same_type(double const a[3], double const b[3],
 int cel_layer_any_overlap_with_same_type(Cell const *cell,
                                          int const periodic_axes[2],
                                          double const symprec) {
-    int i, j;
+    int is_periodic[3] = {0, 0, 0};
 
-    for (i = 0; i < cell->size; i++) {
-        for (j = i + 1; j < cell->size; j++) {
-            if (cel_layer_is_overlap_with_same_type(
-                    cell->position[i], cell->position[j], cell->types[i],
-                    cell->types[j], cell->lattice, periodic_axes, symprec)) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    is_periodic[periodic_axes[0]] = 1;
+    is_periodic[periodic_axes[1]] = 1;
+    return any_overlap(cell, is_periodic, 1, symprec);
 }
 
 /// @param[out] mapping_table array (`cell->size`, ), maps atom-`i` in `cell` to
@@ -417,7 +417,7 @@ static Cell *trim_cell(int *mapping_table, double const trimmed_lattice[3][3],
 
     mat_free_VecDBL(position);
     position = NULL;
-    free(overlap_table);
+    arn_free(overlap_table);
 
     return trimmed_cell;
 
@@ -557,7 +557,7 @@ static int *get_overlap_table(VecDBL const *position, int const cell_size,
 
     ratio = cell_size / trimmed_cell->size;
 
-    if ((overlap_table = (int *)malloc(sizeof(int) * cell_size)) == NULL) {
+    if ((overlap_table = (int *)arn_malloc(sizeof(int) * cell_size)) == NULL) {
         return NULL;
     }
 
@@ -620,9 +620,210 @@ static int *get_overlap_table(VecDBL const *position, int const cell_size,
     }
 
     info_print("spglib: Could not trim cell well\n");
-    free(overlap_table);
+    arn_free(overlap_table);
     overlap_table = NULL;
 
 found:
     return overlap_table;
 }
+
+/* Tests pairs of atoms for overlaps, in the same way as cel_is_overlap */
+/* and cel_layer_is_overlap. Large cells are swept along one axis so */
+/* that only nearby pairs are tested. */
+/* 1: At least one overlap was found.  0: No overlap was found. */
+static int any_overlap(Cell const *cell, int const is_periodic[3],
+                       int const is_same_type, double const symprec) {
+    int result;
+
+    if (cell->size >= OVERLAP_SWEEP_MIN_SIZE) {
+        result = any_overlap_by_sweep(cell, is_periodic, is_same_type, symprec);
+        if (result != -1) {
+            return result;
+        }
+    }
+    return any_overlap_in_all_pairs(cell, is_periodic, is_same_type, symprec);
+}
+
+/* Tests all pairs of atoms. The positions of a block of atoms are copied */
+/* into structure-of-arrays buffers. */
+/* 1: At least one overlap was found.  0: No overlap was found. */
+static int any_overlap_in_all_pairs(Cell const *cell, int const is_periodic[3],
+                                    int const is_same_type,
+                                    double const symprec) {
+    int i, j, k, j_start, j_end, num_block, type_i;
+    double wrap[3];
+    double pos[3][OVERLAP_BLOCK_SIZE];
+    int types[OVERLAP_BLOCK_SIZE];
+
+    for (k = 0; k < 3; k++) {
+        wrap[k] = is_periodic[k] ? 1 : 0;
+    }
+
+    for (j_start = 1; j_start < cell->size; j_start += OVERLAP_BLOCK_SIZE) {
+        j_end = j_start + OVERLAP_BLOCK_SIZE < cell->size
+                    ? j_start + OVERLAP_BLOCK_SIZE
+                    : cell->size;
+        num_block = j_end - j_start;
+        for (j = 0; j < num_block; j++) {
+            for (k = 0; k < 3; k++) {
+                pos[k][j] = cell->position[j_start + j][k];
+            }
+            types[j] = is_same_type ? cell->types[j_start + j] : 0;
+        }
+
+        /* Pairs of atom i and atoms j > i in the block */
+        for (i = 0; i < j_end - 1; i++) {
+            type_i = is_same_type ? cell->types[i] : 0;
+            j = i + 1 > j_start ? i + 1 - j_start : 0;
+            if (count_overlaps(cell->position[i], type_i, pos[0] + j,
+                               pos[1] + j, pos[2] + j, types + j,
+                               num_block - j, cell->lattice, wrap,
+                               symprec * symprec)) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Sorts the atoms by the fractional coordinate along one axis. Atoms */
+/* closer than symprec are closer than symprec * |reciprocal basis */
+/* vector| along the axis (modulo 1), so only the atoms in this window */
+/* are tested with each atom. */
+/* 1: At least one overlap was found.  0: No overlap was found. */
+/* -1: The window is too wide or memory could not be allocated. */
+static int any_overlap_by_sweep(Cell const *cell, int const is_periodic[3],
+                                int const is_same_type, double const symprec) {
+    int i, k, axis, end, wrap_end, type_i, result;
+    double width, norm;
+    double wrap[3], inv_lattice[3][3];
+    double *pos[3];
+    int *types;
+    KeyWithIndex *keys;
+
+    pos[0] = NULL;
+    types = NULL;
+    keys = NULL;
+    result = -1;
+
+    if (!mat_inverse_matrix_d3(inv_lattice, cell->lattice, 0)) {
+        return -1;
+    }
+
+    /* The periodic axis with the narrowest window. The width is doubled */
+    /* to absorb rounding errors. */
+    axis = -1;
+    width = 0;
+    for (k = 0; k < 3; k++) {
+        wrap[k] = is_periodic[k] ? 1 : 0;
+        if (!is_periodic[k]) {
+            continue;
+        }
+        norm = sqrt(inv_lattice[k][0] * inv_lattice[k][0] +
+                    inv_lattice[k][1] * inv_lattice[k][1] +
+                    inv_lattice[k][2] * inv_lattice[k][2]);
+        if (axis == -1 || 2 * symprec * norm < width) {
+            axis = k;
+            width = 2 * symprec * norm;
+        }
+    }
+    if (axis == -1 || width > 0.25) {
+        return -1;
+    }
+
+    if ((keys =
+             (KeyWithIndex *)arn_malloc(sizeof(KeyWithIndex) * cell->size)) ==
+        NULL) {
+        warning_memory("keys");
+        goto ret;
+    }
+    if ((pos[0] = (double *)arn_malloc(sizeof(double) * cell->size * 3)) ==
+        NULL) {
+        warning_memory("pos");
+        goto ret;
+    }
+    pos[1] = pos[0] + cell->size;
+    pos[2] = pos[1] + cell->size;
+    if ((types = (int *)arn_malloc(sizeof(int) * cell->size)) == NULL) {
+        warning_memory("types");
+        goto ret;
+    }
+
+    for (i = 0; i < cell->size; i++) {
+        keys[i].key =
+            cell->position[i][axis] - floor(cell->position[i][axis]);
+        keys[i].index = i;
+    }
+    qsort(keys, cell->size, sizeof(KeyWithIndex), KeyWithIndex_comparator);
+    for (i = 0; i < cell->size; i++) {
+        for (k = 0; k < 3; k++) {
+            pos[k][i] = cell->position[keys[i].index][k];
+        }
+        types[i] = is_same_type ? cell->types[keys[i].index] : 0;
+    }
+
+    result = 0;
+    end = 0;
+    wrap_end = 0;
+    for (i = 0; i < cell->size; i++) {
+        type_i = types[i];
+        while (end < cell->size && keys[end].key <= keys[i].key + width) {
+            end++;
+        }
+        /* Atoms in the window across the boundary at 1 */
+        while (wrap_end < i && keys[wrap_end].key + 1 <= keys[i].key + width) {
+            wrap_end++;
+        }
+        if (count_overlaps(cell->position[keys[i].index], type_i,
+                           pos[0] + i + 1, pos[1] + i + 1, pos[2] + i + 1,
+                           types + i + 1, end - i - 1, cell->lattice, wrap,
+                           symprec * symprec) ||
+            count_overlaps(cell->position[keys[i].index], type_i, pos[0],
+                           pos[1], pos[2], types, wrap_end, cell->lattice,
+                           wrap, symprec * symprec)) {
+            result = 1;
+            break;
+        }
+    }
+
+ret:
+    arn_free(keys);
+    keys = NULL;
+    arn_free(pos[0]);
+    pos[0] = NULL;
+    arn_free(types);
+    types = NULL;
+    return result;
+}
+
+/* Number of atoms of 'type' (x[j], y[j], z[j]) overlapping with 'pos', */
+/* counted without branches, so that compilers can vectorize the loop. */
+/* wrap[k] = 0 disables the periodic boundary condition along axis k. */
+static int count_overlaps(double const pos[3], int const type,
+                          double const x[], double const y[],
+                          double const z[], int const types[], int const n,
+                          double const lattice[3][3], double const wrap[3],
+                          double const symprec2) {
+    int j, num_overlaps;
+    double diff[3];
+
+    num_overlaps = 0;
+    for (j = 0; j < n; j++) {
+        diff[0] = pos[0] - x[j];
+        diff[1] = pos[1] - y[j];
+        diff[2] = pos[2] - z[j];
+        num_overlaps += (cel_get_distance2(lattice, diff, wrap) < symprec2) &
+                        (types[j] == type);
+    }
+
+    return num_overlaps;
+}
+
+static int KeyWithIndex_comparator(void const *pa, void const *pb) {
+    double a, b;
+
+    a = ((KeyWithIndex const *)pa)->key;
+    b = ((KeyWithIndex const *)pb)->key;
+    return (b < a) - (a < b);
+}
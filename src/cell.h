@@ -35,6 +35,8 @@
 #ifndef __cell_H__
 #define __cell_H__
 
+#include <math.h>
+
 #include "mathfunc.h"
 
 typedef enum {
@@ -63,11 +65,30 @@ typedef struct {
     double *tensors;
 } Cell;
 
+/* Squared Cartesian length of the minimum image of the difference 'diff' */
+/* of fractional coordinates. wrap[k] = 0 disables the periodic boundary */
+/* condition along axis k. Written without branches, so that compilers can */
+/* vectorize the loops of the overlap checks in cell.c and overlap.c. */
+static inline double cel_get_distance2(double const lattice[3][3],
+                                       double const diff[3],
+                                       double const wrap[3]) {
+    double d[3], x, y, z;
+
+    d[0] = diff[0] - wrap[0] * (int)(diff[0] + copysign(0.5, diff[0]));
+    d[1] = diff[1] - wrap[1] * (int)(diff[1] + copysign(0.5, diff[1]));
+    d[2] = diff[2] - wrap[2] * (int)(diff[2] + copysign(0.5, diff[2]));
+    x = lattice[0][0] * d[0] + lattice[0][1] * d[1] + lattice[0][2] * d[2];
+    y = lattice[1][0] * d[0] + lattice[1][1] * d[1] + lattice[1][2] * d[2];
+    z = lattice[2][0] * d[0] + lattice[2][1] * d[1] + lattice[2][2] * d[2];
+
+    return x * x + y * y + z * z;
+}
+
 SPG_API_TEST Cell *cel_alloc_cell(int const size,
                                   SiteTensorType const tensor_rank);
 SPG_API_TEST void cel_free_cell(Cell *cell);
-void cel_set_cell(Cell *cell, double const lattice[3][3],
-                  double const position[][3], int const types[]);
+SPG_API_TEST void cel_set_cell(Cell *cell, double const lattice[3][3],
+                               double const position[][3], int const types[]);
 SPG_API_TEST void cel_set_layer_cell(Cell *cell, double const lattice[3][3],
                                      double const position[][3],
                                      int const types[],
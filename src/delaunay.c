@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "budget.h"
 #include "debug.h"
 #include "mathfunc.h"
 
@@ -114,6 +115,9 @@ static int delaunay_reduce(double red_lattice[3][3], double const lattice[3][3],
 
     for (int attempt = 0, max_attempt = get_num_attempts();
          attempt < max_attempt; attempt++) {
+        if (bdg_is_exceeded()) {
+            break;
+        }
         debug_print("Trying delaunay_reduce_basis: attempt %d/%d\n", attempt,
                     get_num_attempts());
         succeeded = delaunay_reduce_basis(basis, lattice_rank, symprec);
@@ -407,6 +411,9 @@ int del_layer_delaunay_reduce_2D(double red_lattice[3][3],
 
     for (int attempt = 0, max_attempt = get_num_attempts();
          attempt < max_attempt; attempt++) {
+        if (bdg_is_exceeded()) {
+            break;
+        }
         debug_print("Trying delaunay_reduce_basis_2D: attempt %d/%d\n", attempt,
                     get_num_attempts());
         succeeded = delaunay_reduce_basis_2D(basis, lattice_rank, symprec);
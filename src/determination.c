@@ -34,13 +34,21 @@
 
 #include "determination.h"
 
+#include <limits.h>
 #include <stdlib.h>
 
+#include "arena.h"
+#include "budget.h"
 #include "cell.h"
 #include "debug.h"
 #include "primitive.h"
 #include "refinement.h"
 #include "spacegroup.h"
+#include "symmetry.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define REDUCE_RATE_OUTER 0.9
 #define NUM_ATTEMPT_OUTER 10
@@ -48,51 +56,173 @@
 #define ANGLE_REDUCE_RATE 0.95
 #define NUM_ATTEMPT 20
 
-static DataContainer *get_spacegroup_and_primitive(Cell const *cell,
+static DataContainer *determine_all(SearchContext *context,
+                                    int const hall_number,
+                                    RefineLevel const level,
+                                    double const symprec,
+                                    double const angle_symprec);
+#ifdef _OPENMP
+static DataContainer *determine_all_in_parallel(
+    Cell const *cell, int const hall_number, RefineLevel const level,
+    double const symprec, double const angle_symprec, int const num_threads);
+static int get_num_tolerance_threads(void);
+#endif
+static DataContainer *determine_at_tolerance_step(
+    SearchContext *context, int const hall_number, RefineLevel const level,
+    double const tolerance, double const angle_symprec, int const *cancelled);
+static int is_cancelled(int const *cancelled);
+static int determine_at_tolerance(int spacegroup_numbers[], int hall_numbers[],
+                                  int n_operations[], SearchContext *context,
+                                  double const symprecs[], int const index,
+                                  double const angle_symprec);
+static DataContainer *get_spacegroup_and_primitive(SearchContext *context,
                                                    int const hall_number,
                                                    double const symprec,
-                                                   double const angle_symprec);
+                                                   double const angle_symprec,
+                                                   int const *cancelled);
+static DataContainer *determine_with_hall_number(SearchContext *context,
+                                                 Symmetry const *symmetry,
+                                                 int const hall_number,
+                                                 double const symprec,
+                                                 double const angle_symprec);
+static int is_primitive_symmetry(Primitive const *primitive,
+                                 Symmetry const *symmetry,
+                                 double const symprec);
+static int is_symmetry_gained(Primitive const *primitive,
+                              Symmetry const *symmetry, double const symprec,
+                              double const angle_symprec);
 
+/* Only the parts of the exact structure up to level are kept. */
 DataContainer *det_determine_all(Cell const *cell, int const hall_number,
-                                 double const symprec,
+                                 RefineLevel const level, double const symprec,
                                  double const angle_symprec) {
-    int attempt;
-    double tolerance;
     DataContainer *container;
+    SearchContext *context;
 
     container = NULL;
+    context = NULL;
 
     if (hall_number > 530) {
         return NULL;
     }
 
-    tolerance = symprec;
-    for (attempt = 0; attempt < NUM_ATTEMPT_OUTER; attempt++) {
-        if ((container = get_spacegroup_and_primitive(
-                 cell, hall_number, tolerance, angle_symprec)) != NULL) {
-            if ((container->exact_structure =
-                     ref_get_exact_structure_and_symmetry(
-                         container->spacegroup, container->primitive->cell,
-                         cell, container->primitive->mapping_table,
-                         container->primitive->tolerance)) != NULL) {
-                goto found;
-            }
-            debug_print(
-                "spglib: ref_get_exact_structure_and_symmetry failed.\n");
-            det_free_container(container);
-            container = NULL;
+    /* The search context of the input cell is shared by all attempts. */
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
+        return NULL;
+    }
+
+    container =
+        determine_all(context, hall_number, level, symprec, angle_symprec);
+
+    sym_free_search_context(context);
+    context = NULL;
+    return container;
+}
+
+/* The cell is expected to keep the operations of symmetry, e.g., those */
+/* of the previous step of a trajectory, and the space-group type of */
+/* hall_number. This is confirmed in the primitive cell, where it is */
+/* cheaper than in the cell, and by searching only hall_number at symprec */
+/* without reducing the tolerance. The result is accepted when the number */
+/* of operations of the primitive cell at symprec and that of the result */
+/* are unchanged, and otherwise the space group is searched from scratch */
+/* with the same search context. */
+/* NULL is returned if failed */
+DataContainer *det_update_all(Cell const *cell, Symmetry const *symmetry,
+                              int const hall_number, double const symprec,
+                              double const angle_symprec) {
+    DataContainer *container;
+    SearchContext *context;
+
+    container = NULL;
+    context = NULL;
+
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
+        return NULL;
+    }
+
+    if (hall_number > 0 && hall_number <= 530 &&
+        (container = determine_with_hall_number(context, symmetry, hall_number,
+                                                symprec, angle_symprec)) !=
+            NULL) {
+        if (container->exact_structure->symmetry->size == symmetry->size) {
+            goto ret;
         }
-        tolerance *= REDUCE_RATE_OUTER;
+        det_free_container(container);
+        container = NULL;
     }
 
-found:
+    debug_print("spglib: Symmetry changed. Search it from scratch.\n");
+    container =
+        determine_all(context, 0, REFINE_POSITIONS, symprec, angle_symprec);
+
+ret:
+    sym_free_search_context(context);
+    context = NULL;
     return container;
 }
 
+/* Space group type and number of symmetry operations of the cell are */
+/* determined for each of the tolerances symprecs. 0 is set where the */
+/* search failed. The result is not monotonic in the tolerance, so every */
+/* tolerance is searched. They are searched from the largest one with one */
+/* search context, where the lattice symmetry found at a larger tolerance */
+/* is reused at the smaller ones. */
+/* Return the number of tolerances at which the space group was found, */
+/* or -1 if failed. */
+int det_scan_tolerances(int spacegroup_numbers[], int hall_numbers[],
+                        int n_operations[], Cell const *cell,
+                        double const symprecs[], int const num_symprec,
+                        double const angle_symprec) {
+    int i, j, num_found;
+    int *order;
+    SearchContext *context;
+
+    order = NULL;
+    context = NULL;
+
+    if (num_symprec < 1) {
+        return 0;
+    }
+
+    if ((order = (int *)arn_malloc(sizeof(int) * num_symprec)) == NULL) {
+        warning_memory("order");
+        return -1;
+    }
+
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
+        arn_free(order);
+        order = NULL;
+        return -1;
+    }
+
+    /* Indices of symprecs in descending order */
+    for (i = 0; i < num_symprec; i++) {
+        for (j = i; j > 0 && symprecs[order[j - 1]] < symprecs[i]; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+
+    num_found = 0;
+    for (i = 0; i < num_symprec; i++) {
+        num_found += determine_at_tolerance(spacegroup_numbers, hall_numbers,
+                                            n_operations, context, symprecs,
+                                            order[i], angle_symprec);
+    }
+
+    sym_free_search_context(context);
+    context = NULL;
+    arn_free(order);
+    order = NULL;
+
+    return num_found;
+}
+
 void det_free_container(DataContainer *container) {
     if (container != NULL) {
         if (container->spacegroup != NULL) {
-            free(container->spacegroup);
+            arn_free(container->spacegroup);
             container->spacegroup = NULL;
         }
         if (container->primitive != NULL) {
@@ -103,15 +233,222 @@ void det_free_container(DataContainer *container) {
             ref_free_exact_structure(container->exact_structure);
             container->exact_structure = NULL;
         }
-        free(container);
+        arn_free(container);
     }
 }
 
 /* NULL is returned if failed */
-static DataContainer *get_spacegroup_and_primitive(Cell const *cell,
+static DataContainer *determine_all(SearchContext *context,
+                                    int const hall_number,
+                                    RefineLevel const level,
+                                    double const symprec,
+                                    double const angle_symprec) {
+    int attempt;
+    double tolerance;
+    DataContainer *container;
+#ifdef _OPENMP
+    int num_threads;
+
+    /* Cells of spg_get_datasets are already processed in parallel. */
+    num_threads = omp_in_parallel() ? 1 : get_num_tolerance_threads();
+    if (num_threads > 1) {
+        return determine_all_in_parallel(context->cell, hall_number, level,
+                                         symprec, angle_symprec, num_threads);
+    }
+#endif
+
+    container = NULL;
+
+    tolerance = symprec;
+    for (attempt = 0; attempt < NUM_ATTEMPT_OUTER; attempt++) {
+        if (bdg_is_exceeded()) {
+            break;
+        }
+        if ((container = determine_at_tolerance_step(
+                 context, hall_number, level, tolerance, angle_symprec,
+                 NULL)) != NULL) {
+            break;
+        }
+        tolerance *= REDUCE_RATE_OUTER;
+    }
+
+    return container;
+}
+
+#ifdef _OPENMP
+/* The steps of the tolerance of determine_all are searched concurrently */
+/* by num_threads threads with their own search contexts. The container of */
+/* the largest tolerance found is returned as by the serial loop, and the */
+/* searches at the smaller tolerances are cancelled once it is found. */
+/* NULL is returned if failed */
+static DataContainer *determine_all_in_parallel(
+    Cell const *cell, int const hall_number, RefineLevel const level,
+    double const symprec, double const angle_symprec, int const num_threads) {
+    int i, attempt, found;
+    int cancelled[NUM_ATTEMPT_OUTER], is_failed[NUM_ATTEMPT_OUTER];
+    double tolerances[NUM_ATTEMPT_OUTER];
+    DataContainer *container;
+    DataContainer *containers[NUM_ATTEMPT_OUTER];
+    SearchContext *context;
+    WorkBudget *budget;
+
+    container = NULL;
+    budget = bdg_get_budget();
+
+    for (attempt = 0; attempt < NUM_ATTEMPT_OUTER; attempt++) {
+        tolerances[attempt] = attempt == 0
+                                  ? symprec
+                                  : tolerances[attempt - 1] * REDUCE_RATE_OUTER;
+        cancelled[attempt] = 0;
+        is_failed[attempt] = 0;
+        containers[attempt] = NULL;
+    }
+
+#pragma omp parallel for schedule(dynamic) private(i, context) \
+    num_threads(num_threads)
+    for (attempt = 0; attempt < NUM_ATTEMPT_OUTER; attempt++) {
+        if (is_cancelled(&cancelled[attempt])) {
+            continue;
+        }
+        if ((context = sym_alloc_search_context(cell)) == NULL) {
+            is_failed[attempt] = 1;
+            continue;
+        }
+        bdg_begin_shared(budget);
+        containers[attempt] = determine_at_tolerance_step(
+            context, hall_number, level, tolerances[attempt], angle_symprec,
+            &cancelled[attempt]);
+        bdg_end();
+        sym_free_search_context(context);
+        context = NULL;
+        if (containers[attempt] != NULL) {
+            for (i = attempt + 1; i < NUM_ATTEMPT_OUTER; i++) {
+#pragma omp atomic write
+                cancelled[i] = 1;
+            }
+        }
+    }
+
+    /* As in the serial loop, no container is returned if a step before */
+    /* the first one found could not be searched. */
+    found = NUM_ATTEMPT_OUTER;
+    for (attempt = 0; attempt < NUM_ATTEMPT_OUTER; attempt++) {
+        if (is_failed[attempt] || containers[attempt] != NULL) {
+            found = attempt;
+            break;
+        }
+    }
+    for (attempt = 0; attempt < NUM_ATTEMPT_OUTER; attempt++) {
+        if (attempt == found) {
+            container = containers[attempt];
+        } else {
+            det_free_container(containers[attempt]);
+        }
+        containers[attempt] = NULL;
+    }
+
+    return container;
+}
+
+/* Number of the steps of the tolerance searched concurrently, which is */
+/* set by SPGLIB_TOLERANCE_THREADS. They are searched serially by default. */
+static int get_num_tolerance_threads(void) {
+    char const *num_threads_str;
+    char *end;
+    long num_threads;
+
+    if ((num_threads_str = getenv("SPGLIB_TOLERANCE_THREADS")) == NULL) {
+        return 1;
+    }
+
+    num_threads = strtol(num_threads_str, &end, 10);
+    if (end == num_threads_str || *end != '\0' || num_threads < 1 ||
+        num_threads > INT_MAX) {
+        warning_print("spglib: Could not parse SPGLIB_TOLERANCE_THREADS=%s\n",
+                      num_threads_str);
+        return 1;
+    }
+    if (num_threads > NUM_ATTEMPT_OUTER) {
+        num_threads = NUM_ATTEMPT_OUTER;
+    }
+
+    return (int)num_threads;
+}
+#endif
+
+/* One step of the tolerance of determine_all. cancelled is NULL when */
+/* the steps are searched serially. */
+/* NULL is returned if failed */
+static DataContainer *determine_at_tolerance_step(
+    SearchContext *context, int const hall_number, RefineLevel const level,
+    double const tolerance, double const angle_symprec, int const *cancelled) {
+    DataContainer *container;
+
+    if ((container = get_spacegroup_and_primitive(
+             context, hall_number, tolerance, angle_symprec, cancelled)) ==
+        NULL) {
+        return NULL;
+    }
+
+    if ((container->exact_structure = ref_get_exact_structure_and_symmetry(
+             container->spacegroup, container->primitive->cell, context->cell,
+             container->primitive->mapping_table, level,
+             container->primitive->tolerance)) == NULL) {
+        debug_print("spglib: ref_get_exact_structure_and_symmetry failed.\n");
+        det_free_container(container);
+        container = NULL;
+    }
+
+    return container;
+}
+
+/* Return 1 if the search at a smaller tolerance is no longer needed. */
+static int is_cancelled(int const *cancelled) {
+    int value;
+
+    if (cancelled == NULL) {
+        return 0;
+    }
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+    value = *cancelled;
+
+    return value;
+}
+
+/* Return 1 if the space group was found at symprecs[index], otherwise 0. */
+static int determine_at_tolerance(int spacegroup_numbers[], int hall_numbers[],
+                                  int n_operations[], SearchContext *context,
+                                  double const symprecs[], int const index,
+                                  double const angle_symprec) {
+    DataContainer *container;
+
+    spacegroup_numbers[index] = 0;
+    hall_numbers[index] = 0;
+    n_operations[index] = 0;
+
+    if ((container = determine_all(context, 0, REFINE_POSITIONS,
+                                   symprecs[index], angle_symprec)) == NULL) {
+        return 0;
+    }
+
+    spacegroup_numbers[index] = container->spacegroup->number;
+    hall_numbers[index] = container->spacegroup->hall_number;
+    n_operations[index] = container->exact_structure->symmetry->size;
+    det_free_container(container);
+    container = NULL;
+
+    return 1;
+}
+
+/* NULL is returned if failed */
+static DataContainer *get_spacegroup_and_primitive(SearchContext *context,
                                                    int const hall_number,
                                                    double const symprec,
-                                                   double const angle_symprec) {
+                                                   double const angle_symprec,
+                                                   int const *cancelled) {
     int attempt;
     double tolerance, angle_tolerance;
     DataContainer *container;
@@ -120,7 +457,8 @@ static DataContainer *get_spacegroup_and_primitive(Cell const *cell,
 
     container = NULL;
 
-    if ((container = (DataContainer *)malloc(sizeof(DataContainer))) == NULL) {
+    if ((container = (DataContainer *)arn_malloc(sizeof(DataContainer))) ==
+        NULL) {
         warning_memory("container");
         return NULL;
     }
@@ -133,16 +471,28 @@ static DataContainer *get_spacegroup_and_primitive(Cell const *cell,
     angle_tolerance = angle_symprec;
 
     for (attempt = 0; attempt < NUM_ATTEMPT; attempt++) {
-        if ((container->primitive =
-                 prm_get_primitive(cell, tolerance, angle_tolerance)) != NULL) {
+        if (is_cancelled(cancelled) || bdg_is_exceeded()) {
+            break;
+        }
+        if ((container->primitive = prm_get_primitive(
+                 context, tolerance, angle_tolerance)) != NULL) {
             debug_print("primitive lattice\n");
             debug_print_matrix_d3(container->primitive->cell->lattice);
 
-            if ((container->spacegroup = spa_search_spacegroup(
-                     container->primitive, hall_number,
-                     container->primitive->tolerance,
-                     container->primitive->angle_tolerance)) != NULL) {
-                goto found;
+            /* The primitive cell is determined by its tolerances. If the */
+            /* space group was not found for it before, it is not tried. */
+            if (!sym_has_failed(context, SEARCH_STEP_SPACEGROUP,
+                                container->primitive->tolerance,
+                                container->primitive->angle_tolerance)) {
+                if ((container->spacegroup = spa_search_spacegroup(
+                         container->primitive, hall_number,
+                         container->primitive->tolerance,
+                         container->primitive->angle_tolerance)) != NULL) {
+                    goto found;
+                }
+                sym_set_failed(context, SEARCH_STEP_SPACEGROUP,
+                               container->primitive->tolerance,
+                               container->primitive->angle_tolerance);
             }
 
             prm_free_primitive(container->primitive);
@@ -166,3 +516,173 @@ static DataContainer *get_spacegroup_and_primitive(Cell const *cell,
 found:
     return container;
 }
+
+/* Only one attempt at symprec is made. */
+/* NULL is returned if failed */
+static DataContainer *determine_with_hall_number(SearchContext *context,
+                                                 Symmetry const *symmetry,
+                                                 int const hall_number,
+                                                 double const symprec,
+                                                 double const angle_symprec) {
+    DataContainer *container;
+
+    container = NULL;
+
+    if ((container = (DataContainer *)arn_malloc(sizeof(DataContainer))) ==
+        NULL) {
+        warning_memory("container");
+        return NULL;
+    }
+
+    container->primitive = NULL;
+    container->spacegroup = NULL;
+    container->exact_structure = NULL;
+
+    if ((container->primitive =
+             prm_get_primitive(context, symprec, angle_symprec)) == NULL) {
+        goto err;
+    }
+    /* The primitive cell was found at a reduced tolerance. */
+    if (container->primitive->tolerance != symprec) {
+        goto err;
+    }
+    if (!is_primitive_symmetry(container->primitive, symmetry, symprec)) {
+        goto err;
+    }
+    /* spa_search_spacegroup reduces the tolerance until the operations */
+    /* match hall_number, so that a symmetry gained at symprec would be */
+    /* dropped silently. */
+    if (is_symmetry_gained(container->primitive, symmetry, symprec,
+                           angle_symprec)) {
+        goto err;
+    }
+    if ((container->spacegroup = spa_search_spacegroup(
+             container->primitive, hall_number, symprec, angle_symprec)) ==
+        NULL) {
+        goto err;
+    }
+    if ((container->exact_structure = ref_get_exact_structure_and_symmetry(
+             container->spacegroup, container->primitive->cell, context->cell,
+             container->primitive->mapping_table, REFINE_POSITIONS,
+             symprec)) == NULL) {
+        goto err;
+    }
+
+    return container;
+
+err:
+    det_free_container(container);
+    container = NULL;
+    return NULL;
+}
+
+/* The operations of symmetry of the cell are transformed to the basis of */
+/* the primitive cell, whose origin is the same, and checked there. Only */
+/* one operation per rotation is checked since the others differ from it */
+/* by the pure translations, which the primitive cell already reflects. */
+/* Return 1 if all of them hold, otherwise 0. */
+static int is_primitive_symmetry(Primitive const *primitive,
+                                 Symmetry const *symmetry,
+                                 double const symprec) {
+    int i, j, num_rot, is_kept;
+    double inv_tmat[3][3], tmat[3][3], rot[3][3];
+    Symmetry *prim_symmetry;
+    SearchContext *prim_context;
+
+    prim_symmetry = NULL;
+    prim_context = NULL;
+    is_kept = 0;
+
+    /* (a_p, b_p, c_p) = (a, b, c) tmat and x_p = tmat^-1 x */
+    if (!mat_inverse_matrix_d3(inv_tmat, primitive->cell->lattice, 0)) {
+        return 0;
+    }
+    mat_multiply_matrix_d3(inv_tmat, inv_tmat, primitive->orig_lattice);
+    if (!mat_inverse_matrix_d3(tmat, inv_tmat, 0)) {
+        return 0;
+    }
+
+    if ((prim_symmetry = sym_alloc_symmetry(symmetry->size)) == NULL) {
+        return 0;
+    }
+
+    num_rot = 0;
+    for (i = 0; i < symmetry->size; i++) {
+        for (j = 0; j < i; j++) {
+            if (mat_check_identity_matrix_i3(symmetry->rot[i],
+                                             symmetry->rot[j])) {
+                break;
+            }
+        }
+        if (j < i) {
+            continue;
+        }
+
+        mat_multiply_matrix_id3(rot, symmetry->rot[i], tmat);
+        mat_multiply_matrix_d3(rot, inv_tmat, rot);
+        if (!mat_is_int_matrix(rot, symprec)) {
+            goto ret;
+        }
+        mat_cast_matrix_3d_to_3i(prim_symmetry->rot[num_rot], rot);
+        mat_multiply_matrix_vector_d3(prim_symmetry->trans[num_rot], inv_tmat,
+                                      symmetry->trans[i]);
+        num_rot++;
+    }
+    prim_symmetry->size = num_rot;
+
+    if ((prim_context = sym_alloc_search_context(primitive->cell)) == NULL) {
+        goto ret;
+    }
+    is_kept = (sym_check_operations(prim_context, prim_symmetry, symprec) == 1);
+    sym_free_search_context(prim_context);
+    prim_context = NULL;
+
+ret:
+    sym_free_symmetry(prim_symmetry);
+    prim_symmetry = NULL;
+    return is_kept;
+}
+
+/* The number of operations of the primitive cell at symprec is compared */
+/* with the number of rotations of symmetry, which is that of the */
+/* operations of symmetry in the primitive cell. */
+/* Return 1 if it is larger or if the operations are not found, */
+/* otherwise 0. */
+static int is_symmetry_gained(Primitive const *primitive,
+                              Symmetry const *symmetry, double const symprec,
+                              double const angle_symprec) {
+    int i, j, num_rot, is_gained;
+    Symmetry *prim_symmetry;
+    SearchContext *prim_context;
+
+    prim_symmetry = NULL;
+    prim_context = NULL;
+    is_gained = 1;
+
+    num_rot = 0;
+    for (i = 0; i < symmetry->size; i++) {
+        for (j = 0; j < i; j++) {
+            if (mat_check_identity_matrix_i3(symmetry->rot[i],
+                                             symmetry->rot[j])) {
+                break;
+            }
+        }
+        if (j == i) {
+            num_rot++;
+        }
+    }
+
+    if ((prim_context = sym_alloc_search_context(primitive->cell)) == NULL) {
+        return 1;
+    }
+    if ((prim_symmetry = sym_get_operation(prim_context, symprec,
+                                           angle_symprec)) != NULL) {
+        is_gained = (prim_symmetry->size > num_rot);
+        sym_free_symmetry(prim_symmetry);
+        prim_symmetry = NULL;
+    }
+    sym_free_search_context(prim_context);
+    prim_context = NULL;
+
+    return is_gained;
+}
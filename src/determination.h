@@ -39,6 +39,7 @@
 #include "primitive.h"
 #include "refinement.h"
 #include "spacegroup.h"
+#include "symmetry.h"
 
 typedef struct {
     Primitive *primitive;
@@ -47,8 +48,15 @@ typedef struct {
 } DataContainer;
 
 DataContainer *det_determine_all(Cell const *cell, int const hall_number,
-                                 double const symprec,
+                                 RefineLevel const level, double const symprec,
                                  double const angle_symprec);
+DataContainer *det_update_all(Cell const *cell, Symmetry const *symmetry,
+                              int const hall_number, double const symprec,
+                              double const angle_symprec);
+int det_scan_tolerances(int spacegroup_numbers[], int hall_numbers[],
+                        int n_operations[], Cell const *cell,
+                        double const symprecs[], int const num_symprec,
+                        double const angle_symprec);
 void det_free_container(DataContainer *container);
 
 #endif
@@ -38,6 +38,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "debug.h"
 #include "msg_database.h"
 #include "refinement.h"
@@ -473,9 +474,9 @@ static int get_reference_space_group(Spacegroup **ref_sg,
     sym_fsg = NULL;
     sym_free_symmetry(sym_xsg);
     sym_xsg = NULL;
-    free(fsg);
+    arn_free(fsg);
     fsg = NULL;
-    free(xsg);
+    arn_free(xsg);
     xsg = NULL;
     sym_free_magnetic_symmetry(representatives);
     representatives = NULL;
@@ -491,11 +492,11 @@ err:
         sym_xsg = NULL;
     }
     if (fsg != NULL) {
-        free(fsg);
+        arn_free(fsg);
         fsg = NULL;
     }
     if (xsg != NULL) {
-        free(xsg);
+        arn_free(xsg);
         xsg = NULL;
     }
     if (representatives != NULL) {
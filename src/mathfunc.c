@@ -37,10 +37,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "arena.h"
 #include "debug.h"
 
 #define ZERO_PREC 1e-10
 
+static long long get_extended_gcd(long long *a, long long *b,
+                                  long long const x, long long const y);
+
 double mat_get_determinant_d3(double const a[3][3]) {
     return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) +
            a[0][1] * (a[1][2] * a[2][0] - a[1][0] * a[2][2]) +
@@ -379,17 +383,17 @@ MatINT *mat_alloc_MatINT(int const size) {
 
     matint = NULL;
 
-    if ((matint = (MatINT *)malloc(sizeof(MatINT))) == NULL) {
+    if ((matint = (MatINT *)arn_malloc(sizeof(MatINT))) == NULL) {
         warning_memory("matint");
         return NULL;
     }
 
     matint->size = size;
     if (size > 0) {
-        if ((matint->mat = (int(*)[3][3])malloc(sizeof(int[3][3]) * size)) ==
-            NULL) {
+        if ((matint->mat =
+                 (int(*)[3][3])arn_malloc(sizeof(int[3][3]) * size)) == NULL) {
             warning_memory("matint->mat");
-            free(matint);
+            arn_free(matint);
             matint = NULL;
             return NULL;
         }
@@ -398,11 +402,14 @@ MatINT *mat_alloc_MatINT(int const size) {
 }
 
 void mat_free_MatINT(MatINT *matint) {
+    if (matint == NULL) {
+        return;
+    }
     if (matint->size > 0) {
-        free(matint->mat);
+        arn_free(matint->mat);
         matint->mat = NULL;
     }
-    free(matint);
+    arn_free(matint);
 }
 
 VecDBL *mat_alloc_VecDBL(int const size) {
@@ -410,17 +417,17 @@ VecDBL *mat_alloc_VecDBL(int const size) {
 
     vecdbl = NULL;
 
-    if ((vecdbl = (VecDBL *)malloc(sizeof(VecDBL))) == NULL) {
+    if ((vecdbl = (VecDBL *)arn_malloc(sizeof(VecDBL))) == NULL) {
         warning_memory("vecdbl");
         return NULL;
     }
 
     vecdbl->size = size;
     if (size > 0) {
-        if ((vecdbl->vec = (double(*)[3])malloc(sizeof(double[3]) * size)) ==
-            NULL) {
+        if ((vecdbl->vec =
+                 (double(*)[3])arn_malloc(sizeof(double[3]) * size)) == NULL) {
             warning_memory("vecdbl->vec");
-            free(vecdbl);
+            arn_free(vecdbl);
             vecdbl = NULL;
             return NULL;
         }
@@ -429,11 +436,14 @@ VecDBL *mat_alloc_VecDBL(int const size) {
 }
 
 void mat_free_VecDBL(VecDBL *vecdbl) {
+    if (vecdbl == NULL) {
+        return;
+    }
     if (vecdbl->size > 0) {
-        free(vecdbl->vec);
+        arn_free(vecdbl->vec);
         vecdbl->vec = NULL;
     }
-    free(vecdbl);
+    arn_free(vecdbl);
 }
 
 int mat_is_int_matrix(double const mat[3][3], double const symprec) {
@@ -447,3 +457,87 @@ int mat_is_int_matrix(double const mat[3][3], double const symprec) {
     }
     return 1;
 }
+
+long long mat_get_gcd(long long const a, long long const b) {
+    long long x, y;
+
+    return get_extended_gcd(&x, &y, a, b);
+}
+
+/* Add vec to the lattice spanned by the rows of the upper triangular hnf. */
+/* The lattice has to contain modulus * I, e.g., when hnf is initialized */
+/* to it, so vec is reduced modulo modulus. The entries above the diagonal */
+/* are reduced to [0, hnf[j][j]). Intermediate values stay below */
+/* 4 * modulus**3. */
+void mat_add_to_hermite_basis(long long hnf[3][3], long long const vec[3],
+                              long long const modulus) {
+    int i, j, k;
+    long long a, b, g, p, q, row;
+    long long x[3];
+
+    for (i = 0; i < 3; i++) {
+        x[i] = vec[i] % modulus;
+    }
+
+    for (i = 0; i < 3; i++) {
+        if (x[i] == 0) {
+            continue;
+        }
+        g = get_extended_gcd(&a, &b, hnf[i][i], x[i]);
+        p = hnf[i][i] / g;
+        q = x[i] / g;
+        hnf[i][i] = g;
+        x[i] = 0;
+        for (j = i + 1; j < 3; j++) {
+            row = a * hnf[i][j] + b * x[j];
+            x[j] = p * x[j] - q * hnf[i][j];
+            hnf[i][j] = row;
+        }
+    }
+
+    for (j = 1; j < 3; j++) {
+        for (i = 0; i < j; i++) {
+            q = hnf[i][j] / hnf[j][j];
+            if (hnf[i][j] - q * hnf[j][j] < 0) {
+                q--;
+            }
+            for (k = j; k < 3; k++) {
+                hnf[i][k] -= q * hnf[j][k];
+            }
+        }
+    }
+}
+
+/* Return g = gcd(x, y) >= 0 with a * x + b * y = g. */
+static long long get_extended_gcd(long long *a, long long *b,
+                                  long long const x, long long const y) {
+    long long r0, r1, s0, s1, t0, t1, q, tmp;
+
+    r0 = x;
+    r1 = y;
+    s0 = 1;
+    s1 = 0;
+    t0 = 0;
+    t1 = 1;
+    while (r1 != 0) {
+        q = r0 / r1;
+        tmp = r0 - q * r1;
+        r0 = r1;
+        r1 = tmp;
+        tmp = s0 - q * s1;
+        s0 = s1;
+        s1 = tmp;
+        tmp = t0 - q * t1;
+        t0 = t1;
+        t1 = tmp;
+    }
+
+    if (r0 < 0) {
+        r0 = -r0;
+        s0 = -s0;
+        t0 = -t0;
+    }
+    *a = s0;
+    *b = t0;
+    return r0;
+}
@@ -40,6 +40,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "budget.h"
 #include "debug.h"
 
 typedef struct {
@@ -156,6 +157,9 @@ int niggli_reduce(double *lattice_, double const eps_,
     }
 
     for (int i = 0, max_attempts = get_num_attempts(); i < max_attempts; i++) {
+        if (bdg_is_exceeded()) {
+            goto ret;
+        }
         int j = 0;
         for (; j < 8; j++) {
             if ((*steps[j])(p)) {
@@ -39,6 +39,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
+#include "budget.h"
 #include "debug.h"
 #include "mathfunc.h"
 
@@ -48,6 +50,13 @@
     #define SPG_POST_INCREMENT(a, b) ((a) += (b), (a) - (b))
 #endif
 
+/* Upper bound of the number of cell-list bins along one axis. */
+#define MAX_CELL_LIST_GRID 1024
+/* Number of cell-list slots whose distances are computed at once. */
+#define OVL_BLOCK_SIZE 8
+/* Margin in units of a bin added to the range of bins searched. */
+#define OVL_BIN_MARGIN 1e-6
+
 /* deal with inline */
 #if defined(_MSC_VER)
     #define OVL_INLINE __forceinline
@@ -84,6 +93,12 @@ static int perm_argsort(int *perm, int const *types, double const *values,
 static int check_possible_overlap(OverlapChecker *checker,
                                   double const test_trans[3],
                                   int const rot[3][3], double const symprec);
+static int has_overlap_in_type(OverlapChecker const *checker,
+                               double const pos[3], int const t,
+                               double const symprec);
+static int search_distance_lower_bound(double const *distances,
+                                       int const first, int const last,
+                                       double const value);
 
 static int argsort_by_lattice_point_distance(
     int *perm, double const lattice[3][3], double const (*positions)[3],
@@ -92,19 +107,25 @@ static int argsort_by_lattice_point_distance(
 
 static OverlapChecker *overlap_checker_alloc(int size);
 
-static int check_total_overlap_for_sorted(
-    double const lattice[3][3], double const (*pos_original)[3],
-    double const (*pos_rotated)[3], int const types_original[],
-    int const types_rotated[], int const num_pos, double const symprec);
-/* ovl_check_total_overlap ,check_total_overlap_for_sorted, layer_has_overlap */
-/* and layer_has_overlap_with_same_type are copied to get rid of some if
- * statement */
-/* I have not tested if it is better in efficiency. */
-static int check_layer_total_overlap_for_sorted(
-    double const lattice[3][3], double const (*pos_original)[3],
-    double const (*pos_rotated)[3], int const types_original[],
-    int const types_rotated[], int const num_pos, int const periodic_axes[3],
-    double const symprec);
+static void set_cell_list_grid(int grid[3], int const num_atoms,
+                               double const reciprocal_norms[3],
+                               int const aperiodic_axis);
+
+static void build_cell_list(OverlapChecker *checker, int const aperiodic_axis);
+
+static int rematch_in_cell_list(OverlapChecker *checker, int const i_start,
+                                double const test_trans[3],
+                                int const rot[3][3], double const symprec,
+                                int const is_identity, int const is_layer);
+
+static int check_total_overlap_in_cell_list(int mapping[],
+                                            double *max_distance,
+                                            OverlapChecker *checker,
+                                            double const test_trans[3],
+                                            int const rot[3][3],
+                                            double const symprec,
+                                            int const is_identity,
+                                            int const is_layer);
 
 /* Note that some compilers apparently don't like it
  * when you have a separate prototype with a function
@@ -113,80 +134,201 @@ static int check_layer_total_overlap_for_sorted(
  * As an aside, yes, significant performance is lost
  * for large structures if these functions aren't inlined. */
 
-static OVL_INLINE double cartesian_norm(double const lat[3][3],
-                                        double const v[3]) {
-    double temp[3];
-    temp[0] = lat[0][0] * v[0] + lat[0][1] * v[1] + lat[0][2] * v[2];
-    temp[1] = lat[1][0] * v[0] + lat[1][1] * v[1] + lat[1][2] * v[2];
-    temp[2] = lat[2][0] * v[0] + lat[2][1] * v[1] + lat[2][2] * v[2];
-
-    return sqrt(temp[0] * temp[0] + temp[1] * temp[1] + temp[2] * temp[2]);
-}
-
-static OVL_INLINE int Nint(double const a) {
-    if (a < 0.0)
-        return (int)(a - 0.5);
-    else
-        return (int)(a + 0.5);
-}
-
 static OVL_INLINE int has_overlap(double const a[3], double const b[3],
                                   double const lattice[3][3],
                                   double const symprec) {
+    double const wrap[3] = {1, 1, 1};
     double v_diff[3];
+
     v_diff[0] = a[0] - b[0];
-    v_diff[2] = a[2] - b[2];
     v_diff[1] = a[1] - b[1];
+    v_diff[2] = a[2] - b[2];
 
-    v_diff[0] -= Nint(v_diff[0]);
-    v_diff[1] -= Nint(v_diff[1]);
-    v_diff[2] -= Nint(v_diff[2]);
-
-    if (cartesian_norm(lattice, v_diff) <= symprec) {
+    if (cel_get_distance2(lattice, v_diff, wrap) <= symprec * symprec) {
         return 1;
     } else {
         return 0;
     }
 }
 
-static OVL_INLINE int has_overlap_with_same_type(
-    double const a[3], double const b[3], int const type_a, int const type_b,
-    double const lattice[3][3], double const symprec) {
-    if (type_a == type_b) {
-        return has_overlap(a, b, lattice, symprec);
-    } else {
+/* Bin index of a fractional coordinate in a periodic mesh of 'num_bins'. */
+static OVL_INLINE int get_bin(double const x, int const num_bins) {
+    int bin;
+
+    bin = (int)((x - floor(x)) * num_bins);
+    if (bin < 0) {
         return 0;
     }
+    if (bin >= num_bins) {
+        return num_bins - 1;
+    }
+    return bin;
 }
 
-/* Modified from has_overlap */
-static OVL_INLINE int layer_has_overlap(double const a[3], double const b[3],
-                                        double const lattice[3][3],
-                                        int const periodic_axes[2],
-                                        double const symprec) {
-    double v_diff[3];
-    v_diff[0] = a[0] - b[0];
-    v_diff[1] = a[1] - b[1];
-    v_diff[2] = a[2] - b[2];
+static OVL_INLINE int get_bin_key(OverlapChecker const *checker, int const t,
+                                  double const pos[3]) {
+    int const *grid;
 
-    v_diff[periodic_axes[0]] -= Nint(v_diff[periodic_axes[0]]);
-    v_diff[periodic_axes[1]] -= Nint(v_diff[periodic_axes[1]]);
+    grid = checker->type_grid[t];
+    return checker->type_bin_start[t] +
+           (get_bin(pos[0], grid[0]) * grid[1] + get_bin(pos[1], grid[1])) *
+               grid[2] +
+           get_bin(pos[2], grid[2]);
+}
 
-    if (cartesian_norm(lattice, v_diff) <= symprec) {
-        return 1;
-    } else {
-        return 0;
+/* Returns the first slot l in [begin, end) of bin_atoms that overlaps */
+/* with 'pos' and, if is_unmatched_only, is not marked in found_temp. */
+/* The squared distances of a block of slots are computed from bin_pos */
+/* without branches, so that compilers can vectorize the loop. */
+/* wrap[k] = 0 disables the periodic boundary condition along the k-th */
+/* axis. */
+/* -1: No such slot. */
+static OVL_INLINE int find_unmatched_overlap_in_slots(
+    OverlapChecker const *checker, double const pos[3], double const wrap[3],
+    int const begin, int const end, double const symprec2,
+    int const is_unmatched_only) {
+    int l, m, num_block;
+    double diff[3], distance2[OVL_BLOCK_SIZE];
+
+    for (l = begin; l < end; l += OVL_BLOCK_SIZE) {
+        num_block = end - l < OVL_BLOCK_SIZE ? end - l : OVL_BLOCK_SIZE;
+        for (m = 0; m < num_block; m++) {
+            diff[0] = pos[0] - checker->bin_pos[0][l + m];
+            diff[1] = pos[1] - checker->bin_pos[1][l + m];
+            diff[2] = pos[2] - checker->bin_pos[2][l + m];
+            distance2[m] = cel_get_distance2(checker->lattice, diff, wrap);
+        }
+        for (m = 0; m < num_block; m++) {
+            if (distance2[m] <= symprec2 &&
+                !(is_unmatched_only && checker->found_temp[l + m])) {
+                return l + m;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/* Returns the slot in bin_atoms of an atom of the t-th type that */
+/* overlaps with 'pos' and, if is_unmatched_only, is not marked in */
+/* found_temp. Only the bins within 'symprec' from 'pos' are searched. */
+/* -1: No such atom. */
+static OVL_INLINE int find_unmatched_overlap(OverlapChecker const *checker,
+                                             double const pos[3], int const t,
+                                             double const symprec,
+                                             int const is_layer,
+                                             int const is_unmatched_only) {
+    int i, j, k, l, row, lower, upper;
+    int first[3], num[3];
+    double symprec2, x, d;
+    double wrap[3];
+    int const *grid;
+
+    grid = checker->type_grid[t];
+    symprec2 = symprec * symprec;
+
+    for (i = 0; i < 3; i++) {
+        wrap[i] = is_layer ? 0 : 1;
+    }
+    if (is_layer) {
+        wrap[checker->periodic_axes[0]] = 1;
+        wrap[checker->periodic_axes[1]] = 1;
+    }
+
+    /* A fractional displacement along axis i is bounded by */
+    /* d = symprec * |i-th reciprocal basis vector|, so only the bins */
+    /* overlapping [x - d, x + d] are searched. This is usually one bin */
+    /* per axis when symprec is much smaller than the bins. The margin */
+    /* keeps the atoms at the bin boundaries against rounding. */
+    for (i = 0; i < 3; i++) {
+        x = pos[i] - floor(pos[i]);
+        d = symprec * checker->reciprocal_norms[i];
+        if (2 * d >= 1) {
+            first[i] = 0;
+            num[i] = grid[i];
+            continue;
+        }
+        /* Truncation of the non-negative values instead of floor */
+        lower = (int)((x - d) * grid[i] - OVL_BIN_MARGIN + grid[i]) - grid[i];
+        upper = (int)((x + d) * grid[i] + OVL_BIN_MARGIN);
+        if (upper - lower + 1 >= grid[i]) {
+            first[i] = 0;
+            num[i] = grid[i];
+        } else {
+            first[i] = lower + grid[i];
+            num[i] = upper - lower + 1;
+        }
+    }
+
+    /* Along the last axis, the bins are contiguous in bin_atoms except */
+    /* for the wrap around, so they are searched in one or two runs. */
+    for (i = 0; i < num[0]; i++) {
+        for (j = 0; j < num[1]; j++) {
+            row = checker->type_bin_start[t] +
+                  (((first[0] + i) % grid[0]) * grid[1] +
+                   (first[1] + j) % grid[1]) *
+                      grid[2];
+            k = first[2] % grid[2];
+            if (k + num[2] <= grid[2]) {
+                l = find_unmatched_overlap_in_slots(
+                    checker, pos, wrap, checker->bin_start[row + k],
+                    checker->bin_start[row + k + num[2]], symprec2,
+                    is_unmatched_only);
+            } else {
+                l = find_unmatched_overlap_in_slots(
+                    checker, pos, wrap, checker->bin_start[row + k],
+                    checker->bin_start[row + grid[2]], symprec2,
+                    is_unmatched_only);
+                if (l == -1) {
+                    l = find_unmatched_overlap_in_slots(
+                        checker, pos, wrap, checker->bin_start[row],
+                        checker->bin_start[row + k + num[2] - grid[2]],
+                        symprec2, is_unmatched_only);
+                }
+            }
+            if (l != -1) {
+                return l;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/* Squared Cartesian distance between 'pos' and the atom in the slot of */
+/* bin_atoms, measured in the same way as find_unmatched_overlap. */
+static OVL_INLINE double get_slot_distance2(OverlapChecker const *checker,
+                                            double const pos[3],
+                                            int const slot,
+                                            int const is_layer) {
+    int k;
+    double diff[3], wrap[3];
+
+    for (k = 0; k < 3; k++) {
+        diff[k] = pos[k] - checker->bin_pos[k][slot];
+        wrap[k] = (!is_layer || k == checker->periodic_axes[0] ||
+                   k == checker->periodic_axes[1]);
     }
+
+    return cel_get_distance2(checker->lattice, diff, wrap);
 }
 
-static OVL_INLINE int layer_has_overlap_with_same_type(
-    double const a[3], double const b[3], int const type_a, int const type_b,
-    double const lattice[3][3], int const periodic_axes[2],
-    double const symprec) {
-    if (type_a == type_b) {
-        return layer_has_overlap(a, b, lattice, periodic_axes, symprec);
+/* Position of the i-th sorted atom transformed by (rot, test_trans). */
+static OVL_INLINE void get_rotated_position(double pos_rot[3],
+                                            OverlapChecker const *checker,
+                                            int const i,
+                                            double const test_trans[3],
+                                            int const rot[3][3],
+                                            int const is_identity) {
+    int k;
+
+    if (is_identity) {
+        mat_copy_vector_d3(pos_rot, checker->pos_sorted[i]);
     } else {
-        return 0;
+        mat_multiply_matrix_vector_id3(pos_rot, rot, checker->pos_sorted[i]);
+    }
+    for (k = 0; k < 3; k++) {
+        pos_rot[k] += test_trans[k];
     }
 }
 
@@ -203,19 +345,20 @@ typedef struct {
 void ovl_overlap_checker_free(OverlapChecker *checker) {
     if (checker != NULL) {
         if (checker->argsort_work != NULL) {
-            free(checker->argsort_work);
+            arn_free(checker->argsort_work);
             checker->argsort_work = NULL;
         }
         if (checker->blob != NULL) {
-            free(checker->blob);
+            arn_free(checker->blob);
             checker->blob = NULL;
         }
-        free(checker);
+        arn_free(checker);
     }
 }
 
 OverlapChecker *ovl_overlap_checker_init(Cell const *cell) {
-    int i, lattice_rank;
+    int i, j, lattice_rank;
+    double inv_lattice[3][3];
     OverlapChecker *checker;
     checker = NULL;
 
@@ -225,6 +368,18 @@ OverlapChecker *ovl_overlap_checker_init(Cell const *cell) {
     }
 
     mat_copy_matrix_d3(checker->lattice, cell->lattice);
+    if (!mat_inverse_matrix_d3(inv_lattice, cell->lattice, 0)) {
+        ovl_overlap_checker_free(checker);
+        return NULL;
+    }
+    for (i = 0; i < 3; i++) {
+        checker->reciprocal_norms[i] = 0;
+        for (j = 0; j < 3; j++) {
+            checker->reciprocal_norms[i] +=
+                inv_lattice[i][j] * inv_lattice[i][j];
+        }
+        checker->reciprocal_norms[i] = sqrt(checker->reciprocal_norms[i]);
+    }
 
     /* Get the permutation that sorts the original cell. */
     if (!argsort_by_lattice_point_distance(
@@ -241,6 +396,15 @@ OverlapChecker *ovl_overlap_checker_init(Cell const *cell) {
 
     permute_int(checker->types_sorted, cell->types, checker->perm_temp,
                 cell->size);
+    for (i = 0; i < cell->size; i++) {
+        checker->atom_index[i] = checker->perm_temp[i];
+    }
+
+    /* distance_temp holds squared distances in the original order. */
+    for (i = 0; i < cell->size; i++) {
+        checker->distance_sorted[i] =
+            sqrt(checker->distance_temp[checker->perm_temp[i]]);
+    }
 
     lattice_rank = 0;
     for (i = 0; i < 3; i++) {
@@ -250,6 +414,8 @@ OverlapChecker *ovl_overlap_checker_init(Cell const *cell) {
         }
     }
 
+    build_cell_list(checker, cell->aperiodic_axis);
+
     return checker;
 }
 
@@ -259,59 +425,23 @@ OverlapChecker *ovl_overlap_checker_init(Cell const *cell) {
  * same cell, */
 /* you can create one OverlapChecker from the Cell and call this function many
  * times. */
-/* -1: Error.  0:  Not a symmetry.   1. Is a symmetry. */
+/* -1: Error or exceeded work budget.  0:  Not a symmetry.   1. Is a */
+/* symmetry. */
 int ovl_check_total_overlap(OverlapChecker *checker, double const test_trans[3],
                             int const rot[3][3], double const symprec,
                             int const is_identity) {
-    int i, k, check;
+    if (!bdg_count_overlap_check()) {
+        return -1;
+    }
 
     /* Check a few atoms by brute force before continuing. */
-    /* For bad translations, this can be much cheaper than sorting. */
+    /* For bad translations, this can be much cheaper than the full check. */
     if (!check_possible_overlap(checker, test_trans, rot, symprec)) {
         return 0;
     }
 
-    /* Write rotated positions to 'pos_temp_1' */
-    for (i = 0; i < checker->size; i++) {
-        if (is_identity) {
-            for (k = 0; k < 3; k++) {
-                checker->pos_temp_1[i][k] = checker->pos_sorted[i][k];
-            }
-        } else {
-            mat_multiply_matrix_vector_id3(checker->pos_temp_1[i], rot,
-                                           checker->pos_sorted[i]);
-        }
-
-        for (k = 0; k < 3; k++) {
-            checker->pos_temp_1[i][k] += test_trans[k];
-        }
-    }
-
-    /* Get permutation that sorts these positions. */
-    if (!argsort_by_lattice_point_distance(
-            checker->perm_temp, checker->lattice, checker->pos_temp_1,
-            checker->types_sorted, checker->distance_temp,
-            checker->argsort_work, checker->size)) {
-        return -1;
-    }
-
-    /* Use the permutation to sort them. Write to 'pos_temp_2'. */
-    permute_double_3(checker->pos_temp_2, checker->pos_temp_1,
-                     checker->perm_temp, checker->size);
-
-    /* Do optimized check for overlap between sorted coordinates. */
-    check = check_total_overlap_for_sorted(
-        checker->lattice, checker->pos_sorted, /* pos_original */
-        checker->pos_temp_2,                   /* pos_rotated */
-        checker->types_sorted,                 /* types_original */
-        checker->types_sorted,                 /* types_original */
-        checker->size, symprec);
-    if (check == -1) {
-        /* Error! */
-        return -1;
-    }
-
-    return check;
+    return check_total_overlap_in_cell_list(NULL, NULL, checker, test_trans,
+                                            rot, symprec, is_identity, 0);
 }
 
 /* Uses a OverlapChecker to efficiently--but thoroughly--confirm that a given
@@ -320,60 +450,67 @@ int ovl_check_total_overlap(OverlapChecker *checker, double const test_trans[3],
  * same cell, */
 /* you can create one OverlapChecker from the Cell and call this function many
  * times. */
-/* -1: Error.  0:  Not a symmetry.   1. Is a symmetry. */
+/* -1: Error or exceeded work budget.  0:  Not a symmetry.   1. Is a */
+/* symmetry. */
 int ovl_check_layer_total_overlap(OverlapChecker *checker,
                                   double const test_trans[3],
                                   int const rot[3][3], double const symprec,
                                   int const is_identity) {
-    int i, k, check;
+    if (!bdg_count_overlap_check()) {
+        return -1;
+    }
 
     /* Check a few atoms by brute force before continuing. */
-    /* For bad translations, this can be much cheaper than sorting. */
+    /* For bad translations, this can be much cheaper than the full check. */
     if (!check_possible_overlap(checker, test_trans, rot, symprec)) {
         return 0;
     }
 
-    /* Write rotated positions to 'pos_temp_1' */
-    for (i = 0; i < checker->size; i++) {
-        if (is_identity) {
-            for (k = 0; k < 3; k++) {
-                checker->pos_temp_1[i][k] = checker->pos_sorted[i][k];
-            }
-        } else {
-            mat_multiply_matrix_vector_id3(checker->pos_temp_1[i], rot,
-                                           checker->pos_sorted[i]);
-        }
+    return check_total_overlap_in_cell_list(NULL, NULL, checker, test_trans,
+                                            rot, symprec, is_identity, 1);
+}
 
-        for (k = 0; k < 3; k++) {
-            checker->pos_temp_1[i][k] += test_trans[k];
-        }
+/* Same as ovl_check_total_overlap, but also returns the atom mapping, */
+/* i.e., the operation maps the i-th atom onto the mapping[i]-th atom, and */
+/* the largest Cartesian distance between the mapped atoms. They are set */
+/* only if the operation is a symmetry. */
+/* -1: Error or exceeded work budget.  0:  Not a symmetry.   1. Is a */
+/* symmetry. */
+int ovl_get_overlap_mapping(int mapping[], double *max_distance,
+                            OverlapChecker *checker, double const test_trans[3],
+                            int const rot[3][3], double const symprec,
+                            int const is_identity, int const is_layer) {
+    if (!bdg_count_overlap_check()) {
+        return -1;
     }
 
-    /* Get permutation that sorts these positions. */
-    if (!argsort_by_lattice_point_distance(
-            checker->perm_temp, checker->lattice, checker->pos_temp_1,
-            checker->types_sorted, checker->distance_temp,
-            checker->argsort_work, checker->size)) {
-        return -1;
+    if (!check_possible_overlap(checker, test_trans, rot, symprec)) {
+        return 0;
     }
 
-    /* Use the permutation to sort them. Write to 'pos_temp_2'. */
-    permute_double_3(checker->pos_temp_2, checker->pos_temp_1,
-                     checker->perm_temp, checker->size);
+    return check_total_overlap_in_cell_list(mapping, max_distance, checker,
+                                            test_trans, rot, symprec,
+                                            is_identity, is_layer);
+}
 
-    /* Do optimized check for overlap between sorted coordinates. */
-    check = check_layer_total_overlap_for_sorted(
-        checker->lattice, checker->pos_sorted, /* pos_original */
-        checker->pos_temp_2,                   /* pos_rotated */
-        checker->types_sorted,                 /* types_original */
-        checker->types_sorted,                 /* types_original */
-        checker->size, checker->periodic_axes, symprec);
-    if (check == -1) {
-        /* Error! */
-        return -1;
+/* Looks up an atom of 'type' that overlaps with 'pos' in the cell list. */
+/* Returns its index in the original cell, or -1 if there is none. */
+int ovl_find_overlap(OverlapChecker const *checker, double const pos[3],
+                     int const type, double const symprec, int const is_layer) {
+    int t, slot;
+
+    for (t = 0; t < checker->num_types; t++) {
+        if (checker->types_sorted[checker->type_start[t]] == type) {
+            slot =
+                find_unmatched_overlap(checker, pos, t, symprec, is_layer, 0);
+            if (slot == -1) {
+                return -1;
+            }
+            return checker->atom_index[checker->bin_atoms[slot]];
+        }
     }
 
-    return check;
+    return -1;
 }
 
 static int ValueWithIndex_comparator(void const *pa, void const *pb) {
@@ -397,7 +534,7 @@ static void *perm_argsort_work_malloc(int n) {
 
     work = NULL;
 
-    if ((work = (ValueWithIndex *)(malloc(sizeof(ValueWithIndex) * n))) ==
+    if ((work = (ValueWithIndex *)(arn_malloc(sizeof(ValueWithIndex) * n))) ==
         NULL) {
         warning_memory("work");
         return NULL;
@@ -405,7 +542,7 @@ static void *perm_argsort_work_malloc(int n) {
     return work;
 }
 
-static void perm_argsort_work_free(void *work) { free(work); }
+static void perm_argsort_work_free(void *work) { arn_free(work); }
 
 /* Compute a permutation that sorts values first by atom type, */
 /* and then by value.  If types is NULL, all atoms are assumed */
@@ -477,11 +614,13 @@ static void permute_double_3(double (*data_out)[3], double const (*data_in)[3],
 }
 
 static OverlapChecker *overlap_checker_alloc(int size) {
-    int offset_pos_temp_1, offset_pos_temp_2, offset_distance_temp;
-    int offset_perm_temp, offset_pos_sorted, offset_types_sorted,
-        offset_lattice;
-    int offset_periodic_axes;
-    int offset, blob_size;
+    int offset_distance_temp, offset_perm_temp, offset_found_temp;
+    int offset_pos_sorted, offset_types_sorted, offset_lattice;
+    int offset_type_index, offset_type_start, offset_type_grid;
+    int offset_type_bin_start, offset_bin_start, offset_bin_atoms;
+    int offset_bin_pos, offset_atom_index, offset_path_temp;
+    int offset_reciprocal_norms, offset_periodic_axes, offset_distance_sorted;
+    int i, offset, blob_size;
     char *chr_blob;
     OverlapChecker *checker;
 
@@ -490,55 +629,192 @@ static OverlapChecker *overlap_checker_alloc(int size) {
 
     /* checker->blob is going to contain lots of things. */
     /* Compute its total size and the number of bytes before each thing. */
+    /* Doubles are placed first to keep them aligned. */
+    /* Every type has at most as many bins as atoms (see */
+    /* set_cell_list_grid), so the cell list is bounded by 'size'. */
     offset = 0;
-    offset_pos_temp_1 = SPG_POST_INCREMENT(offset, size * sizeof(double[3]));
-    offset_pos_temp_2 = SPG_POST_INCREMENT(offset, size * sizeof(double[3]));
-    offset_distance_temp = SPG_POST_INCREMENT(offset, size * sizeof(double));
-    offset_perm_temp = SPG_POST_INCREMENT(offset, size * sizeof(int));
     offset_lattice = SPG_POST_INCREMENT(offset, 9 * sizeof(double));
+    offset_reciprocal_norms = SPG_POST_INCREMENT(offset, 3 * sizeof(double));
     offset_pos_sorted = SPG_POST_INCREMENT(offset, size * sizeof(double[3]));
+    offset_bin_pos = SPG_POST_INCREMENT(offset, size * sizeof(double[3]));
+    offset_distance_temp = SPG_POST_INCREMENT(offset, size * sizeof(double));
+    offset_distance_sorted = SPG_POST_INCREMENT(offset, size * sizeof(double));
+    offset_perm_temp = SPG_POST_INCREMENT(offset, size * sizeof(int));
+    offset_found_temp = SPG_POST_INCREMENT(offset, size * sizeof(int));
+    offset_path_temp = SPG_POST_INCREMENT(offset, 3 * size * sizeof(int));
     offset_types_sorted = SPG_POST_INCREMENT(offset, size * sizeof(int));
+    offset_atom_index = SPG_POST_INCREMENT(offset, size * sizeof(int));
+    offset_type_index = SPG_POST_INCREMENT(offset, size * sizeof(int));
+    offset_type_start = SPG_POST_INCREMENT(offset, (size + 1) * sizeof(int));
+    offset_type_grid = SPG_POST_INCREMENT(offset, size * sizeof(int[3]));
+    offset_type_bin_start =
+        SPG_POST_INCREMENT(offset, (size + 1) * sizeof(int));
+    offset_bin_start = SPG_POST_INCREMENT(offset, (size + 1) * sizeof(int));
+    offset_bin_atoms = SPG_POST_INCREMENT(offset, size * sizeof(int));
     offset_periodic_axes = SPG_POST_INCREMENT(offset, 3 * sizeof(int));
     blob_size = offset;
 
-    if ((checker = (OverlapChecker *)malloc(sizeof(OverlapChecker))) == NULL) {
+    if ((checker = (OverlapChecker *)arn_malloc(sizeof(OverlapChecker))) ==
+        NULL) {
         warning_memory("checker");
         return NULL;
     }
 
-    if ((checker->blob = malloc(blob_size)) == NULL) {
+    if ((checker->blob = arn_malloc(blob_size)) == NULL) {
         warning_memory("checker->blob");
-        free(checker);
+        arn_free(checker);
         checker = NULL;
         return NULL;
     }
 
     if ((checker->argsort_work = perm_argsort_work_malloc(size)) == NULL) {
-        free(checker->blob);
+        arn_free(checker->blob);
         checker->blob = NULL;
-        free(checker);
+        arn_free(checker);
         checker = NULL;
         return NULL;
     }
 
     checker->size = size;
+    checker->num_types = 0;
 
     /* Create the pointers to the things contained in checker->blob. */
     /* The C spec doesn't allow arithmetic directly on 'void *', */
     /* so a 'char *' is used. */
     chr_blob = (char *)checker->blob;
-    checker->pos_temp_1 = (double(*)[3])(chr_blob + offset_pos_temp_1);
-    checker->pos_temp_2 = (double(*)[3])(chr_blob + offset_pos_temp_2);
-    checker->distance_temp = (double *)(chr_blob + offset_distance_temp);
-    checker->perm_temp = (int *)(chr_blob + offset_perm_temp);
     checker->lattice = (double(*)[3])(chr_blob + offset_lattice);
+    checker->reciprocal_norms = (double *)(chr_blob + offset_reciprocal_norms);
     checker->pos_sorted = (double(*)[3])(chr_blob + offset_pos_sorted);
+    checker->distance_temp = (double *)(chr_blob + offset_distance_temp);
+    checker->distance_sorted = (double *)(chr_blob + offset_distance_sorted);
+    checker->perm_temp = (int *)(chr_blob + offset_perm_temp);
+    checker->found_temp = (int *)(chr_blob + offset_found_temp);
+    checker->visited_temp = (int *)(chr_blob + offset_path_temp);
+    checker->path_atoms = checker->visited_temp + size;
+    checker->path_slots = checker->visited_temp + 2 * size;
     checker->types_sorted = (int *)(chr_blob + offset_types_sorted);
+    checker->atom_index = (int *)(chr_blob + offset_atom_index);
+    checker->type_index = (int *)(chr_blob + offset_type_index);
+    checker->type_start = (int *)(chr_blob + offset_type_start);
+    checker->type_grid = (int(*)[3])(chr_blob + offset_type_grid);
+    checker->type_bin_start = (int *)(chr_blob + offset_type_bin_start);
+    checker->bin_start = (int *)(chr_blob + offset_bin_start);
+    checker->bin_atoms = (int *)(chr_blob + offset_bin_atoms);
+    for (i = 0; i < 3; i++) {
+        checker->bin_pos[i] =
+            (double *)(chr_blob + offset_bin_pos) + (size_t)i * size;
+    }
     checker->periodic_axes = (int *)(chr_blob + offset_periodic_axes);
 
     return checker;
 }
 
+/* Choose a mesh of at most 'num_atoms' bins whose shapes are roughly */
+/* cubic in Cartesian coordinates. The spacing of lattice planes along */
+/* axis i is 1 / |i-th reciprocal basis vector|. The aperiodic axis of a */
+/* layer is not divided. */
+static void set_cell_list_grid(int grid[3], int const num_atoms,
+                               double const reciprocal_norms[3],
+                               int const aperiodic_axis) {
+    int i, i_max, rank;
+    double volume, scale, x;
+
+    rank = 0;
+    volume = 1;
+    for (i = 0; i < 3; i++) {
+        if (i != aperiodic_axis) {
+            volume /= reciprocal_norms[i];
+            rank++;
+        }
+    }
+    scale = pow(num_atoms / volume, 1.0 / rank);
+
+    for (i = 0; i < 3; i++) {
+        if (i == aperiodic_axis) {
+            grid[i] = 1;
+            continue;
+        }
+        x = scale / reciprocal_norms[i];
+        if (x < 1) {
+            grid[i] = 1;
+        } else if (x > MAX_CELL_LIST_GRID) {
+            grid[i] = MAX_CELL_LIST_GRID;
+        } else {
+            grid[i] = (int)x;
+        }
+    }
+
+    while (grid[0] * grid[1] * grid[2] > num_atoms) {
+        i_max = 0;
+        for (i = 1; i < 3; i++) {
+            if (grid[i] > grid[i_max]) {
+                i_max = i;
+            }
+        }
+        grid[i_max]--;
+    }
+}
+
+/* Bin the sorted positions by atom type. 'types_sorted' has to be */
+/* sorted by type so that atoms of the same type are contiguous. */
+static void build_cell_list(OverlapChecker *checker, int const aperiodic_axis) {
+    int i, k, l, t, num_bins;
+    int *bin_keys, *bin_cursor;
+
+    /* Type ranges */
+    t = -1;
+    for (i = 0; i < checker->size; i++) {
+        if (i == 0 ||
+            checker->types_sorted[i] != checker->types_sorted[i - 1]) {
+            t++;
+            checker->type_start[t] = i;
+        }
+        checker->type_index[i] = t;
+    }
+    checker->num_types = t + 1;
+    checker->type_start[checker->num_types] = checker->size;
+
+    /* Mesh of each type */
+    num_bins = 0;
+    for (t = 0; t < checker->num_types; t++) {
+        checker->type_bin_start[t] = num_bins;
+        set_cell_list_grid(checker->type_grid[t],
+                           checker->type_start[t + 1] - checker->type_start[t],
+                           checker->reciprocal_norms, aperiodic_axis);
+        num_bins += checker->type_grid[t][0] * checker->type_grid[t][1] *
+                    checker->type_grid[t][2];
+    }
+    checker->type_bin_start[checker->num_types] = num_bins;
+
+    /* Counting sort of atoms into bins. */
+    /* num_bins <= size, so the temp areas are large enough. */
+    bin_keys = checker->perm_temp;
+    bin_cursor = checker->found_temp;
+    for (i = 0; i < num_bins + 1; i++) {
+        checker->bin_start[i] = 0;
+    }
+    for (i = 0; i < checker->size; i++) {
+        bin_keys[i] = get_bin_key(checker, checker->type_index[i],
+                                  checker->pos_sorted[i]);
+        checker->bin_start[bin_keys[i] + 1]++;
+    }
+    for (i = 0; i < num_bins; i++) {
+        checker->bin_start[i + 1] += checker->bin_start[i];
+        bin_cursor[i] = checker->bin_start[i];
+    }
+    for (i = 0; i < checker->size; i++) {
+        checker->bin_atoms[bin_cursor[bin_keys[i]]++] = i;
+    }
+
+    /* Structure-of-arrays copy of the positions in the order of slots */
+    for (l = 0; l < checker->size; l++) {
+        for (k = 0; k < 3; k++) {
+            checker->bin_pos[k][l] =
+                checker->pos_sorted[checker->bin_atoms[l]][k];
+        }
+    }
+}
+
 static int argsort_by_lattice_point_distance(
     int *perm, double const lattice[3][3], double const (*positions)[3],
     int const *types, double *distance_temp, void *argsort_work,
@@ -571,8 +847,7 @@ static int check_possible_overlap(OverlapChecker *checker,
                                   double const test_trans[3],
                                   int const rot[3][3], double const symprec) {
     double pos_rot[3];
-    int i, i_test, k, max_search_num, search_num;
-    int type_rot, is_found;
+    int i_test, k, max_search_num, search_num;
 
     max_search_num = 3;
     search_num =
@@ -581,30 +856,16 @@ static int check_possible_overlap(OverlapChecker *checker,
     /* Check a few rotated positions. */
     /* (this could be optimized by focusing on the min_atom_type) */
     for (i_test = 0; i_test < search_num; i_test++) {
-        type_rot = checker->types_sorted[i_test];
         mat_multiply_matrix_vector_id3(pos_rot, rot,
                                        checker->pos_sorted[i_test]);
         for (k = 0; k < 3; k++) {
             pos_rot[k] += test_trans[k];
         }
 
-        /* Brute-force search for the rotated position. */
-        /* (this could be optimized by saving the sorted ValueWithIndex data */
-        /*  for the original Cell and using it to binary search for lower and */
-        /*  upper bounds on 'i'. For now though, brute force is good enough) */
-        is_found = 0;
-        for (i = 0; i < checker->size; i++) {
-            if (has_overlap_with_same_type(pos_rot, checker->pos_sorted[i],
-                                           type_rot, checker->types_sorted[i],
-                                           checker->lattice, symprec)) {
-                is_found = 1;
-                break;
-            }
-        }
-
         /* The rotated position is not in the structure! */
         /* This symmetry operator is therefore clearly invalid. */
-        if (!is_found) {
+        if (!has_overlap_in_type(checker, pos_rot, checker->type_index[i_test],
+                                 symprec)) {
             return 0;
         }
     }
@@ -612,127 +873,240 @@ static int check_possible_overlap(OverlapChecker *checker,
     return 1;
 }
 
-/* Optimized for the case where the max difference in index */
-/* between pos_original and pos_rotated is small. */
-/* -1: Error.  0: False.  1:  True. */
-static int check_total_overlap_for_sorted(
-    double const lattice[3][3], double const (*pos_original)[3],
-    double const (*pos_rotated)[3], int const types_original[],
-    int const types_rotated[], int const num_pos, double const symprec) {
-    int *found;
-    int i, i_orig, i_rot;
-    int search_start;
-
-    found = NULL;
-
-    if ((found = (int *)malloc(num_pos * sizeof(int))) == NULL) {
-        warning_memory("found");
-        return -1;
-    }
-
-    /* found[i] = 1 if pos_rotated[i] has been found in pos_original */
-    for (i = 0; i < num_pos; i++) {
-        found[i] = 0;
+/* Tests if an atom of the t-th type overlaps with 'pos'. */
+/* Let u be 'pos' minus the rounded lattice point. An overlapping atom */
+/* is at 'pos' - w plus a lattice point with |w| <= symprec, and its */
+/* distance_sorted is |u + m - w| (in Cartesian) for an integer vector m */
+/* that brings u + m - w into [-0.5, 0.5]^3. m_k is non-zero only if */
+/* u_k is within symprec * |k-th reciprocal basis vector| of +/-0.5, so */
+/* at most 8 lattice points have to be tried. For each of them, only the */
+/* atoms whose distance is within symprec of |u + m| are compared, which */
+/* are found by binary search in distance_sorted. */
+/* 0: Not found.  1: Found. */
+static int has_overlap_in_type(OverlapChecker const *checker,
+                               double const pos[3], int const t,
+                               double const symprec) {
+    int i, j, k, first, last, is_valid;
+    int shift[3];
+    double half_width, distance;
+    double frac[3], diff[3];
+
+    first = checker->type_start[t];
+    last = checker->type_start[t + 1];
+
+    for (k = 0; k < 3; k++) {
+        frac[k] = pos[k] - mat_Nint(pos[k]);
+        half_width = 0.5 - symprec * checker->reciprocal_norms[k];
+        if (half_width <= 0) {
+            /* symprec is too large for the lattice. Brute-force search. */
+            for (i = first; i < last; i++) {
+                if (has_overlap(pos, checker->pos_sorted[i], checker->lattice,
+                                symprec)) {
+                    return 1;
+                }
+            }
+            return 0;
+        }
+        if (frac[k] >= half_width) {
+            shift[k] = -1;
+        } else if (frac[k] <= -half_width) {
+            shift[k] = 1;
+        } else {
+            shift[k] = 0;
+        }
     }
 
-    search_start = 0;
-    for (i_orig = 0; i_orig < num_pos; i_orig++) {
-        /* Permanently skip positions filled near the beginning. */
-        while ((search_start < num_pos) && found[search_start]) {
-            search_start++;
+    /* The window of distances is doubled to absorb rounding errors. */
+    for (j = 0; j < 8; j++) {
+        is_valid = 1;
+        for (k = 0; k < 3; k++) {
+            if ((j >> k) & 1) {
+                if (shift[k] == 0) {
+                    is_valid = 0;
+                    break;
+                }
+                diff[k] = frac[k] + shift[k];
+            } else {
+                diff[k] = frac[k];
+            }
+        }
+        if (!is_valid) {
+            continue;
         }
 
-        for (i_rot = search_start; i_rot < num_pos; i_rot++) {
-            /* Skip any filled positions that aren't near the beginning. */
-            if (found[i_rot]) {
-                continue;
-            }
-
-            if (has_overlap_with_same_type(
-                    pos_original[i_orig], pos_rotated[i_rot],
-                    types_original[i_orig], types_rotated[i_rot], lattice,
-                    symprec)) {
-                found[i_rot] = 1;
-                break;
+        mat_multiply_matrix_vector_d3(diff, checker->lattice, diff);
+        distance = sqrt(mat_norm_squared_d3(diff));
+        for (i = search_distance_lower_bound(checker->distance_sorted, first,
+                                             last, distance - 2 * symprec);
+             i < last && checker->distance_sorted[i] <= distance + 2 * symprec;
+             i++) {
+            if (has_overlap(pos, checker->pos_sorted[i], checker->lattice,
+                            symprec)) {
+                return 1;
             }
         }
+    }
 
-        if (i_rot == num_pos) {
-            /* We never hit the 'break'. */
-            /* Failure; a position in pos_original does not */
-            /* overlap with any position in pos_rotated. */
-            free(found);
-            found = NULL;
-            return 0;
+    return 0;
+}
+
+/* Returns the first index in [first, last) of the ascending 'distances' */
+/* whose value is not less than 'value', or 'last' if there is none. */
+static int search_distance_lower_bound(double const *distances,
+                                       int const first, int const last,
+                                       double const value) {
+    int lower, upper, middle;
+
+    lower = first;
+    upper = last;
+    while (lower < upper) {
+        middle = lower + (upper - lower) / 2;
+        if (distances[middle] < value) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
         }
     }
 
-    free(found);
-    found = NULL;
-
-    /* Success */
-    return 1;
+    return lower;
 }
 
-/* Optimized for the case where the max difference in index */
-/* between pos_original and pos_rotated is small. */
-/* -1: Error.  0: False.  1:  True. */
-static int check_layer_total_overlap_for_sorted(
-    double const lattice[3][3], double const (*pos_original)[3],
-    double const (*pos_rotated)[3], int const types_original[],
-    int const types_rotated[], int const num_pos, int const periodic_axes[3],
-    double const symprec) {
-    int *found;
-    int i, i_orig, i_rot;
-    int search_start;
-
-    found = NULL;
-
-    if ((found = (int *)malloc(num_pos * sizeof(int))) == NULL) {
-        warning_memory("found");
-        return -1;
+/* Every rotated position has to overlap with a distinct atom of the */
+/* same type in the original cell. Each rotated position is looked up in */
+/* the cell list, so the cost is O(N) for a well-separated structure. */
+/* The mapping and the largest distance are set unless they are NULL. */
+/* 0: False.  1:  True. */
+static int check_total_overlap_in_cell_list(int mapping[],
+                                            double *max_distance,
+                                            OverlapChecker *checker,
+                                            double const test_trans[3],
+                                            int const rot[3][3],
+                                            double const symprec,
+                                            int const is_identity,
+                                            int const is_layer) {
+    int i, t, slot;
+    double pos_rot[3], distance2, max_distance2;
+
+    /* The first atom of each type is tried first without the matching. */
+    /* Failing it is enough to reject the operation, which is the common */
+    /* case when only the atoms of some types overlap, e.g., with the */
+    /* translations between inequivalent sites in a supercell. */
+    for (t = 0; t < checker->num_types; t++) {
+        get_rotated_position(pos_rot, checker, checker->type_start[t],
+                             test_trans, rot, is_identity);
+        if (find_unmatched_overlap(checker, pos_rot, t, symprec, is_layer,
+                                   0) == -1) {
+            return 0;
+        }
     }
 
-    /* found[i] = 1 if pos_rotated[i] has been found in pos_original */
-    for (i = 0; i < num_pos; i++) {
-        found[i] = 0;
+    /* found_temp[l] = i + 1 if bin_atoms[l] is matched with the i-th */
+    /* rotated position, and 0 if it has not been matched. */
+    for (i = 0; i < checker->size; i++) {
+        checker->found_temp[i] = 0;
     }
 
-    search_start = 0;
-    for (i_orig = 0; i_orig < num_pos; i_orig++) {
-        /* Permanently skip positions filled near the beginning. */
-        while (found[search_start]) {
-            search_start++;
+    for (i = 0; i < checker->size; i++) {
+        get_rotated_position(pos_rot, checker, i, test_trans, rot,
+                             is_identity);
+        slot = find_unmatched_overlap(checker, pos_rot, checker->type_index[i],
+                                      symprec, is_layer, 1);
+        if (slot != -1) {
+            checker->found_temp[slot] = i + 1;
+            continue;
+        }
+
+        /* All the atoms overlapping with the rotated position may have */
+        /* been taken by other rotated positions when atoms are closer */
+        /* than 2 * symprec, so the earlier matches are rearranged. */
+        if (find_unmatched_overlap(checker, pos_rot, checker->type_index[i],
+                                   symprec, is_layer, 0) == -1 ||
+            !rematch_in_cell_list(checker, i, test_trans, rot, symprec,
+                                  is_identity, is_layer)) {
+            /* Failure; a rotated position does not overlap */
+            /* with any remaining position in the original cell. */
+            return 0;
         }
+    }
 
-        for (i_rot = search_start; i_rot < num_pos; i_rot++) {
-            /* Skip any filled positions that aren't near the beginning. */
-            if (found[i_rot]) {
-                continue;
+    /* Success */
+    if (mapping != NULL || max_distance != NULL) {
+        max_distance2 = 0;
+        for (slot = 0; slot < checker->size; slot++) {
+            i = checker->found_temp[slot] - 1;
+            if (mapping != NULL) {
+                mapping[checker->atom_index[i]] =
+                    checker->atom_index[checker->bin_atoms[slot]];
+            }
+            get_rotated_position(pos_rot, checker, i, test_trans, rot,
+                                 is_identity);
+            distance2 = get_slot_distance2(checker, pos_rot, slot, is_layer);
+            if (distance2 > max_distance2) {
+                max_distance2 = distance2;
             }
+        }
+        if (max_distance != NULL) {
+            *max_distance = sqrt(max_distance2);
+        }
+    }
+    return 1;
+}
+
+/* Finds an augmenting path of the matching between the rotated */
+/* positions and bin_atoms starting from the i_start-th rotated position, */
+/* which is not matched, by depth-first search, i.e., the atoms matched */
+/* along the path are passed over to the next rotated positions until an */
+/* unmatched atom is reached. A matching of all the atoms is thus found */
+/* whenever one exists. The atoms of the type are scanned without the */
+/* cell list, but this is needed only for atoms closer than 2 * symprec. */
+/* 0: No path.  1: The matching is extended. */
+static int rematch_in_cell_list(OverlapChecker *checker, int const i_start,
+                                double const test_trans[3],
+                                int const rot[3][3], double const symprec,
+                                int const is_identity, int const is_layer) {
+    int t, l, depth, slot, first, last;
+    double pos_rot[3];
 
-            if (layer_has_overlap_with_same_type(
-                    pos_original[i_orig], pos_rotated[i_rot],
-                    types_original[i_orig], types_rotated[i_rot], lattice,
-                    periodic_axes, symprec)) {
-                found[i_rot] = 1;
+    t = checker->type_index[i_start];
+    first = checker->bin_start[checker->type_bin_start[t]];
+    last = checker->bin_start[checker->type_bin_start[t + 1]];
+    for (l = first; l < last; l++) {
+        checker->visited_temp[l] = 0;
+    }
+
+    /* path_slots[depth] is the last slot tried for path_atoms[depth]. */
+    depth = 0;
+    checker->path_atoms[0] = i_start;
+    checker->path_slots[0] = first - 1;
+    while (depth >= 0) {
+        get_rotated_position(pos_rot, checker, checker->path_atoms[depth],
+                             test_trans, rot, is_identity);
+        for (slot = checker->path_slots[depth] + 1; slot < last; slot++) {
+            if (!checker->visited_temp[slot] &&
+                get_slot_distance2(checker, pos_rot, slot, is_layer) <=
+                    symprec * symprec) {
                 break;
             }
         }
+        if (slot == last) {
+            depth--;
+            continue;
+        }
+        checker->visited_temp[slot] = 1;
+        checker->path_slots[depth] = slot;
 
-        if (i_rot == num_pos) {
-            /* We never hit the 'break'. */
-            /* Failure; a position in pos_original does not */
-            /* overlap with any position in pos_rotated. */
-            free(found);
-            found = NULL;
-            return 0;
+        if (checker->found_temp[slot] == 0) {
+            for (l = 0; l <= depth; l++) {
+                checker->found_temp[checker->path_slots[l]] =
+                    checker->path_atoms[l] + 1;
+            }
+            return 1;
         }
-    }
 
-    free(found);
-    found = NULL;
+        depth++;
+        checker->path_atoms[depth] = checker->found_temp[slot] - 1;
+        checker->path_slots[depth] = first - 1;
+    }
 
-    /* Success */
-    return 1;
+    return 0;
 }
@@ -32,6 +32,9 @@
 /* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE */
 /* POSSIBILITY OF SUCH DAMAGE. */
 
+#ifndef __overlap_H__
+#define __overlap_H__
+
 #include "cell.h"
 #include "mathfunc.h"
 
@@ -45,32 +48,71 @@ typedef struct {
     void *argsort_work;
     void *blob;
 
-    /* Temp areas for writing stuff. (points into blob) */
-    double (*pos_temp_1)[3];
-    double (*pos_temp_2)[3];
-
     /* Temp area for writing lattice point distances. (points into blob) */
     double *distance_temp; /* for lattice point distances */
     int *perm_temp;        /* for permutations during sort */
+    int *found_temp;       /* for bin_atoms already matched in overlap checks */
+    /* Temp areas for the augmenting paths of the matching. (points into */
+    /* blob) */
+    int *visited_temp; /* for bin_atoms visited in a path */
+    int *path_atoms;   /* sorted atoms in a path */
+    int *path_slots;   /* slots of bin_atoms taken by path_atoms */
 
     /* Sorted data of original cell. (points into blob)*/
     double (*lattice)[3];
     double (*pos_sorted)[3];
     int *types_sorted;
+    int *atom_index; /* index in the original cell of each sorted atom */
+    /* Distances of pos_sorted from the lattice points given by rounding */
+    /* the fractional coordinates. Ascending within each atom type. */
+    double *distance_sorted;
+
+    /* Cell list (spatial hash) of the sorted positions in fractional */
+    /* coordinates, built separately for each atom type. Atoms of the */
+    /* t-th type are pos_sorted[type_start[t]:type_start[t + 1]] and are */
+    /* binned into a type_grid[t] mesh whose bins are numbered from */
+    /* type_bin_start[t]. The atoms in bin b are */
+    /* bin_atoms[bin_start[b]:bin_start[b + 1]]. (points into blob) */
+    int num_types;
+    int *type_index; /* type index of each sorted atom */
+    int *type_start;
+    int (*type_grid)[3];
+    int *type_bin_start;
+    int *bin_start;
+    int *bin_atoms;
+    /* Positions of bin_atoms in structure-of-arrays layout, i.e., */
+    /* bin_pos[k][l] = pos_sorted[bin_atoms[l]][k]. (points into blob) */
+    double *bin_pos[3];
+    /* Norms of reciprocal basis vectors, i.e., rows of lattice^-1 */
+    double *reciprocal_norms;
 
     /* Using array reference to avoid redundant loop */
     int *periodic_axes;
 } OverlapChecker;
 
-OverlapChecker *ovl_overlap_checker_init(Cell const *cell);
+SPG_API_TEST OverlapChecker *ovl_overlap_checker_init(Cell const *cell);
+
+SPG_API_TEST int ovl_check_total_overlap(OverlapChecker *checker,
+                                         double const test_trans[3],
+                                         int const rot[3][3],
+                                         double const symprec,
+                                         int const is_identity);
+
+SPG_API_TEST int ovl_check_layer_total_overlap(OverlapChecker *checker,
+                                               double const test_trans[3],
+                                               int const rot[3][3],
+                                               double const symprec,
+                                               int const is_identity);
+
+SPG_API_TEST int ovl_get_overlap_mapping(
+    int mapping[], double *max_distance, OverlapChecker *checker,
+    double const test_trans[3], int const rot[3][3], double const symprec,
+    int const is_identity, int const is_layer);
 
-int ovl_check_total_overlap(OverlapChecker *checker, double const test_trans[3],
-                            int const rot[3][3], double const symprec,
-                            int const is_identity);
+SPG_API_TEST int ovl_find_overlap(OverlapChecker const *checker,
+                                  double const pos[3], int const type,
+                                  double const symprec, int const is_layer);
 
-int ovl_check_layer_total_overlap(OverlapChecker *checker,
-                                  double const test_trans[3],
-                                  int const rot[3][3], double const symprec,
-                                  int const is_identity);
+SPG_API_TEST void ovl_overlap_checker_free(OverlapChecker *checker);
 
-void ovl_overlap_checker_free(OverlapChecker *checker);
+#endif
@@ -942,6 +942,11 @@ static int lauennn(int axes[3], PointSymmetry const* pointsym,
                 count++;
             }
         }
+        /* Operations found at a reduced tolerance need not form a group */
+        /* and can have more axes. */
+        if (count == 3) {
+            break;
+        }
     }
 
     if (aperiodic_axis == -1) {
@@ -37,6 +37,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "arena.h"
+#include "budget.h"
 #include "cell.h"
 #include "debug.h"
 #include "delaunay.h"
@@ -46,15 +48,20 @@
 #define REDUCE_RATE 0.95
 #define NUM_ATTEMPT 20
 
-static Primitive *get_primitive(Cell const *cell, double const symprec,
+static Primitive *get_primitive(SearchContext *context, double const symprec,
                                 double const angle_tolerance);
+static int get_primitive_with_pure_trans(Primitive *primitive,
+                                         SearchContext *context,
+                                         VecDBL const *pure_trans,
+                                         double const symprec,
+                                         double const angle_tolerance);
 static Cell *get_cell_with_smallest_lattice(Cell const *cell,
                                             double const symprec);
-static Cell *get_primitive_cell(int *mapping_table, Cell const *cell,
+static Cell *get_primitive_cell(int *mapping_table, SearchContext *context,
                                 VecDBL const *pure_trans, double const symprec,
                                 double const angle_tolerance);
 static int get_primitive_lattice_vectors(double prim_lattice[3][3],
-                                         Cell const *cell,
+                                         SearchContext *context,
                                          VecDBL const *pure_trans,
                                          double const symprec,
                                          double const angle_tolerance);
@@ -62,6 +69,16 @@ static int find_primitive_lattice_vectors(double prim_lattice[3][3],
                                           VecDBL const *vectors,
                                           Cell const *cell,
                                           double const symprec);
+static int is_primitive_volume(VecDBL const *vectors, Cell const *cell,
+                               int const i, int const j, int const k,
+                               double const initial_volume,
+                               double const symprec);
+static long long (*get_translation_coordinates(VecDBL const *vectors))[3];
+static long long get_gcd_of_vector(long long const vec[3]);
+static void get_cross_product_ll(long long c[3], long long const a[3],
+                                 long long const b[3]);
+static long long get_dot_product_ll(long long const a[3],
+                                    long long const b[3]);
 static VecDBL *get_translation_candidates(VecDBL const *pure_trans);
 static VecDBL *collect_pure_translations(Symmetry const *symmetry);
 static int get_primitive_in_translation_space(double t_mat[3][3],
@@ -78,7 +95,7 @@ Primitive *prm_alloc_primitive(int const size) {
 
     primitive = NULL;
 
-    if ((primitive = (Primitive *)malloc(sizeof(Primitive))) == NULL) {
+    if ((primitive = (Primitive *)arn_malloc(sizeof(Primitive))) == NULL) {
         warning_memory("primitive");
         return NULL;
     }
@@ -91,10 +108,10 @@ Primitive *prm_alloc_primitive(int const size) {
     primitive->orig_lattice = NULL;
 
     if (size > 0) {
-        if ((primitive->mapping_table = (int *)malloc(sizeof(int) * size)) ==
-            NULL) {
+        if ((primitive->mapping_table =
+                 (int *)arn_malloc(sizeof(int) * size)) == NULL) {
             warning_memory("primitive->mapping_table");
-            free(primitive);
+            arn_free(primitive);
             primitive = NULL;
             return NULL;
         }
@@ -110,7 +127,7 @@ Primitive *prm_alloc_primitive(int const size) {
 void prm_free_primitive(Primitive *primitive) {
     if (primitive != NULL) {
         if (primitive->mapping_table != NULL) {
-            free(primitive->mapping_table);
+            arn_free(primitive->mapping_table);
             primitive->mapping_table = NULL;
         }
 
@@ -120,18 +137,18 @@ void prm_free_primitive(Primitive *primitive) {
         }
 
         if (primitive->orig_lattice != NULL) {
-            free(primitive->orig_lattice);
+            arn_free(primitive->orig_lattice);
             primitive->orig_lattice = NULL;
         }
 
-        free(primitive);
+        arn_free(primitive);
     }
 }
 
 /* Return NULL if failed */
-Primitive *prm_get_primitive(Cell const *cell, double const symprec,
+Primitive *prm_get_primitive(SearchContext *context, double const symprec,
                              double const angle_tolerance) {
-    return get_primitive(cell, symprec, angle_tolerance);
+    return get_primitive(context, symprec, angle_tolerance);
 }
 
 /* Return primitive cell from given pure translations. */
@@ -140,34 +157,19 @@ int prm_get_primitive_with_pure_trans(Primitive *primitive, Cell const *cell,
                                       VecDBL const *pure_trans,
                                       double const symprec,
                                       double const angle_tolerance) {
-    int i;
-
-    if (pure_trans->size == 1) {
-        if ((primitive->cell = get_cell_with_smallest_lattice(cell, symprec)) ==
-            NULL) {
-            return 0;
-        }
-        for (i = 0; i < cell->size; i++) {
-            primitive->mapping_table[i] = i;
-        }
-    } else {
-        if ((primitive->cell =
-                 get_primitive_cell(primitive->mapping_table, cell, pure_trans,
-                                    symprec, angle_tolerance)) == NULL) {
-            return 0;
-        }
-    }
+    int succeeded;
+    SearchContext *context;
 
-    primitive->tolerance = symprec;
-    primitive->angle_tolerance = angle_tolerance;
-    if ((primitive->orig_lattice =
-             (double(*)[3])malloc(sizeof(double[3]) * 3)) == NULL) {
-        warning_memory("primitive->orig_lattice");
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
         return 0;
     }
-    mat_copy_matrix_d3(primitive->orig_lattice, cell->lattice);
 
-    return 1;
+    succeeded = get_primitive_with_pure_trans(primitive, context, pure_trans,
+                                              symprec, angle_tolerance);
+    sym_free_search_context(context);
+    context = NULL;
+
+    return succeeded;
 }
 
 // t_mat transforms primitive cell to conventional:
@@ -233,13 +235,25 @@ Symmetry *prm_get_primitive_symmetry(double t_mat[3][3],
     return prim_symmetry;
 }
 
+/* Return 0 if failed */
 int prm_get_primitive_lattice_vectors(double prim_lattice[3][3],
                                       Cell const *cell,
                                       VecDBL const *pure_trans,
                                       double const symprec,
                                       double const angle_tolerance) {
-    return get_primitive_lattice_vectors(prim_lattice, cell, pure_trans,
-                                         symprec, angle_tolerance);
+    int multi;
+    SearchContext *context;
+
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
+        return 0;
+    }
+
+    multi = get_primitive_lattice_vectors(prim_lattice, context, pure_trans,
+                                          symprec, angle_tolerance);
+    sym_free_search_context(context);
+    context = NULL;
+
+    return multi;
 }
 
 /*=======*/
@@ -247,7 +261,7 @@ int prm_get_primitive_lattice_vectors(double prim_lattice[3][3],
 /*=======*/
 
 /* Return NULL if failed */
-static Primitive *get_primitive(Cell const *cell, double const symprec,
+static Primitive *get_primitive(SearchContext *context, double const symprec,
                                 double const angle_tolerance) {
     int attempt;
     double tolerance;
@@ -259,22 +273,34 @@ static Primitive *get_primitive(Cell const *cell, double const symprec,
     primitive = NULL;
     pure_trans = NULL;
 
-    if ((primitive = prm_alloc_primitive(cell->size)) == NULL) {
+    if ((primitive = prm_alloc_primitive(context->cell->size)) == NULL) {
         goto notfound;
     }
 
+    /* Tolerances that failed in the previous calls with the same context */
+    /* are skipped. */
     tolerance = symprec;
     for (attempt = 0; attempt < NUM_ATTEMPT; attempt++) {
+        if (bdg_is_exceeded()) {
+            break;
+        }
         debug_print("get_primitive (attempt = %d):\n", attempt);
-        if ((pure_trans = sym_get_pure_translation(cell, tolerance)) != NULL) {
-            if (prm_get_primitive_with_pure_trans(primitive, cell, pure_trans,
-                                                  tolerance, angle_tolerance)) {
-                goto found;
+        if (!sym_has_failed(context, SEARCH_STEP_PRIMITIVE, tolerance,
+                            angle_tolerance)) {
+            if ((pure_trans = sym_get_pure_translation(context, tolerance)) !=
+                NULL) {
+                if (get_primitive_with_pure_trans(primitive, context,
+                                                  pure_trans, tolerance,
+                                                  angle_tolerance)) {
+                    goto found;
+                }
             }
-        }
 
-        mat_free_VecDBL(pure_trans);
-        pure_trans = NULL;
+            mat_free_VecDBL(pure_trans);
+            pure_trans = NULL;
+            sym_set_failed(context, SEARCH_STEP_PRIMITIVE, tolerance,
+                           angle_tolerance);
+        }
 
         tolerance *= REDUCE_RATE;
         debug_print("spglib: Reduce tolerance to %f ", tolerance);
@@ -292,6 +318,47 @@ found:
     return primitive;
 }
 
+/* Return primitive cell from given pure translations. */
+/* If failed, return 0. */
+static int get_primitive_with_pure_trans(Primitive *primitive,
+                                         SearchContext *context,
+                                         VecDBL const *pure_trans,
+                                         double const symprec,
+                                         double const angle_tolerance) {
+    int i;
+    Cell const *cell;
+
+    cell = context->cell;
+
+    if (pure_trans->size == 1) {
+        if ((primitive->cell = get_cell_with_smallest_lattice(cell, symprec)) ==
+            NULL) {
+            return 0;
+        }
+        for (i = 0; i < cell->size; i++) {
+            primitive->mapping_table[i] = i;
+        }
+    } else {
+        if ((primitive->cell =
+                 get_primitive_cell(primitive->mapping_table, context,
+                                    pure_trans, symprec, angle_tolerance)) ==
+            NULL) {
+            return 0;
+        }
+    }
+
+    primitive->tolerance = symprec;
+    primitive->angle_tolerance = angle_tolerance;
+    if ((primitive->orig_lattice =
+             (double(*)[3])arn_malloc(sizeof(double[3]) * 3)) == NULL) {
+        warning_memory("primitive->orig_lattice");
+        return 0;
+    }
+    mat_copy_matrix_d3(primitive->orig_lattice, cell->lattice);
+
+    return 1;
+}
+
 /* Return NULL if failed */
 static Cell *get_cell_with_smallest_lattice(Cell const *cell,
                                             double const symprec) {
@@ -339,7 +406,7 @@ static Cell *get_cell_with_smallest_lattice(Cell const *cell,
 }
 
 /* Return NULL if failed */
-static Cell *get_primitive_cell(int *mapping_table, Cell const *cell,
+static Cell *get_primitive_cell(int *mapping_table, SearchContext *context,
                                 VecDBL const *pure_trans, double const symprec,
                                 double const angle_tolerance) {
     int multi;
@@ -353,15 +420,15 @@ static Cell *get_primitive_cell(int *mapping_table, Cell const *cell,
     /* Primitive lattice vectors are searched. */
     /* To be consistent, sometimes tolerance is decreased iteratively. */
     /* The decreased tolerance is stored in 'static double tolerance'. */
-    multi = get_primitive_lattice_vectors(prim_lattice, cell, pure_trans,
+    multi = get_primitive_lattice_vectors(prim_lattice, context, pure_trans,
                                           symprec, angle_tolerance);
     if (!multi) {
         goto not_found;
     }
 
     /* Fit atoms into new primitive cell */
-    if ((primitive_cell = cel_trim_cell(mapping_table, prim_lattice, cell,
-                                        symprec)) == NULL) {
+    if ((primitive_cell = cel_trim_cell(mapping_table, prim_lattice,
+                                        context->cell, symprec)) == NULL) {
         goto not_found;
     }
 
@@ -375,14 +442,16 @@ not_found:
 
 /* Return 0 if failed */
 static int get_primitive_lattice_vectors(double prim_lattice[3][3],
-                                         Cell const *cell,
+                                         SearchContext *context,
                                          VecDBL const *pure_trans,
                                          double const symprec,
                                          double const angle_tolerance) {
     int i, multi, attempt;
     double tolerance;
+    Cell const *cell;
     VecDBL *vectors, *pure_trans_reduced, *tmp_vec;
 
+    cell = context->cell;
     vectors = NULL;
     pure_trans_reduced = NULL;
     tmp_vec = NULL;
@@ -441,7 +510,7 @@ static int get_primitive_lattice_vectors(double prim_lattice[3][3],
             pure_trans_reduced = NULL;
 
             pure_trans_reduced = sym_reduce_pure_translation(
-                cell, tmp_vec, tolerance, angle_tolerance);
+                context, tmp_vec, tolerance, angle_tolerance);
 
             mat_free_VecDBL(tmp_vec);
             tmp_vec = NULL;
@@ -471,15 +540,22 @@ found:
 }
 
 /* Return 0 if failed */
+/* The first triplet of vectors in lexicographic order that spans the */
+/* primitive lattice is searched. The pure translations form a lattice, so */
+/* only triplets of unit determinant in its integer coordinates can span it. */
+/* Vectors and pairs of vectors that cannot be extended to a basis are */
+/* skipped, which leaves the search near-linear in the number of vectors. */
 static int find_primitive_lattice_vectors(double prim_lattice[3][3],
                                           VecDBL const *vectors,
                                           Cell const *cell,
                                           double const symprec) {
     int i, j, k, size, aperiodic_axis;
-    double initial_volume, volume;
-    double relative_lattice[3][3], min_vectors[3][3], tmp_lattice[3][3];
+    double initial_volume;
+    double relative_lattice[3][3], min_vectors[3][3];
     double inv_mat_dbl[3][3];
     int inv_mat_int[3][3];
+    long long cross[3];
+    long long (*coords)[3];
 
     debug_print("find_primitive_lattice_vectors:\n");
 
@@ -487,25 +563,33 @@ static int find_primitive_lattice_vectors(double prim_lattice[3][3],
     initial_volume = mat_Dabs(mat_get_determinant_d3(cell->lattice));
     aperiodic_axis = cell->aperiodic_axis;
 
+    /* NULL if the vectors are not a lattice, then no triplet is skipped. */
+    coords = get_translation_coordinates(vectors);
+
     /* check volumes of all possible lattices, find smallest volume */
     if (aperiodic_axis == -1) {
         for (i = 0; i < size; i++) {
+            if (coords != NULL && get_gcd_of_vector(coords[i]) != 1) {
+                continue;
+            }
             for (j = i + 1; j < size; j++) {
+                if (coords != NULL) {
+                    get_cross_product_ll(cross, coords[i], coords[j]);
+                    if (get_gcd_of_vector(cross) != 1) {
+                        continue;
+                    }
+                }
                 for (k = j + 1; k < size; k++) {
-                    mat_multiply_matrix_vector_d3(tmp_lattice[0], cell->lattice,
-                                                  vectors->vec[i]);
-                    mat_multiply_matrix_vector_d3(tmp_lattice[1], cell->lattice,
-                                                  vectors->vec[j]);
-                    mat_multiply_matrix_vector_d3(tmp_lattice[2], cell->lattice,
-                                                  vectors->vec[k]);
-                    volume = mat_Dabs(mat_get_determinant_d3(tmp_lattice));
-                    if (volume > symprec) {
-                        if (mat_Nint(initial_volume / volume) == size - 2) {
-                            mat_copy_vector_d3(min_vectors[0], vectors->vec[i]);
-                            mat_copy_vector_d3(min_vectors[1], vectors->vec[j]);
-                            mat_copy_vector_d3(min_vectors[2], vectors->vec[k]);
-                            goto ret;
-                        }
+                    if (coords != NULL &&
+                        llabs(get_dot_product_ll(cross, coords[k])) != 1) {
+                        continue;
+                    }
+                    if (is_primitive_volume(vectors, cell, i, j, k,
+                                            initial_volume, symprec)) {
+                        mat_copy_vector_d3(min_vectors[0], vectors->vec[i]);
+                        mat_copy_vector_d3(min_vectors[1], vectors->vec[j]);
+                        mat_copy_vector_d3(min_vectors[2], vectors->vec[k]);
+                        goto ret;
                     }
                 }
             }
@@ -517,41 +601,44 @@ static int find_primitive_lattice_vectors(double prim_lattice[3][3],
         for (i = 0; i < size; i++) {
             for (j = i + 1; j < size; j++) {
                 if (i != k && j != k) {
-                    mat_multiply_matrix_vector_d3(tmp_lattice[0], cell->lattice,
-                                                  vectors->vec[i]);
-                    mat_multiply_matrix_vector_d3(tmp_lattice[1], cell->lattice,
-                                                  vectors->vec[j]);
-                    mat_multiply_matrix_vector_d3(tmp_lattice[2], cell->lattice,
-                                                  vectors->vec[k]);
-                    volume = mat_Dabs(mat_get_determinant_d3(tmp_lattice));
-                    if (volume > symprec) {
-                        if (mat_Nint(initial_volume / volume) == size - 2) {
-                            mat_copy_vector_d3(min_vectors[0], vectors->vec[i]);
-                            mat_copy_vector_d3(min_vectors[1], vectors->vec[j]);
-                            /* move aperiodic axis back */
-                            if (aperiodic_axis == 2) {
-                                mat_copy_vector_d3(min_vectors[2],
-                                                   vectors->vec[k]);
-                            } else {
-                                mat_copy_vector_d3(min_vectors[2],
-                                                   min_vectors[aperiodic_axis]);
-                                mat_copy_vector_d3(min_vectors[aperiodic_axis],
-                                                   vectors->vec[k]);
-                            }
-                            goto ret;
+                    if (coords != NULL) {
+                        get_cross_product_ll(cross, coords[i], coords[j]);
+                        if (llabs(get_dot_product_ll(cross, coords[k])) != 1) {
+                            continue;
                         }
                     }
+                    if (is_primitive_volume(vectors, cell, i, j, k,
+                                            initial_volume, symprec)) {
+                        mat_copy_vector_d3(min_vectors[0], vectors->vec[i]);
+                        mat_copy_vector_d3(min_vectors[1], vectors->vec[j]);
+                        /* move aperiodic axis back */
+                        if (aperiodic_axis == 2) {
+                            mat_copy_vector_d3(min_vectors[2], vectors->vec[k]);
+                        } else {
+                            mat_copy_vector_d3(min_vectors[2],
+                                               min_vectors[aperiodic_axis]);
+                            mat_copy_vector_d3(min_vectors[aperiodic_axis],
+                                               vectors->vec[k]);
+                        }
+                        goto ret;
+                    }
                 }
             }
         }
     }
 
+    arn_free(coords);
+    coords = NULL;
+
     /* Not found */
     debug_print("spglib: Primitive lattice vectors could not be found\n");
     return 0;
 
     /* Found */
 ret:
+    arn_free(coords);
+    coords = NULL;
+
     for (i = 0; i < 3; i++) {
         for (j = 0; j < 3; j++) {
             relative_lattice[j][i] = min_vectors[i][j];
@@ -571,6 +658,113 @@ ret:
     return 1;
 }
 
+/* Return 1 if the triplet spans a cell of 1/multi of the volume. */
+static int is_primitive_volume(VecDBL const *vectors, Cell const *cell,
+                               int const i, int const j, int const k,
+                               double const initial_volume,
+                               double const symprec) {
+    double volume;
+    double tmp_lattice[3][3];
+
+    mat_multiply_matrix_vector_d3(tmp_lattice[0], cell->lattice,
+                                  vectors->vec[i]);
+    mat_multiply_matrix_vector_d3(tmp_lattice[1], cell->lattice,
+                                  vectors->vec[j]);
+    mat_multiply_matrix_vector_d3(tmp_lattice[2], cell->lattice,
+                                  vectors->vec[k]);
+    volume = mat_Dabs(mat_get_determinant_d3(tmp_lattice));
+    return volume > symprec &&
+           mat_Nint(initial_volume / volume) == vectors->size - 2;
+}
+
+/* Return integer coordinates of the vectors in a basis of the lattice */
+/* they generate. The vectors are pure translations and the three lattice */
+/* translations, so multi times them are integers. Their lattice contains */
+/* multi * I, from which its Hermite normal form is built. */
+/* Return NULL if failed or if the vectors do not form a lattice of */
+/* multi points in the unit cell. */
+static long long (*get_translation_coordinates(VecDBL const *vectors))[3] {
+    int i, j;
+    long long multi, rest;
+    long long hnf[3][3], vec[3];
+    long long (*coords)[3];
+
+    multi = vectors->size - 2;
+
+    /* Not to overflow in mat_add_to_hermite_basis */
+    if (multi > 1000000) {
+        return NULL;
+    }
+
+    if ((coords = (long long (*)[3])arn_malloc(sizeof(long long[3]) *
+                                           vectors->size)) == NULL) {
+        warning_memory("coords");
+        return NULL;
+    }
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            hnf[i][j] = (i == j) ? multi : 0;
+        }
+    }
+
+    for (i = 0; i < vectors->size; i++) {
+        for (j = 0; j < 3; j++) {
+            coords[i][j] = mat_Nint(multi * vectors->vec[i][j]);
+        }
+        mat_add_to_hermite_basis(hnf, coords[i], multi);
+    }
+
+    /* The lattice of multi points has the determinant of multi**2. */
+    if (multi * multi % (hnf[0][0] * hnf[1][1]) != 0 ||
+        multi * multi / (hnf[0][0] * hnf[1][1]) != hnf[2][2]) {
+        goto fail;
+    }
+
+    /* Solve coords = x * hnf row by row. */
+    for (i = 0; i < vectors->size; i++) {
+        for (j = 0; j < 3; j++) {
+            rest = coords[i][j];
+            if (j > 0) {
+                rest -= vec[0] * hnf[0][j];
+            }
+            if (j > 1) {
+                rest -= vec[1] * hnf[1][j];
+            }
+            if (rest % hnf[j][j] != 0) {
+                goto fail;
+            }
+            vec[j] = rest / hnf[j][j];
+        }
+        for (j = 0; j < 3; j++) {
+            coords[i][j] = vec[j];
+        }
+    }
+
+    return coords;
+
+fail:
+    arn_free(coords);
+    coords = NULL;
+    return NULL;
+}
+
+static long long get_gcd_of_vector(long long const vec[3]) {
+    return mat_get_gcd(mat_get_gcd(vec[0], vec[1]), vec[2]);
+}
+
+static void get_cross_product_ll(long long c[3], long long const a[3],
+                                 long long const b[3]) {
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static long long get_dot_product_ll(long long const a[3],
+                                    long long const b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
 static VecDBL *get_translation_candidates(VecDBL const *pure_trans) {
     int i, j, multi;
     VecDBL *vectors;
@@ -647,9 +841,11 @@ static int get_primitive_in_translation_space(double t_mat_inv[3][3],
     int i, j, primsym_size;
     Primitive *primitive;
     Cell *cell;
+    SearchContext *context;
 
     cell = NULL;
     primitive = NULL;
+    context = NULL;
 
     if ((cell = cel_alloc_cell(pure_trans->size, NOSPIN)) == NULL) {
         return 0;
@@ -679,7 +875,15 @@ static int get_primitive_in_translation_space(double t_mat_inv[3][3],
         }
     }
 
-    primitive = get_primitive(cell, symprec, -1.0);
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
+        cel_free_cell(cell);
+        cell = NULL;
+        return 0;
+    }
+
+    primitive = get_primitive(context, symprec, -1.0);
+    sym_free_search_context(context);
+    context = NULL;
     cel_free_cell(cell);
     cell = NULL;
 
@@ -49,9 +49,10 @@ typedef struct {
 } Primitive;
 
 Primitive *prm_alloc_primitive(int const size);
-void prm_free_primitive(Primitive *primitive);
-Primitive *prm_get_primitive(Cell const *cell, double const symprec,
-                             double const angle_tolerance);
+SPG_API_TEST void prm_free_primitive(Primitive *primitive);
+SPG_API_TEST Primitive *prm_get_primitive(SearchContext *context,
+                                          double const symprec,
+                                          double const angle_tolerance);
 int prm_get_primitive_with_pure_trans(Primitive *primitive, Cell const *cell,
                                       VecDBL const *pure_trans,
                                       double const symprec,
@@ -40,6 +40,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "arena.h"
 #include "cell.h"
 #include "debug.h"
 #include "hall_symbol.h"
@@ -79,7 +80,8 @@ static void set_trigo(double lattice[3][3], double const metric[3][3]);
 static void set_rhomb(double lattice[3][3], double const metric[3][3]);
 static void set_cubic(double lattice[3][3], double const metric[3][3]);
 
-static Symmetry *get_refined_symmetry_operations(Cell const *cell,
+static Symmetry *get_refined_symmetry_operations(VecDBL **pure_trans,
+                                                 Cell const *cell,
                                                  Cell const *primitive,
                                                  Spacegroup const *spacegroup,
                                                  double const symprec);
@@ -106,13 +108,11 @@ static int search_layer_equivalent_atom(int const atom_index, Cell const *cell,
                                         int const periodic_axes[2],
                                         double const symprec);
 static Symmetry *recover_symmetry_in_original_cell(
-    Symmetry const *prim_sym, int const t_mat[3][3], double const lattice[3][3],
-    int const multiplicity, int const aperiodic_axis, double const symprec);
-static VecDBL *get_lattice_translations(int const frame[3],
-                                        double const inv_tmat[3][3]);
-static VecDBL *remove_overlapping_lattice_points(double const lattice[3][3],
-                                                 VecDBL const *lattice_trans,
-                                                 double const symprec);
+    VecDBL **pure_trans, Symmetry const *prim_sym, int const t_mat[3][3],
+    double const lattice[3][3], int const multiplicity,
+    int const aperiodic_axis, double const symprec);
+static VecDBL *get_lattice_points(int const t_mat[3][3], int const frame[3],
+                                  double const inv_tmat[3][3]);
 static Symmetry *get_symmetry_in_original_cell(int const t_mat[3][3],
                                                double const inv_tmat[3][3],
                                                double const lattice[3][3],
@@ -134,17 +134,19 @@ static int const identity[3][3] = {
 
 /* Return NULL if failed */
 /* spacegroup->bravais_lattice and spacegroup->origin_shift are overwritten */
-/* by refined ones. */
+/* by refined ones. Only the parts up to level are kept, and the others */
+/* are left NULL. */
 ExactStructure *ref_get_exact_structure_and_symmetry(Spacegroup *spacegroup,
                                                      Cell const *primitive,
                                                      Cell const *cell,
                                                      int const *mapping_table,
+                                                     RefineLevel const level,
                                                      double const symprec) {
     int *std_mapping_to_primitive, *wyckoffs, *equivalent_atoms;
     int *crystallographic_orbits;
-    double rotation[3][3];
     Cell *bravais;
     Symmetry *symmetry;
+    VecDBL *pure_trans;
     ExactStructure *exact_structure;
     char(*site_symmetry_symbols)[7];
 
@@ -155,41 +157,43 @@ ExactStructure *ref_get_exact_structure_and_symmetry(Spacegroup *spacegroup,
     crystallographic_orbits = NULL;
     bravais = NULL;
     symmetry = NULL;
+    pure_trans = NULL;
     exact_structure = NULL;
 
     if (!ref_find_similar_bravais_lattice(spacegroup, symprec)) {
         goto err;
     }
 
-    if ((symmetry = get_refined_symmetry_operations(cell, primitive, spacegroup,
-                                                    symprec)) == NULL) {
+    if ((symmetry = get_refined_symmetry_operations(
+             &pure_trans, cell, primitive, spacegroup, symprec)) == NULL) {
         goto err;
     }
 
-    if ((wyckoffs = (int *)malloc(sizeof(int) * cell->size)) == NULL) {
+    if ((wyckoffs = (int *)arn_malloc(sizeof(int) * cell->size)) == NULL) {
         warning_memory("wyckoffs");
         goto err;
     }
 
     if ((site_symmetry_symbols =
-             (char(*)[7])malloc(sizeof(char[7]) * cell->size)) == NULL) {
+             (char(*)[7])arn_malloc(sizeof(char[7]) * cell->size)) == NULL) {
         warning_memory("site_symmetry_symbols");
         goto err;
     }
 
-    if ((equivalent_atoms = (int *)malloc(sizeof(int) * cell->size)) == NULL) {
+    if ((equivalent_atoms = (int *)arn_malloc(sizeof(int) * cell->size)) ==
+        NULL) {
         warning_memory("equivalent_atoms");
         goto err;
     }
 
-    if ((crystallographic_orbits = (int *)malloc(sizeof(int) * cell->size)) ==
-        NULL) {
+    if ((crystallographic_orbits =
+             (int *)arn_malloc(sizeof(int) * cell->size)) == NULL) {
         warning_memory("crystallographic_orbits");
         goto err;
     }
 
     if ((std_mapping_to_primitive =
-             (int *)malloc(sizeof(int) * primitive->size * 4)) == NULL) {
+             (int *)arn_malloc(sizeof(int) * primitive->size * 4)) == NULL) {
         warning_memory("std_mapping_to_primitive");
         goto err;
     }
@@ -198,54 +202,88 @@ ExactStructure *ref_get_exact_structure_and_symmetry(Spacegroup *spacegroup,
              wyckoffs, site_symmetry_symbols, equivalent_atoms,
              crystallographic_orbits, std_mapping_to_primitive, primitive, cell,
              spacegroup, symmetry, mapping_table, symprec)) == NULL) {
-        sym_free_symmetry(symmetry);
-        symmetry = NULL;
         goto err;
     }
 
-    if ((exact_structure = (ExactStructure *)malloc(sizeof(ExactStructure))) ==
-        NULL) {
-        warning_memory("exact_structure");
-        sym_free_symmetry(symmetry);
-        symmetry = NULL;
+    /* The steps are the same at every level, so that they fail, and a */
+    /* smaller tolerance is tried, in the same cases. Only the parts up to */
+    /* level are kept. */
+    if (level < REFINE_POSITIONS) {
         cel_free_cell(bravais);
         bravais = NULL;
+        arn_free(wyckoffs);
+        wyckoffs = NULL;
+        arn_free(site_symmetry_symbols);
+        site_symmetry_symbols = NULL;
+        arn_free(equivalent_atoms);
+        equivalent_atoms = NULL;
+        arn_free(crystallographic_orbits);
+        crystallographic_orbits = NULL;
+        arn_free(std_mapping_to_primitive);
+        std_mapping_to_primitive = NULL;
+    }
+    if (level < REFINE_SYMMETRY) {
+        sym_free_symmetry(symmetry);
+        symmetry = NULL;
+        mat_free_VecDBL(pure_trans);
+        pure_trans = NULL;
+    }
+
+    if ((exact_structure =
+             (ExactStructure *)arn_malloc(sizeof(ExactStructure))) == NULL) {
+        warning_memory("exact_structure");
         goto err;
     }
 
-    measure_rigid_rotation(rotation, spacegroup->bravais_lattice,
-                           bravais->lattice);
+    if (bravais != NULL) {
+        measure_rigid_rotation(exact_structure->rotation,
+                               spacegroup->bravais_lattice, bravais->lattice);
+    } else {
+        mat_cast_matrix_3i_to_3d(exact_structure->rotation, identity);
+    }
 
     exact_structure->bravais = bravais;
     exact_structure->symmetry = symmetry;
+    exact_structure->pure_trans = pure_trans;
     exact_structure->wyckoffs = wyckoffs;
     exact_structure->site_symmetry_symbols = site_symmetry_symbols;
     exact_structure->equivalent_atoms = equivalent_atoms;
     exact_structure->crystallographic_orbits = crystallographic_orbits;
     exact_structure->std_mapping_to_primitive = std_mapping_to_primitive;
-    mat_copy_matrix_d3(exact_structure->rotation, rotation);
 
     return exact_structure;
 
 err:
+    if (bravais != NULL) {
+        cel_free_cell(bravais);
+        bravais = NULL;
+    }
+    if (symmetry != NULL) {
+        sym_free_symmetry(symmetry);
+        symmetry = NULL;
+    }
+    if (pure_trans != NULL) {
+        mat_free_VecDBL(pure_trans);
+        pure_trans = NULL;
+    }
     if (wyckoffs != NULL) {
-        free(wyckoffs);
+        arn_free(wyckoffs);
         wyckoffs = NULL;
     }
     if (site_symmetry_symbols != NULL) {
-        free(site_symmetry_symbols);
+        arn_free(site_symmetry_symbols);
         site_symmetry_symbols = NULL;
     }
     if (equivalent_atoms != NULL) {
-        free(equivalent_atoms);
+        arn_free(equivalent_atoms);
         equivalent_atoms = NULL;
     }
     if (crystallographic_orbits != NULL) {
-        free(crystallographic_orbits);
+        arn_free(crystallographic_orbits);
         crystallographic_orbits = NULL;
     }
     if (std_mapping_to_primitive != NULL) {
-        free(std_mapping_to_primitive);
+        arn_free(std_mapping_to_primitive);
         std_mapping_to_primitive = NULL;
     }
 
@@ -258,32 +296,36 @@ void ref_free_exact_structure(ExactStructure *exstr) {
             sym_free_symmetry(exstr->symmetry);
             exstr->symmetry = NULL;
         }
+        if (exstr->pure_trans != NULL) {
+            mat_free_VecDBL(exstr->pure_trans);
+            exstr->pure_trans = NULL;
+        }
         if (exstr->bravais != NULL) {
             cel_free_cell(exstr->bravais);
             exstr->bravais = NULL;
         }
         if (exstr->wyckoffs != NULL) {
-            free(exstr->wyckoffs);
+            arn_free(exstr->wyckoffs);
             exstr->wyckoffs = NULL;
         }
         if (exstr->equivalent_atoms != NULL) {
-            free(exstr->equivalent_atoms);
+            arn_free(exstr->equivalent_atoms);
             exstr->equivalent_atoms = NULL;
         }
         // CAUSES CORRUPTED DOUBLE LINKED LIST
         if (exstr->crystallographic_orbits != NULL) {
-            free(exstr->crystallographic_orbits);
+            arn_free(exstr->crystallographic_orbits);
             exstr->crystallographic_orbits = NULL;
         }
         if (exstr->std_mapping_to_primitive != NULL) {
-            free(exstr->std_mapping_to_primitive);
+            arn_free(exstr->std_mapping_to_primitive);
             exstr->std_mapping_to_primitive = NULL;
         }
         if (exstr->site_symmetry_symbols != NULL) {
-            free(exstr->site_symmetry_symbols);
+            arn_free(exstr->site_symmetry_symbols);
             exstr->site_symmetry_symbols = NULL;
         }
-        free(exstr);
+        arn_free(exstr);
     }
 }
 
@@ -306,26 +348,26 @@ static Cell *get_Wyckoff_positions(
     site_symmetry_symbols_bravais = NULL;
     equiv_atoms_bravais = NULL;
 
-    if ((wyckoffs_bravais = (int *)malloc(sizeof(int) * primitive->size * 4)) ==
-        NULL) {
+    if ((wyckoffs_bravais =
+             (int *)arn_malloc(sizeof(int) * primitive->size * 4)) == NULL) {
         warning_memory("wyckoffs_bravais");
         return NULL;
     }
 
-    if ((site_symmetry_symbols_bravais = (char(*)[7])malloc(
+    if ((site_symmetry_symbols_bravais = (char(*)[7])arn_malloc(
              sizeof(char[7]) * primitive->size * 4)) == NULL) {
         warning_memory("site_symmetry_symbols_bravais");
-        free(wyckoffs_bravais);
+        arn_free(wyckoffs_bravais);
         wyckoffs_bravais = NULL;
         return NULL;
     }
 
     if ((equiv_atoms_bravais =
-             (int *)malloc(sizeof(int) * primitive->size * 4)) == NULL) {
+             (int *)arn_malloc(sizeof(int) * primitive->size * 4)) == NULL) {
         warning_memory("equiv_atoms_bravais");
-        free(wyckoffs_bravais);
+        arn_free(wyckoffs_bravais);
         wyckoffs_bravais = NULL;
-        free(site_symmetry_symbols_bravais);
+        arn_free(site_symmetry_symbols_bravais);
         site_symmetry_symbols_bravais = NULL;
         return NULL;
     }
@@ -379,11 +421,11 @@ static Cell *get_Wyckoff_positions(
     }
 
 ret:
-    free(equiv_atoms_bravais);
+    arn_free(equiv_atoms_bravais);
     equiv_atoms_bravais = NULL;
-    free(site_symmetry_symbols_bravais);
+    arn_free(site_symmetry_symbols_bravais);
     site_symmetry_symbols_bravais = NULL;
-    free(wyckoffs_bravais);
+    arn_free(wyckoffs_bravais);
     wyckoffs_bravais = NULL;
 
     return bravais;
@@ -413,26 +455,27 @@ static Cell *get_bravais_exact_positions_and_lattice(
     exact_positions = NULL;
 
     /* Symmetrize atomic positions of conventional unit cell */
-    if ((wyckoffs_prim = (int *)malloc(sizeof(int) * primitive->size)) ==
+    if ((wyckoffs_prim = (int *)arn_malloc(sizeof(int) * primitive->size)) ==
         NULL) {
         warning_memory("wyckoffs_prim");
         return NULL;
     }
 
     if ((site_symmetry_symbols_prim =
-             (char(*)[7])malloc(sizeof(char[7]) * primitive->size)) == NULL) {
+             (char(*)[7])arn_malloc(sizeof(char[7]) * primitive->size)) ==
+        NULL) {
         warning_memory("site_symmetry_symbols_prim");
-        free(wyckoffs_prim);
+        arn_free(wyckoffs_prim);
         wyckoffs_prim = NULL;
         return NULL;
     }
 
-    if ((equiv_atoms_prim = (int *)malloc(sizeof(int) * primitive->size)) ==
+    if ((equiv_atoms_prim = (int *)arn_malloc(sizeof(int) * primitive->size)) ==
         NULL) {
         warning_memory("equiv_atoms_prim");
-        free(site_symmetry_symbols_prim);
+        arn_free(site_symmetry_symbols_prim);
         site_symmetry_symbols_prim = NULL;
-        free(wyckoffs_prim);
+        arn_free(wyckoffs_prim);
         wyckoffs_prim = NULL;
         return NULL;
     }
@@ -448,11 +491,11 @@ static Cell *get_bravais_exact_positions_and_lattice(
     /* Positions of primitive atoms are represented wrt Bravais lattice */
     if ((conv_prim = get_conventional_primitive(spacegroup, primitive)) ==
         NULL) {
-        free(wyckoffs_prim);
+        arn_free(wyckoffs_prim);
         wyckoffs_prim = NULL;
-        free(equiv_atoms_prim);
+        arn_free(equiv_atoms_prim);
         equiv_atoms_prim = NULL;
-        free(site_symmetry_symbols_prim);
+        arn_free(site_symmetry_symbols_prim);
         site_symmetry_symbols_prim = NULL;
         return NULL;
     }
@@ -496,11 +539,11 @@ static Cell *get_bravais_exact_positions_and_lattice(
     sym_free_symmetry(conv_sym);
     conv_sym = NULL;
 err:
-    free(wyckoffs_prim);
+    arn_free(wyckoffs_prim);
     wyckoffs_prim = NULL;
-    free(equiv_atoms_prim);
+    arn_free(equiv_atoms_prim);
     equiv_atoms_prim = NULL;
-    free(site_symmetry_symbols_prim);
+    arn_free(site_symmetry_symbols_prim);
     site_symmetry_symbols_prim = NULL;
     cel_free_cell(conv_prim);
     conv_prim = NULL;
@@ -864,8 +907,10 @@ static void set_cubic(double lattice[3][3], double const metric[3][3]) {
     lattice[2][2] = (a + b + c) / 3;
 }
 
-/* Return NULL if failed */
-static Symmetry *get_refined_symmetry_operations(Cell const *cell,
+/* The lattice points of the primitive cell in the input cell are */
+/* returned in pure_trans. Return NULL if failed */
+static Symmetry *get_refined_symmetry_operations(VecDBL **pure_trans,
+                                                 Cell const *cell,
                                                  Cell const *primitive,
                                                  Spacegroup const *spacegroup,
                                                  double const symprec) {
@@ -902,8 +947,8 @@ static Symmetry *get_refined_symmetry_operations(Cell const *cell,
     mat_cast_matrix_3d_to_3i(t_mat_int, t_mat);
 
     symmetry = recover_symmetry_in_original_cell(
-        prim_sym, t_mat_int, cell->lattice, cell->size / primitive->size,
-        cell->aperiodic_axis, symprec);
+        pure_trans, prim_sym, t_mat_int, cell->lattice,
+        cell->size / primitive->size, cell->aperiodic_axis, symprec);
 
     sym_free_symmetry(prim_sym);
     prim_sym = NULL;
@@ -920,7 +965,8 @@ static int set_crystallographic_orbits(int *equiv_atoms_cell,
 
     equiv_atoms = NULL;
 
-    if ((equiv_atoms = (int *)malloc(sizeof(int) * primitive->size)) == NULL) {
+    if ((equiv_atoms = (int *)arn_malloc(sizeof(int) * primitive->size)) ==
+        NULL) {
         warning_memory("equiv_atoms");
         return 0;
     }
@@ -937,7 +983,7 @@ static int set_crystallographic_orbits(int *equiv_atoms_cell,
         equiv_atoms_cell[i] = equiv_atoms[mapping_table[i]];
     }
 
-    free(equiv_atoms);
+    arn_free(equiv_atoms);
     equiv_atoms = NULL;
 
     return 1;
@@ -1176,138 +1222,159 @@ static void get_corners(int corners[3][8], int const t_mat[3][3]) {
     }
 }
 
+/* The lattice points are returned in pure_trans when succeeded. */
 static Symmetry *recover_symmetry_in_original_cell(
-    Symmetry const *prim_sym, int const t_mat[3][3], double const lattice[3][3],
-    int const multiplicity, int const aperiodic_axis, double const symprec) {
+    VecDBL **pure_trans, Symmetry const *prim_sym, int const t_mat[3][3],
+    double const lattice[3][3], int const multiplicity,
+    int const aperiodic_axis, double const symprec) {
     Symmetry *symmetry, *t_sym;
     int frame[3];
     double inv_tmat[3][3], tmp_mat[3][3];
-    VecDBL *pure_trans, *lattice_trans;
+    VecDBL *lattice_points;
 
     symmetry = NULL;
     t_sym = NULL;
-    pure_trans = NULL;
-    lattice_trans = NULL;
+    lattice_points = NULL;
 
     get_surrounding_frame(frame, t_mat);
     mat_cast_matrix_3i_to_3d(tmp_mat, t_mat);
     mat_inverse_matrix_d3(inv_tmat, tmp_mat, 0);
 
-    if ((lattice_trans = get_lattice_translations(frame, inv_tmat)) == NULL) {
-        return NULL;
-    }
-
-    if ((pure_trans = remove_overlapping_lattice_points(lattice, lattice_trans,
-                                                        symprec)) == NULL) {
-        mat_free_VecDBL(lattice_trans);
-        lattice_trans = NULL;
+    if ((lattice_points = get_lattice_points(t_mat, frame, inv_tmat)) ==
+        NULL) {
         return NULL;
     }
 
     if ((t_sym = get_symmetry_in_original_cell(t_mat, inv_tmat, lattice,
                                                prim_sym, symprec)) == NULL) {
-        mat_free_VecDBL(pure_trans);
-        pure_trans = NULL;
-        mat_free_VecDBL(lattice_trans);
-        lattice_trans = NULL;
+        mat_free_VecDBL(lattice_points);
+        lattice_points = NULL;
         return NULL;
     }
 
-    if (pure_trans->size == multiplicity) {
-        symmetry = copy_symmetry_upon_lattice_points(pure_trans, t_sym,
+    if (lattice_points->size == multiplicity) {
+        symmetry = copy_symmetry_upon_lattice_points(lattice_points, t_sym,
                                                      aperiodic_axis);
     }
 
-    mat_free_VecDBL(lattice_trans);
-    lattice_trans = NULL;
-    mat_free_VecDBL(pure_trans);
-    pure_trans = NULL;
     sym_free_symmetry(t_sym);
     t_sym = NULL;
 
+    if (symmetry == NULL) {
+        mat_free_VecDBL(lattice_points);
+        lattice_points = NULL;
+        return NULL;
+    }
+
+    *pure_trans = lattice_points;
+
     return symmetry;
 }
 
+/* Lattice points of the primitive cell in the original cell are collected */
+/* from the surrounding frame in the order of their first appearance. */
+/* Integer points n and n' of the frame are the same lattice point when */
+/* n - n' is in the lattice spanned by the columns of t_mat. This is */
+/* decided by reducing n with the Hermite normal form of that lattice, */
+/* which leaves |det(t_mat)| distinct remainders. */
 /* Return NULL if failed */
-static VecDBL *get_lattice_translations(int const frame[3],
-                                        double const inv_tmat[3][3]) {
-    int i, j, k, l, num_trans;
-    VecDBL *lattice_trans;
+static VecDBL *get_lattice_points(int const t_mat[3][3], int const frame[3],
+                                  double const inv_tmat[3][3]) {
+    int i, j, k, l, m, num_points;
+    long long det, q, index;
+    long long hnf[3][3], column[3], point[3];
+    char *is_found;
+    VecDBL *lattice_points, *points;
+
+    is_found = NULL;
+    lattice_points = NULL;
+    points = NULL;
+
+    det = llabs((long long)mat_get_determinant_i3(t_mat));
+    if (det == 0) {
+        return NULL;
+    }
 
-    lattice_trans = NULL;
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            hnf[i][j] = (i == j) ? det : 0;
+        }
+    }
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            column[j] = t_mat[j][i];
+        }
+        mat_add_to_hermite_basis(hnf, column, det);
+    }
 
-    if ((lattice_trans = mat_alloc_VecDBL(frame[0] * frame[1] * frame[2])) ==
-        NULL) {
+    if ((is_found = (char *)arn_calloc(det, sizeof(char))) == NULL) {
+        warning_memory("is_found");
         return NULL;
     }
 
-    num_trans = 0;
+    if ((points = mat_alloc_VecDBL(det)) == NULL) {
+        goto ret;
+    }
+
+    num_points = 0;
     for (i = 0; i < frame[0]; i++) {
         for (j = 0; j < frame[1]; j++) {
             for (k = 0; k < frame[2]; k++) {
-                lattice_trans->vec[num_trans][0] = i;
-                lattice_trans->vec[num_trans][1] = j;
-                lattice_trans->vec[num_trans][2] = k;
+                point[0] = i;
+                point[1] = j;
+                point[2] = k;
+                for (l = 0; l < 3; l++) {
+                    q = point[l] / hnf[l][l];
+                    if (point[l] - q * hnf[l][l] < 0) {
+                        q--;
+                    }
+                    for (m = l; m < 3; m++) {
+                        point[m] -= q * hnf[l][m];
+                    }
+                }
+                index =
+                    (point[0] * hnf[1][1] + point[1]) * hnf[2][2] + point[2];
+                if (is_found[index]) {
+                    continue;
+                }
+                is_found[index] = 1;
+
+                points->vec[num_points][0] = i;
+                points->vec[num_points][1] = j;
+                points->vec[num_points][2] = k;
 
                 /* t' = T^-1*t */
-                mat_multiply_matrix_vector_d3(lattice_trans->vec[num_trans],
-                                              inv_tmat,
-                                              lattice_trans->vec[num_trans]);
+                mat_multiply_matrix_vector_d3(points->vec[num_points], inv_tmat,
+                                              points->vec[num_points]);
                 for (l = 0; l < 3; l++) {
-                    lattice_trans->vec[num_trans][l] =
-                        mat_Dmod1(lattice_trans->vec[num_trans][l]);
+                    points->vec[num_points][l] =
+                        mat_Dmod1(points->vec[num_points][l]);
+                }
+                num_points++;
+                if (num_points == det) {
+                    goto found;
                 }
-                num_trans++;
             }
         }
     }
 
-    return lattice_trans;
-}
-
-static VecDBL *remove_overlapping_lattice_points(double const lattice[3][3],
-                                                 VecDBL const *lattice_trans,
-                                                 double const symprec) {
-    int i, j, is_found, num_pure_trans;
-    VecDBL *pure_trans, *t;
-
-    pure_trans = NULL;
-    t = NULL;
-
-    num_pure_trans = 0;
-
-    if ((t = mat_alloc_VecDBL(lattice_trans->size)) == NULL) {
-        return NULL;
-    }
-
-    for (i = 0; i < lattice_trans->size; i++) {
-        is_found = 0;
-        for (j = 0; j < num_pure_trans; j++) {
-            if (cel_is_overlap(lattice_trans->vec[i], t->vec[j], lattice,
-                               symprec)) {
-                is_found = 1;
-                break;
-            }
-        }
-        if (!is_found) {
-            mat_copy_vector_d3(t->vec[num_pure_trans], lattice_trans->vec[i]);
-            num_pure_trans++;
-        }
+found:
+    if ((lattice_points = mat_alloc_VecDBL(num_points)) == NULL) {
+        goto ret;
     }
-
-    if ((pure_trans = mat_alloc_VecDBL(num_pure_trans)) == NULL) {
-        mat_free_VecDBL(t);
-        t = NULL;
-        return NULL;
+    for (i = 0; i < num_points; i++) {
+        mat_copy_vector_d3(lattice_points->vec[i], points->vec[i]);
     }
 
-    for (i = 0; i < num_pure_trans; i++) {
-        mat_copy_vector_d3(pure_trans->vec[i], t->vec[i]);
+ret:
+    if (points != NULL) {
+        mat_free_VecDBL(points);
+        points = NULL;
     }
-    mat_free_VecDBL(t);
-    t = NULL;
+    arn_free(is_found);
+    is_found = NULL;
 
-    return pure_trans;
+    return lattice_points;
 }
 
 /* Return NULL if failed */
@@ -1375,6 +1442,10 @@ static Symmetry *get_symmetry_in_original_cell(int const t_mat[3][3],
     return t_sym;
 }
 
+/* The operations are ordered as (R_j, t_j + p_i) at i * size_sym_orig + j */
+/* for the lattice points p_i, where p_0 = 0. The first size_sym_orig */
+/* operations are the coset representatives, from which the others are */
+/* made with the same arithmetic as spg_expand_dataset_operations. */
 /* Return NULL if failed */
 static Symmetry *copy_symmetry_upon_lattice_points(VecDBL const *pure_trans,
                                                    Symmetry const *t_sym,
@@ -1391,18 +1462,28 @@ static Symmetry *copy_symmetry_upon_lattice_points(VecDBL const *pure_trans,
         return NULL;
     }
 
-    for (i = 0; i < pure_trans->size; i++) {
+    for (j = 0; j < size_sym_orig; j++) {
+        mat_copy_matrix_i3(symmetry->rot[j], t_sym->rot[j]);
+        for (k = 0; k < 3; k++) {
+            symmetry->trans[j][k] = t_sym->trans[j][k] + pure_trans->vec[0][k];
+            if (k != aperiodic_axis) {
+                symmetry->trans[j][k] = mat_Dmod1(symmetry->trans[j][k]);
+            }
+        }
+    }
+
+    for (i = 1; i < pure_trans->size; i++) {
         for (j = 0; j < size_sym_orig; j++) {
             mat_copy_matrix_i3(symmetry->rot[size_sym_orig * i + j],
                                t_sym->rot[j]);
-            mat_copy_vector_d3(symmetry->trans[size_sym_orig * i + j],
-                               t_sym->trans[j]);
             for (k = 0; k < 3; k++) {
-                symmetry->trans[size_sym_orig * i + j][k] +=
-                    pure_trans->vec[i][k];
-                if (k != aperiodic_axis) {
-                    symmetry->trans[size_sym_orig * i + j][k] =
-                        mat_Dmod1(symmetry->trans[size_sym_orig * i + j][k]);
+                symmetry->trans[size_sym_orig * i + j][k] =
+                    symmetry->trans[j][k] + pure_trans->vec[i][k];
+                /* Zero components, e.g., along the aperiodic axis, are */
+                /* not reduced. */
+                if (pure_trans->vec[i][k] != 0) {
+                    symmetry->trans[size_sym_orig * i + j][k] = mat_Dmod1(
+                        symmetry->trans[size_sym_orig * i + j][k]);
                 }
             }
         }
@@ -42,6 +42,7 @@
 typedef struct {
     Cell *bravais;
     Symmetry *symmetry;
+    VecDBL *pure_trans;
     int *wyckoffs;
     char (*site_symmetry_symbols)[7];
     int *equivalent_atoms;
@@ -50,10 +51,19 @@ typedef struct {
     double rotation[3][3];
 } ExactStructure;
 
+/* Parts of ExactStructure to be kept. Each level includes the preceding */
+/* ones. */
+typedef enum {
+    REFINE_SPACEGROUP = 0, /* Refined spacegroup only */
+    REFINE_SYMMETRY = 1,   /* symmetry and pure_trans */
+    REFINE_POSITIONS = 2,  /* Standardized cell and Wyckoff positions */
+} RefineLevel;
+
 ExactStructure *ref_get_exact_structure_and_symmetry(Spacegroup *spacegroup,
                                                      Cell const *primitive,
                                                      Cell const *cell,
                                                      int const *mapping_table,
+                                                     RefineLevel const level,
                                                      double const symprec);
 void ref_free_exact_structure(ExactStructure *exstr);
 int ref_find_similar_bravais_lattice(Spacegroup *spacegroup,
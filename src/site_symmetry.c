@@ -37,6 +37,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "arena.h"
 #include "cell.h"
 #include "debug.h"
 #include "mathfunc.h"
@@ -138,7 +139,8 @@ static VecDBL *get_exact_positions(int *equiv_atoms, Cell const *conv_prim,
         return NULL;
     }
 
-    if ((indep_atoms = (int *)malloc(sizeof(int) * conv_prim->size)) == NULL) {
+    if ((indep_atoms = (int *)arn_malloc(sizeof(int) * conv_prim->size)) ==
+        NULL) {
         warning_memory("indep_atoms");
         mat_free_VecDBL(positions);
         return NULL;
@@ -179,7 +181,7 @@ static VecDBL *get_exact_positions(int *equiv_atoms, Cell const *conv_prim,
         }
     }
 
-    free(indep_atoms);
+    arn_free(indep_atoms);
     indep_atoms = NULL;
 
     return positions;
@@ -367,7 +369,7 @@ static int set_Wyckoffs_labels(int *wyckoffs, char (*site_symmetry_symbols)[7],
     int i, j, w;
     int *nums_equiv_atoms;
 
-    nums_equiv_atoms = (int *)malloc(sizeof(int) * conv_prim->size);
+    nums_equiv_atoms = (int *)arn_malloc(sizeof(int) * conv_prim->size);
     for (i = 0; i < conv_prim->size; i++) {
         nums_equiv_atoms[i] = 0;
     }
@@ -422,12 +424,12 @@ static int set_Wyckoffs_labels(int *wyckoffs, char (*site_symmetry_symbols)[7],
         }
     }
 
-    free(nums_equiv_atoms);
+    arn_free(nums_equiv_atoms);
     nums_equiv_atoms = NULL;
     return 1;
 
 err:
-    free(nums_equiv_atoms);
+    arn_free(nums_equiv_atoms);
     nums_equiv_atoms = NULL;
     return 0;
 }
@@ -40,6 +40,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
+#include "budget.h"
 #include "cell.h"
 #include "debug.h"
 #include "delaunay.h"
@@ -55,6 +57,8 @@
 #define NUM_ATTEMPT 100
 #define INT_PREC 0.1
 #define ZERO_PREC 1e-10
+/* 2, 3, 4, 6-fold rotations and mirrors that may be screws or glides */
+#define NUM_SCREW_GLIDE_CLASSES 5
 
 static double change_of_basis_monocli[48][3][3] = {
     {{1, 0, 0}, /* b  first turn; two axes are flipped in second turn */
@@ -231,6 +235,10 @@ static Centering change_of_centering_ortho[6] = {C_FACE, B_FACE, A_FACE,
 // Index of c axis in the changed coordinates system.
 static int change_of_unique_axis_ortho[6] = {2, 1, 0, 2, 1, 0};
 
+/* Candidates are pruned by the screw/glide fingerprints unless disabled */
+/* by spa_set_fingerprint_pruning on the thread. */
+static thread_local int is_fingerprint_pruning = 1;
+
 /* n_l : the index of L(g) in N_\epsilon(g) of SPG No.16-74 */
 /* See ITA: Affine normalizer or highest symmetry Euclidean normalizer */
 /* Previous implementation below was not correct for 67, 68, 73, 74, */
@@ -384,7 +392,7 @@ static double F_mat[3][3] = {
     {0, 1. / 2, 1. / 2}, {1. / 2, 0, 1. / 2}, {1. / 2, 1. / 2, 0}};
 
 static Spacegroup *search_spacegroup_with_symmetry(
-    Primitive const *primitive, int const candidates[],
+    SearchContext *context, Primitive const *primitive, int const candidates[],
     int const num_candidates, Symmetry const *symmetry, double const symprec,
     double const angle_tolerance);
 static Spacegroup *get_spacegroup(int const hall_number,
@@ -392,8 +400,8 @@ static Spacegroup *get_spacegroup(int const hall_number,
                                   double const conv_lattice[3][3]);
 static int iterative_search_hall_number(
     double origin_shift[3], double conv_lattice[3][3], int const candidates[],
-    int const num_candidates, Primitive const *primitive,
-    Symmetry const *symmetry, double const symprec,
+    int const num_candidates, SearchContext *context,
+    Primitive const *primitive, Symmetry const *symmetry, double const symprec,
     double const angle_tolerance);
 static int change_basis_tricli(int tmat_int[3][3],
                                double const conv_lattice[3][3],
@@ -411,6 +419,20 @@ static int search_hall_number(double origin_shift[3], double conv_lattice[3][3],
                               int const candidates[], int const num_candidates,
                               Primitive const *primitive,
                               Symmetry const *symmetry, double const symprec);
+static int get_screw_glide_fingerprint(
+    int fingerprint[NUM_SCREW_GLIDE_CLASSES], int const rot[][3][3],
+    double const trans[][3], int const size, double const lattice[3][3],
+    double const tolerance);
+static int get_screw_glide_class(int *order, int const rot[3][3]);
+static int is_pure_rotation_coset(int const rot[3][3], double const trans[3],
+                                  int const order,
+                                  double const centerings[][3],
+                                  int const num_centerings,
+                                  double const lattice[3][3],
+                                  double const tolerance);
+static int is_compatible_hall_number(
+    int const fingerprint[NUM_SCREW_GLIDE_CLASSES], int const hall_number,
+    int const pointgroup_number);
 static int match_hall_symbol_db(
     double origin_shift[3], double conv_lattice[3][3],
     double const (*orig_lattice)[3], int const hall_number,
@@ -483,15 +505,23 @@ Spacegroup *spa_search_spacegroup(Primitive const *primitive,
                                   double const angle_tolerance) {
     Spacegroup *spacegroup;
     Symmetry *symmetry;
+    SearchContext *context;
     int candidate[1];
 
     debug_print("search_spacegroup (tolerance = %f):\n", symprec);
 
     symmetry = NULL;
     spacegroup = NULL;
+    context = NULL;
 
-    if ((symmetry = sym_get_operation(primitive->cell, symprec,
-                                      angle_tolerance)) == NULL) {
+    if ((context = sym_alloc_search_context(primitive->cell)) == NULL) {
+        return NULL;
+    }
+
+    if ((symmetry = sym_get_operation(context, symprec, angle_tolerance)) ==
+        NULL) {
+        sym_free_search_context(context);
+        context = NULL;
         return NULL;
     }
 
@@ -500,20 +530,23 @@ Spacegroup *spa_search_spacegroup(Primitive const *primitive,
     }
 
     if (hall_number) {
-        spacegroup = search_spacegroup_with_symmetry(
-            primitive, candidate, 1, symmetry, symprec, angle_tolerance);
+        spacegroup =
+            search_spacegroup_with_symmetry(context, primitive, candidate, 1,
+                                            symmetry, symprec, angle_tolerance);
     } else if (primitive->cell->aperiodic_axis == -1) {
         spacegroup = search_spacegroup_with_symmetry(
-            primitive, spacegroup_to_hall_number, 230, symmetry, symprec,
-            angle_tolerance);
+            context, primitive, spacegroup_to_hall_number, 230, symmetry,
+            symprec, angle_tolerance);
     } else {
         spacegroup = search_spacegroup_with_symmetry(
-            primitive, layer_group_to_hall_number, 116, symmetry, symprec,
-            angle_tolerance);
+            context, primitive, layer_group_to_hall_number, 116, symmetry,
+            symprec, angle_tolerance);
     };
 
     sym_free_symmetry(symmetry);
     symmetry = NULL;
+    sym_free_search_context(context);
+    context = NULL;
 
     return spacegroup;
 }
@@ -526,6 +559,7 @@ Spacegroup *spa_search_spacegroup_with_symmetry(Symmetry const *symmetry,
     int i;
     Spacegroup *spacegroup;
     Primitive *primitive;
+    SearchContext *context;
 
     spacegroup = NULL;
 
@@ -539,8 +573,17 @@ Spacegroup *spa_search_spacegroup_with_symmetry(Symmetry const *symmetry,
     for (i = 0; i < 3; i++) {
         primitive->cell->position[0][i] = 0;
     }
-    spacegroup = search_spacegroup_with_symmetry(
-        primitive, spacegroup_to_hall_number, 230, symmetry, symprec, -1.0);
+    if ((context = sym_alloc_search_context(primitive->cell)) == NULL) {
+        prm_free_primitive(primitive);
+        primitive = NULL;
+        return NULL;
+    }
+    spacegroup =
+        search_spacegroup_with_symmetry(context, primitive,
+                                        spacegroup_to_hall_number, 230,
+                                        symmetry, symprec, -1.0);
+    sym_free_search_context(context);
+    context = NULL;
     prm_free_primitive(primitive);
     primitive = NULL;
 
@@ -638,15 +681,15 @@ Cell *spa_transform_from_primitive(Cell const *primitive,
 
     multi = get_centering_shifts(shift, centering);
 
-    if ((mapping_table =
-             (int *)malloc(sizeof(int) * primitive->size * multi)) == NULL) {
+    if ((mapping_table = (int *)arn_malloc(sizeof(int) * primitive->size *
+                                           multi)) == NULL) {
         warning_memory("mapping_table");
         goto ret;
     }
 
     if ((std_cell = cel_alloc_cell(primitive->size * multi,
                                    primitive->tensor_rank)) == NULL) {
-        free(mapping_table);
+        arn_free(mapping_table);
         mapping_table = NULL;
         goto ret;
     }
@@ -677,7 +720,7 @@ Cell *spa_transform_from_primitive(Cell const *primitive,
         cel_trim_cell(mapping_table, std_cell->lattice, std_cell, symprec);
     cel_free_cell(std_cell);
     std_cell = NULL;
-    free(mapping_table);
+    arn_free(mapping_table);
     mapping_table = NULL;
 
 ret:
@@ -698,9 +741,14 @@ void spa_copy_spacegroup(Spacegroup *dst, Spacegroup const *src) {
     mat_copy_vector_d3(dst->origin_shift, src->origin_shift);
 }
 
+/* For tests comparing the results with and without the pruning. */
+void spa_set_fingerprint_pruning(int const is_enabled) {
+    is_fingerprint_pruning = is_enabled;
+}
+
 /* Return NULL if failed */
 static Spacegroup *search_spacegroup_with_symmetry(
-    Primitive const *primitive, int const candidates[],
+    SearchContext *context, Primitive const *primitive, int const candidates[],
     int const num_candidates, Symmetry const *symmetry, double const symprec,
     double const angle_tolerance) {
     int hall_number;
@@ -723,8 +771,8 @@ static Spacegroup *search_spacegroup_with_symmetry(
     }
 
     hall_number = iterative_search_hall_number(
-        origin_shift, conv_lattice, candidates, num_candidates, primitive,
-        symmetry, symprec, angle_tolerance);
+        origin_shift, conv_lattice, candidates, num_candidates, context,
+        primitive, symmetry, symprec, angle_tolerance);
     if (hall_number == 0) {
         return NULL;
     }
@@ -743,7 +791,7 @@ static Spacegroup *get_spacegroup(int const hall_number,
 
     spacegroup = NULL;
 
-    if ((spacegroup = (Spacegroup *)malloc(sizeof(Spacegroup))) == NULL) {
+    if ((spacegroup = (Spacegroup *)arn_malloc(sizeof(Spacegroup))) == NULL) {
         warning_memory("spacegroup");
         return NULL;
     }
@@ -771,8 +819,8 @@ static Spacegroup *get_spacegroup(int const hall_number,
 /* Return 0 if failed */
 static int iterative_search_hall_number(
     double origin_shift[3], double conv_lattice[3][3], int const candidates[],
-    int const num_candidates, Primitive const *primitive,
-    Symmetry const *symmetry, double const symprec,
+    int const num_candidates, SearchContext *context,
+    Primitive const *primitive, Symmetry const *symmetry, double const symprec,
     double const angle_tolerance) {
     int attempt, hall_number;
     double tolerance;
@@ -793,11 +841,14 @@ static int iterative_search_hall_number(
 
     tolerance = symprec;
     for (attempt = 0; attempt < NUM_ATTEMPT; attempt++) {
+        if (bdg_is_exceeded()) {
+            break;
+        }
         debug_print("spglib: Attempt %d tolerance = %e failed", attempt,
                     tolerance);
 
         tolerance *= REDUCE_RATE;
-        sym_reduced = sym_reduce_operation(primitive->cell, symmetry, tolerance,
+        sym_reduced = sym_reduce_operation(context, symmetry, tolerance,
                                            angle_tolerance);
         if (sym_reduced) {
             hall_number = search_hall_number(origin_shift, conv_lattice,
@@ -820,11 +871,12 @@ static int search_hall_number(double origin_shift[3], double conv_lattice[3][3],
                               int const candidates[], int const num_candidates,
                               Primitive const *primitive,
                               Symmetry const *symmetry, double const symprec) {
-    int i, hall_number, aperiodic_axis;
+    int i, hall_number, aperiodic_axis, has_fingerprint;
     Centering centering;
     Pointgroup pointgroup;
     Symmetry *conv_symmetry;
     int tmat_int[3][3];
+    int fingerprint[NUM_SCREW_GLIDE_CLASSES];
     double correction_mat[3][3], tmat[3][3], conv_lattice_tmp[3][3];
 
     debug_print("search_hall_number:\n");
@@ -894,7 +946,26 @@ static int search_hall_number(double origin_shift[3], double conv_lattice[3][3],
         goto err;
     }
 
+    /* A rotation without screw or glide in a candidate has to be so in */
+    /* conv_symmetry, too, whatever the basis and origin are. Candidates */
+    /* failing this are skipped before trying their changes of basis, */
+    /* which are many for monoclinic and orthorhombic. The tolerance is */
+    /* loosened as rotations are not exactly orthogonal. */
+    has_fingerprint = 0;
+    if (is_fingerprint_pruning &&
+        (pointgroup.holohedry == MONOCLI || pointgroup.holohedry == ORTHO)) {
+        has_fingerprint = get_screw_glide_fingerprint(
+            fingerprint, conv_symmetry->rot, conv_symmetry->trans,
+            conv_symmetry->size, conv_lattice, 2 * symprec);
+    }
+
     for (i = 0; i < num_candidates; i++) {
+        if (has_fingerprint &&
+            !is_compatible_hall_number(fingerprint, candidates[i],
+                                       pointgroup.number)) {
+            continue;
+        }
+
         /* Check if hall_number is that of rhombohedral. */
         if (match_hall_symbol_db(
                 origin_shift, conv_lattice, /* <-- modified only matched */
@@ -1017,6 +1088,208 @@ static Symmetry *get_initial_conventional_symmetry(Centering const centering,
     return conv_symmetry;
 }
 
+/* Count rotations of each screw/glide class whose cosets contain */
+/* an operation without screw or glide translation. Translations of */
+/* identity operations are taken as centering translations. */
+/* Operations of the same rotation differ by centering translations and */
+/* make one coset, which is counted once if any of them is found without */
+/* screw or glide, so that a coset is not lost when the tolerance accepts */
+/* only some of them. */
+/* Return 0 if failed */
+static int get_screw_glide_fingerprint(
+    int fingerprint[NUM_SCREW_GLIDE_CLASSES], int const rot[][3][3],
+    double const trans[][3], int const size, double const lattice[3][3],
+    double const tolerance) {
+    int i, j, screw_class, order, num_centerings;
+    double centerings[4][3];
+    static int const identity[3][3] = {
+        {1, 0, 0},
+        {0, 1, 0},
+        {0, 0, 1},
+    };
+
+    num_centerings = 0;
+    for (i = 0; i < NUM_SCREW_GLIDE_CLASSES; i++) {
+        fingerprint[i] = 0;
+    }
+
+    for (i = 0; i < size; i++) {
+        if (mat_check_identity_matrix_i3(rot[i], identity)) {
+            if (num_centerings == 4) {
+                return 0;
+            }
+            mat_copy_vector_d3(centerings[num_centerings], trans[i]);
+            num_centerings++;
+        }
+    }
+
+    if (num_centerings == 0) {
+        return 0;
+    }
+
+    for (i = 0; i < size; i++) {
+        if ((screw_class = get_screw_glide_class(&order, rot[i])) < 0) {
+            continue;
+        }
+
+        /* The coset is visited from its first operation. */
+        for (j = 0; j < i; j++) {
+            if (mat_check_identity_matrix_i3(rot[j], rot[i])) {
+                break;
+            }
+        }
+        if (j < i) {
+            continue;
+        }
+
+        for (j = i; j < size; j++) {
+            if (mat_check_identity_matrix_i3(rot[j], rot[i]) &&
+                is_pure_rotation_coset(rot[j], trans[j], order, centerings,
+                                       num_centerings, lattice, tolerance)) {
+                fingerprint[screw_class]++;
+                break;
+            }
+        }
+    }
+
+    return 1;
+}
+
+/* Return -1 for rotations that can not be screws or glides. */
+static int get_screw_glide_class(int *order, int const rot[3][3]) {
+    int trace;
+
+    trace = mat_get_trace_i3(rot);
+    if (mat_get_determinant_i3(rot) == 1) {
+        switch (trace) {
+            case -1:
+                *order = 2;
+                return 0;
+            case 0:
+                *order = 3;
+                return 1;
+            case 1:
+                *order = 4;
+                return 2;
+            case 2:
+                *order = 6;
+                return 3;
+            default:
+                return -1;
+        }
+    }
+
+    if (trace == 1) {
+        *order = 2;
+        return 4;
+    }
+
+    return -1;
+}
+
+/* Intrinsic translation (R^(n-1) + ... + R + 1)t / n is that of an */
+/* operation without screw or glide for a lattice vector t. */
+static int is_pure_rotation_coset(int const rot[3][3], double const trans[3],
+                                  int const order,
+                                  double const centerings[][3],
+                                  int const num_centerings,
+                                  double const lattice[3][3],
+                                  double const tolerance) {
+    int i, j, k, l, m;
+    int num_shifts[3];
+    int sum_rot[3][3], rot_power[3][3];
+    double t[3], t_shifted[3], w[3];
+    static int const shifts[3] = {0, -1, 1};
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            sum_rot[i][j] = (i == j);
+            rot_power[i][j] = rot[i][j];
+        }
+    }
+    for (i = 1; i < order; i++) {
+        mat_add_matrix_i3(sum_rot, sum_rot, rot_power);
+        mat_multiply_matrix_i3(rot_power, rot, rot_power);
+    }
+
+    /* Lattice translations projected out need not be tried. */
+    for (i = 0; i < 3; i++) {
+        num_shifts[i] = 1;
+        for (j = 0; j < 3; j++) {
+            if (sum_rot[j][i] != 0) {
+                num_shifts[i] = 3;
+            }
+        }
+    }
+
+    for (i = 0; i < num_centerings; i++) {
+        for (j = 0; j < 3; j++) {
+            t[j] = trans[j] + centerings[i][j];
+            t[j] -= mat_Nint(t[j]);
+        }
+        for (j = 0; j < num_shifts[0]; j++) {
+            for (k = 0; k < num_shifts[1]; k++) {
+                for (l = 0; l < num_shifts[2]; l++) {
+                    t_shifted[0] = t[0] + shifts[j];
+                    t_shifted[1] = t[1] + shifts[k];
+                    t_shifted[2] = t[2] + shifts[l];
+                    mat_multiply_matrix_vector_id3(w, sum_rot, t_shifted);
+                    for (m = 0; m < 3; m++) {
+                        w[m] /= order;
+                    }
+                    mat_multiply_matrix_vector_d3(w, lattice, w);
+                    if (mat_norm_squared_d3(w) < tolerance * tolerance) {
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Return 0 if hall_number can not match the fingerprint. */
+static int is_compatible_hall_number(
+    int const fingerprint[NUM_SCREW_GLIDE_CLASSES], int const hall_number,
+    int const pointgroup_number) {
+    int i;
+    int operation_index[2];
+    int rot[192][3][3];
+    double trans[192][3];
+    int db_fingerprint[NUM_SCREW_GLIDE_CLASSES];
+    static double const identity[3][3] = {
+        {1, 0, 0},
+        {0, 1, 0},
+        {0, 0, 1},
+    };
+
+    if (spgdb_get_spacegroup_type(hall_number).pointgroup_number !=
+        pointgroup_number) {
+        return 0;
+    }
+
+    spgdb_get_operation_index(operation_index, hall_number);
+    for (i = 0; i < operation_index[0]; i++) {
+        spgdb_get_operation(rot[i], trans[i], operation_index[1] + i);
+    }
+
+    /* Database translations are exact in any metric. */
+    if (!get_screw_glide_fingerprint(db_fingerprint, rot, trans,
+                                     operation_index[0], identity,
+                                     ZERO_PREC)) {
+        return 1;
+    }
+
+    for (i = 0; i < NUM_SCREW_GLIDE_CLASSES; i++) {
+        if (db_fingerprint[i] > fingerprint[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 /* Return 0 if failed */
 static int match_hall_symbol_db(
     double origin_shift[3], double conv_lattice[3][3],
@@ -80,5 +80,6 @@ Cell *spa_transform_from_primitive(Cell const *primitive,
                                    Centering const centering,
                                    double const symprec);
 void spa_copy_spacegroup(Spacegroup *dst, Spacegroup const *src);
+SPG_API_TEST void spa_set_fingerprint_pruning(int const is_enabled);
 
 #endif
@@ -36,11 +36,14 @@
 #include "base.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "arithmetic.h"
+#include "budget.h"
 #include "cell.h"
 #include "debug.h"
 #include "delaunay.h"
@@ -60,20 +63,6 @@
 #include "symmetry.h"
 #include "version.h"
 
-// Windows does not support _Thread_local. Use appropriate aliases
-// Reference: https://stackoverflow.com/a/18298965
-#ifndef thread_local
-    #if __STDC_VERSION__ >= 201112 && !defined __STDC_NO_THREADS__
-        #define thread_local _Thread_local
-    #elif defined _MSC_VER
-        #define thread_local __declspec(thread)
-    #elif defined __GNUC__
-        #define thread_local __thread
-    #else
-        #error "Cannot define thread_local"
-    #endif
-#endif
-
 /*-------*/
 /* error */
 /*-------*/
@@ -95,6 +84,7 @@ static SpglibErrorMessage spglib_error_message[] = {
     {SPGERR_NIGGLI_FAILED, "Niggli reduction failed"},
     {SPGERR_DELAUNAY_FAILED, "Delaunay reduction failed"},
     {SPGERR_ARRAY_SIZE_SHORTAGE, "array size shortage"},
+    {SPGERR_WORK_BUDGET_EXCEEDED, "work budget exceeded"},
     {SPGERR_NONE, ""},
 };
 
@@ -104,8 +94,30 @@ static SpglibErrorMessage spglib_error_message[] = {
 static SpglibDataset *get_dataset(double const lattice[3][3],
                                   double const position[][3], int const types[],
                                   int const num_atom, int const hall_number,
-                                  double const symprec,
+                                  int const options, double const symprec,
                                   double const angle_tolerance);
+static SpglibDataset *search_dataset(
+    void *buffer, size_t const buffer_size, SpglibWorkspace *workspace,
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, Symmetry const *prev_symmetry, int const hall_number,
+    int const options, double const symprec, double const angle_tolerance,
+    int const is_factorized);
+static SpglibDataset *update_dataset(SpglibDataset const *prev_dataset,
+                                     double const lattice[3][3],
+                                     double const position[][3],
+                                     int const types[], int const num_atom,
+                                     double const symprec,
+                                     double const angle_tolerance);
+static int get_datasets(SpglibDataset *datasets[], SpglibError error_codes[],
+                        double const lattices[][3][3],
+                        double const positions[][3], int const types[],
+                        int const offsets[], int const num_cells,
+                        double const symprec, double const angle_tolerance);
+static int get_dataset_tolerance_scan(
+    int spacegroup_numbers[], int hall_numbers[], int n_operations[],
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprecs[], int const num_symprec,
+    double const angle_tolerance);
 static SpglibDataset *get_layer_dataset(
     double const lattice[3][3], double const position[][3], int const types[],
     int const num_atom, int const aperiodic_axis, int const hall_number,
@@ -115,17 +127,30 @@ static SpglibMagneticDataset *get_magnetic_dataset(
     double const *tensors, int const tensor_rank, int const num_atom,
     int const is_axial, double const symprec, double const angle_tolerance,
     double const mag_symprec);
-static SpglibDataset *init_dataset(void);
-static SpglibMagneticDataset *init_magnetic_dataset(void);
-static int set_dataset(SpglibDataset *dataset, Cell const *cell,
-                       Primitive const *primitive, Spacegroup const *spacegroup,
-                       ExactStructure *exstr);
-static int set_magnetic_dataset(SpglibMagneticDataset *dataset,
-                                int const num_atoms, Cell const *cell_std,
-                                MagneticSymmetry const *magnetic_symmetry,
-                                MagneticDataset const *msgdata,
-                                int const *equivalent_atoms,
-                                double const primitive_lattice[3][3]);
+static size_t get_aligned_size(size_t const size);
+static void *take_array(char **block, size_t const size);
+static size_t get_dataset_size(int const n_operations,
+                               int const n_pure_translations, int const n_atoms,
+                               int const with_wyckoffs, int const n_std_atoms);
+static SpglibDataset *alloc_dataset(void *buffer, size_t const buffer_size,
+                                    int const n_operations,
+                                    int const n_pure_translations,
+                                    int const n_atoms, int const with_wyckoffs,
+                                    int const n_std_atoms);
+static void set_dataset_arrays(SpglibDataset *dataset, int const with_wyckoffs);
+static SpglibMagneticDataset *alloc_magnetic_dataset(
+    int const n_operations, int const n_atoms, int const n_std_atoms,
+    int const tensor_rank);
+static SpglibDataset *new_dataset(void *buffer, size_t const buffer_size,
+                                  Cell const *cell, Primitive const *primitive,
+                                  Spacegroup const *spacegroup,
+                                  ExactStructure const *exstr,
+                                  int const options, int const is_factorized);
+static RefineLevel get_refine_level(int const options);
+static SpglibMagneticDataset *new_magnetic_dataset(
+    int const num_atoms, Cell const *cell_std,
+    MagneticSymmetry const *magnetic_symmetry, MagneticDataset const *msgdata,
+    int const *equivalent_atoms, double const primitive_lattice[3][3]);
 static int get_symmetry_from_dataset(
     int rotation[][3][3], double translation[][3], int const max_size,
     double const lattice[3][3], double const position[][3], int const types[],
@@ -257,6 +282,12 @@ char *spg_get_error_message(SpglibError error) {
     return NULL;
 }
 
+void spg_set_work_budget(double const max_seconds,
+                         long long const max_overlap_checks) {
+    bdg_set_limits(max_seconds, max_overlap_checks);
+    spglib_error_code = SPGLIB_SUCCESS;
+}
+
 /*---------*/
 /* general */
 /*---------*/
@@ -264,7 +295,8 @@ char *spg_get_error_message(SpglibError error) {
 SpglibDataset *spg_get_dataset(double const lattice[3][3],
                                double const position[][3], int const types[],
                                int const num_atom, double const symprec) {
-    return get_dataset(lattice, position, types, num_atom, 0, symprec, -1.0);
+    return get_dataset(lattice, position, types, num_atom, 0,
+                       SPGLIB_DATASET_ALL, symprec, -1.0);
 }
 
 SpglibDataset *spg_get_layer_dataset(double const lattice[3][3],
@@ -299,16 +331,16 @@ SpglibDataset *spgat_get_dataset(double const lattice[3][3],
                                  double const position[][3], int const types[],
                                  int const num_atom, double const symprec,
                                  double const angle_tolerance) {
-    return get_dataset(lattice, position, types, num_atom, 0, symprec,
-                       angle_tolerance);
+    return get_dataset(lattice, position, types, num_atom, 0,
+                       SPGLIB_DATASET_ALL, symprec, angle_tolerance);
 }
 
 /* Return NULL if failed */
 SpglibDataset *spg_get_dataset_with_hall_number(
     double const lattice[3][3], double const position[][3], int const types[],
     int const num_atom, int const hall_number, double const symprec) {
-    return get_dataset(lattice, position, types, num_atom, hall_number, symprec,
-                       -1.0);
+    return get_dataset(lattice, position, types, num_atom, hall_number,
+                       SPGLIB_DATASET_ALL, symprec, -1.0);
 }
 
 /* Return NULL if failed */
@@ -316,82 +348,225 @@ SpglibDataset *spgat_get_dataset_with_hall_number(
     double const lattice[3][3], double const position[][3], int const types[],
     int const num_atom, int const hall_number, double const symprec,
     double const angle_tolerance) {
-    return get_dataset(lattice, position, types, num_atom, hall_number, symprec,
-                       angle_tolerance);
+    return get_dataset(lattice, position, types, num_atom, hall_number,
+                       SPGLIB_DATASET_ALL, symprec, angle_tolerance);
+}
+
+/* Return the number of datasets found */
+int spg_get_datasets(SpglibDataset *datasets[], SpglibError error_codes[],
+                     double const lattices[][3][3], double const positions[][3],
+                     int const types[], int const offsets[],
+                     int const num_cells, double const symprec) {
+    return get_datasets(datasets, error_codes, lattices, positions, types,
+                        offsets, num_cells, symprec, -1.0);
+}
+
+/* Return the number of datasets found */
+int spgat_get_datasets(SpglibDataset *datasets[], SpglibError error_codes[],
+                       double const lattices[][3][3],
+                       double const positions[][3], int const types[],
+                       int const offsets[], int const num_cells,
+                       double const symprec, double const angle_tolerance) {
+    return get_datasets(datasets, error_codes, lattices, positions, types,
+                        offsets, num_cells, symprec, angle_tolerance);
+}
+
+/* Return the number of tolerances at which the space group was found */
+int spg_get_dataset_tolerance_scan(int spacegroup_numbers[], int hall_numbers[],
+                                   int n_operations[],
+                                   double const lattice[3][3],
+                                   double const position[][3],
+                                   int const types[], int const num_atom,
+                                   double const symprecs[],
+                                   int const num_symprec) {
+    return get_dataset_tolerance_scan(spacegroup_numbers, hall_numbers,
+                                      n_operations, lattice, position, types,
+                                      num_atom, symprecs, num_symprec, -1.0);
+}
+
+/* Return the number of tolerances at which the space group was found */
+int spgat_get_dataset_tolerance_scan(
+    int spacegroup_numbers[], int hall_numbers[], int n_operations[],
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprecs[], int const num_symprec,
+    double const angle_tolerance) {
+    return get_dataset_tolerance_scan(
+        spacegroup_numbers, hall_numbers, n_operations, lattice, position,
+        types, num_atom, symprecs, num_symprec, angle_tolerance);
 }
 
-void spg_free_dataset(SpglibDataset *dataset) {
-    if (dataset->n_operations > 0) {
-        free(dataset->rotations);
-        dataset->rotations = NULL;
-        free(dataset->translations);
-        dataset->translations = NULL;
-        dataset->n_operations = 0;
-    }
-
-    if (dataset->n_atoms > 0) {
-        free(dataset->wyckoffs);
-        dataset->wyckoffs = NULL;
-        free(dataset->equivalent_atoms);
-        dataset->equivalent_atoms = NULL;
-        free(dataset->crystallographic_orbits);
-        dataset->crystallographic_orbits = NULL;
-        free(dataset->site_symmetry_symbols);
-        dataset->site_symmetry_symbols = NULL;
-        free(dataset->mapping_to_primitive);
-        dataset->mapping_to_primitive = NULL;
-        dataset->n_atoms = 0;
-    }
-
-    if (dataset->n_std_atoms > 0) {
-        free(dataset->std_positions);
-        dataset->std_positions = NULL;
-        free(dataset->std_types);
-        dataset->std_types = NULL;
-        free(dataset->std_mapping_to_primitive);
-        dataset->std_mapping_to_primitive = NULL;
-        dataset->n_std_atoms = 0;
-    }
-
-    dataset->spacegroup_number = 0;
-    dataset->hall_number = 0;
-    strcpy(dataset->international_symbol, "");
-    strcpy(dataset->hall_symbol, "");
-    strcpy(dataset->choice, "");
+/* Return NULL if failed */
+SpglibDataset *spg_get_factorized_dataset(double const lattice[3][3],
+                                          double const position[][3],
+                                          int const types[], int const num_atom,
+                                          double const symprec) {
+    return search_dataset(NULL, 0, NULL, lattice, position, types, num_atom,
+                          NULL, 0, SPGLIB_DATASET_ALL, symprec, -1.0, 1);
+}
 
-    free(dataset);
+/* Return NULL if failed */
+SpglibDataset *spgat_get_factorized_dataset(
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprec, double const angle_tolerance) {
+    return search_dataset(NULL, 0, NULL, lattice, position, types, num_atom,
+                          NULL, 0, SPGLIB_DATASET_ALL, symprec,
+                          angle_tolerance, 1);
 }
 
-void spg_free_magnetic_dataset(SpglibMagneticDataset *dataset) {
-    /* Magnetic symmetry operations */
-    if (dataset->n_operations > 0) {
-        free(dataset->rotations);
-        dataset->rotations = NULL;
-        free(dataset->translations);
-        dataset->translations = NULL;
-        free(dataset->time_reversals);
-        dataset->time_reversals = NULL;
+/* Return 0 if failed */
+int spg_expand_dataset_operations(int rotation[][3][3],
+                                  double translation[][3], int const max_size,
+                                  SpglibDataset const *dataset) {
+    int i, j, k, n, num_sym;
+
+    if (dataset->n_pure_translations == 0) {
+        num_sym = dataset->n_operations;
+    } else {
+        num_sym = dataset->n_operations * dataset->n_pure_translations;
     }
 
-    /* Equivalent atoms */
-    if (dataset->n_atoms > 0) {
-        free(dataset->equivalent_atoms);
-        dataset->equivalent_atoms = NULL;
+    if (num_sym > max_size) {
+        fprintf(stderr, "spglib: Indicated max size(=%d) is less than number ",
+                max_size);
+        fprintf(stderr, "spglib: of symmetry operations(=%d).\n", num_sym);
+        spglib_error_code = SPGERR_ARRAY_SIZE_SHORTAGE;
+        return 0;
     }
 
-    /* Standardized crystal structure */
-    if (dataset->n_std_atoms > 0) {
-        free(dataset->std_positions);
-        dataset->std_positions = NULL;
-        free(dataset->std_types);
-        dataset->std_types = NULL;
-        free(dataset->std_tensors);
-        dataset->std_tensors = NULL;
-        dataset->n_std_atoms = 0;
+    for (i = 0; i < dataset->n_operations; i++) {
+        mat_copy_matrix_i3(rotation[i], dataset->rotations[i]);
+        mat_copy_vector_d3(translation[i], dataset->translations[i]);
     }
 
+    /* Same as copy_symmetry_upon_lattice_points in refinement.c, where */
+    /* zero components of pure translations, e.g., along the aperiodic */
+    /* axis, are not reduced. */
+    for (i = 1; i < dataset->n_pure_translations; i++) {
+        for (j = 0; j < dataset->n_operations; j++) {
+            n = dataset->n_operations * i + j;
+            mat_copy_matrix_i3(rotation[n], dataset->rotations[j]);
+            for (k = 0; k < 3; k++) {
+                translation[n][k] = dataset->translations[j][k] +
+                                    dataset->pure_translations[i][k];
+                if (dataset->pure_translations[i][k] != 0) {
+                    translation[n][k] = mat_Dmod1(translation[n][k]);
+                }
+            }
+        }
+    }
+
+    spglib_error_code = SPGLIB_SUCCESS;
+    return num_sym;
+}
+
+/* Return NULL if failed */
+SpglibWorkspace *spg_alloc_workspace(void) { return arn_alloc_workspace(); }
+
+void spg_free_workspace(SpglibWorkspace *workspace) {
+    arn_free_workspace(workspace);
+}
+
+/* The number of operations is at most 48 times the number of lattice */
+/* points, and the conventional cell has at most 4 lattice points. The */
+/* slack of 15 bytes is for aligning the dataset in the buffer. */
+size_t spg_get_dataset_buffer_size(int const num_atom) {
+    return get_dataset_size(48 * num_atom, 0, num_atom, 1, 4 * num_atom) + 15;
+}
+
+/* Return NULL if failed */
+SpglibDataset *spg_get_dataset_in_buffer(
+    void *buffer, size_t const buffer_size, SpglibWorkspace *workspace,
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprec) {
+    return search_dataset(buffer, buffer_size, workspace, lattice, position,
+                          types, num_atom, NULL, 0, SPGLIB_DATASET_ALL, symprec,
+                          -1.0, 0);
+}
+
+/* Return NULL if failed */
+SpglibDataset *spgat_get_dataset_in_buffer(
+    void *buffer, size_t const buffer_size, SpglibWorkspace *workspace,
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprec, double const angle_tolerance) {
+    return search_dataset(buffer, buffer_size, workspace, lattice, position,
+                          types, num_atom, NULL, 0, SPGLIB_DATASET_ALL, symprec,
+                          angle_tolerance, 0);
+}
+
+/* Return NULL if failed */
+SpglibDataset *spg_update_dataset(SpglibDataset const *prev_dataset,
+                                  double const lattice[3][3],
+                                  double const position[][3],
+                                  int const types[], int const num_atom,
+                                  double const symprec) {
+    return update_dataset(prev_dataset, lattice, position, types, num_atom,
+                          symprec, -1.0);
+}
+
+/* Return NULL if failed */
+SpglibDataset *spgat_update_dataset(SpglibDataset const *prev_dataset,
+                                    double const lattice[3][3],
+                                    double const position[][3],
+                                    int const types[], int const num_atom,
+                                    double const symprec,
+                                    double const angle_tolerance) {
+    return update_dataset(prev_dataset, lattice, position, types, num_atom,
+                          symprec, angle_tolerance);
+}
+
+/* Return NULL if failed */
+SpglibDataset *spg_get_dataset_with_options(
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, int const options, double const symprec) {
+    return get_dataset(lattice, position, types, num_atom, 0, options, symprec,
+                       -1.0);
+}
+
+/* Return NULL if failed */
+SpglibDataset *spgat_get_dataset_with_options(
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, int const options, double const symprec,
+    double const angle_tolerance) {
+    return get_dataset(lattice, position, types, num_atom, 0, options, symprec,
+                       angle_tolerance);
+}
+
+/* The arrays of the dataset are in the same memory block as the */
+/* dataset. */
+void spg_free_dataset(SpglibDataset *dataset) { free(dataset); }
+
+/* The Wyckoff positions are absent in the datasets of */
+/* spg_get_dataset_with_options without SPGLIB_DATASET_WYCKOFFS, where */
+/* wyckoffs is NULL. The pointer is only compared with NULL, so this works */
+/* also for byte copies whose pointers are not rebased yet. */
+size_t spg_get_dataset_size(SpglibDataset const *dataset) {
+    return get_dataset_size(dataset->n_operations,
+                            dataset->n_pure_translations, dataset->n_atoms,
+                            dataset->wyckoffs != NULL, dataset->n_std_atoms);
+}
+
+/* Return NULL if failed */
+SpglibDataset *spg_copy_dataset(SpglibDataset const *dataset) {
+    size_t size;
+    SpglibDataset *copy;
+
+    size = spg_get_dataset_size(dataset);
+    if ((copy = (SpglibDataset *)malloc(size)) == NULL) {
+        warning_memory("dataset");
+        return NULL;
+    }
+    memcpy(copy, dataset, size);
+
+    return spg_rebase_dataset(copy);
+}
+
+SpglibDataset *spg_rebase_dataset(SpglibDataset *dataset) {
+    set_dataset_arrays(dataset, dataset->wyckoffs != NULL);
+    return dataset;
+}
+
+void spg_free_magnetic_dataset(SpglibMagneticDataset *dataset) {
     free(dataset);
-    dataset = NULL;
 }
 
 /* Return 0 if failed */
@@ -550,6 +725,58 @@ int spgms_get_symmetry_with_site_tensors(
     return size;
 }
 
+/* The operations are checked with one OverlapChecker of the cell. */
+/* Return -1 if failed, since 0 means that no operation is a symmetry. */
+int spg_verify_symmetry_operations(
+    int is_symmetry[], int permutations[], double max_displacements[],
+    int const rotation[][3][3], double const translation[][3],
+    int const num_operations, double const lattice[3][3],
+    double const position[][3], int const types[], int const num_atom,
+    double const symprec) {
+    int num_sym;
+    Cell *cell;
+    SearchContext *context;
+
+    num_sym = -1;
+    cell = NULL;
+    context = NULL;
+
+    arn_begin();
+    bdg_begin();
+
+    if ((cell = cel_alloc_cell(num_atom, NOSPIN)) == NULL) {
+        goto finalize;
+    }
+    cel_set_cell(cell, lattice, position, types);
+
+    if ((context = sym_alloc_search_context(cell)) == NULL) {
+        goto finalize;
+    }
+    num_sym = sym_verify_operations(is_symmetry, permutations,
+                                    max_displacements, context, rotation,
+                                    translation, num_operations, symprec);
+
+finalize:
+    sym_free_search_context(context);
+    context = NULL;
+    cel_free_cell(cell);
+    cell = NULL;
+    if (bdg_has_exceeded()) {
+        num_sym = -1;
+        spglib_error_code = SPGERR_WORK_BUDGET_EXCEEDED;
+    } else {
+        spglib_error_code = SPGERR_SYMMETRY_OPERATION_SEARCH_FAILED;
+    }
+    bdg_end();
+    arn_end();
+
+    if (num_sym < 0) {
+        return -1;
+    }
+    spglib_error_code = SPGLIB_SUCCESS;
+    return num_sym;
+}
+
 /* Deprecated at v2.0 */
 int spg_get_hall_number_from_symmetry(int const rotation[][3][3],
                                       double const translation[][3],
@@ -888,6 +1115,7 @@ int spg_delaunay_reduce(double lattice[3][3], double const symprec) {
     int i, j, succeeded;
     double red_lattice[3][3];
 
+    bdg_begin();
     succeeded = del_delaunay_reduce(red_lattice, lattice, symprec);
 
     if (succeeded) {
@@ -897,9 +1125,12 @@ int spg_delaunay_reduce(double lattice[3][3], double const symprec) {
             }
         }
         spglib_error_code = SPGLIB_SUCCESS;
+    } else if (bdg_has_exceeded()) {
+        spglib_error_code = SPGERR_WORK_BUDGET_EXCEEDED;
     } else {
         spglib_error_code = SPGERR_DELAUNAY_FAILED;
     }
+    bdg_end();
 
     return succeeded;
 }
@@ -1020,6 +1251,7 @@ int spg_niggli_reduce(double lattice[3][3], double const symprec) {
         }
     }
 
+    bdg_begin();
     succeeded = niggli_reduce(vals, symprec, -1 /* aperiodic_axis */);
 
     if (succeeded) {
@@ -1029,9 +1261,12 @@ int spg_niggli_reduce(double lattice[3][3], double const symprec) {
             }
         }
         spglib_error_code = SPGLIB_SUCCESS;
+    } else if (bdg_has_exceeded()) {
+        spglib_error_code = SPGERR_WORK_BUDGET_EXCEEDED;
     } else {
         spglib_error_code = SPGERR_NIGGLI_FAILED;
     }
+    bdg_end();
 
     return succeeded;
 }
@@ -1047,8 +1282,27 @@ int spg_niggli_reduce(double lattice[3][3], double const symprec) {
 static SpglibDataset *get_dataset(double const lattice[3][3],
                                   double const position[][3], int const types[],
                                   int const num_atom, int const hall_number,
-                                  double const symprec,
+                                  int const options, double const symprec,
                                   double const angle_tolerance) {
+    return search_dataset(NULL, 0, NULL, lattice, position, types, num_atom,
+                          NULL, hall_number, options, symprec, angle_tolerance,
+                          0);
+}
+
+/* Symmetry operations are factorized by the pure translations when */
+/* is_factorized is true. The dataset is written into buffer unless it is */
+/* NULL, and the temporary memory is kept in workspace unless it is NULL. */
+/* If prev_symmetry is given, the space-group type of hall_number is */
+/* tried first as long as these operations are kept (det_update_all), */
+/* which computes all the fields. Otherwise only the fields of options are */
+/* computed. */
+/* Return NULL if failed */
+static SpglibDataset *search_dataset(
+    void *buffer, size_t const buffer_size, SpglibWorkspace *workspace,
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, Symmetry const *prev_symmetry, int const hall_number,
+    int const options, double const symprec, double const angle_tolerance,
+    int const is_factorized) {
     SpglibDataset *dataset;
     Cell *cell;
     DataContainer *container;
@@ -1057,13 +1311,11 @@ static SpglibDataset *get_dataset(double const lattice[3][3],
     cell = NULL;
     container = NULL;
 
-    if ((dataset = init_dataset()) == NULL) {
-        goto not_found;
-    }
+    /* Everything except for the dataset is allocated in the arena. */
+    arn_begin_with_workspace(workspace);
+    bdg_begin();
 
     if ((cell = cel_alloc_cell(num_atom, NOSPIN)) == NULL) {
-        free(dataset);
-        dataset = NULL;
         goto not_found;
     }
 
@@ -1071,44 +1323,299 @@ static SpglibDataset *get_dataset(double const lattice[3][3],
     if (cel_any_overlap_with_same_type(cell, symprec)) {
         cel_free_cell(cell);
         cell = NULL;
-        free(dataset);
-        dataset = NULL;
         goto atoms_too_close;
     }
 
-    if ((container = det_determine_all(cell, hall_number, symprec,
-                                       angle_tolerance)) != NULL) {
-        if (set_dataset(dataset, cell, container->primitive,
-                        container->spacegroup, container->exact_structure)) {
-            det_free_container(container);
-            container = NULL;
-            cel_free_cell(cell);
-            cell = NULL;
-            goto found;
-        }
+    if (prev_symmetry == NULL) {
+        container = det_determine_all(cell, hall_number,
+                                      get_refine_level(options), symprec,
+                                      angle_tolerance);
+    } else {
+        container = det_update_all(cell, prev_symmetry, hall_number, symprec,
+                                   angle_tolerance);
+    }
+
+    /* The search may have given up on the way. */
+    if (bdg_has_exceeded()) {
         det_free_container(container);
         container = NULL;
     }
 
+    if (container != NULL) {
+        dataset = new_dataset(buffer, buffer_size, cell, container->primitive,
+                              container->spacegroup,
+                              container->exact_structure, options,
+                              is_factorized);
+        det_free_container(container);
+        container = NULL;
+        cel_free_cell(cell);
+        cell = NULL;
+        if (dataset != NULL) {
+            goto found;
+        }
+        if (buffer != NULL) {
+            goto array_size_shortage;
+        }
+        goto not_found;
+    }
+
     cel_free_cell(cell);
     cell = NULL;
-    free(dataset);
-    dataset = NULL;
 
 not_found:
-    spglib_error_code = SPGERR_SPACEGROUP_SEARCH_FAILED;
+    spglib_error_code = bdg_has_exceeded() ? SPGERR_WORK_BUDGET_EXCEEDED
+                                           : SPGERR_SPACEGROUP_SEARCH_FAILED;
+    bdg_end();
+    arn_end();
     return NULL;
 
 atoms_too_close:
+    bdg_end();
+    arn_end();
     spglib_error_code = SPGERR_ATOMS_TOO_CLOSE;
     return NULL;
 
-found:
+array_size_shortage:
+    bdg_end();
+    arn_end();
+    spglib_error_code = SPGERR_ARRAY_SIZE_SHORTAGE;
+    return NULL;
 
+found:
+    bdg_end();
+    arn_end();
     spglib_error_code = SPGLIB_SUCCESS;
     return dataset;
 }
 
+/* The operations of prev_dataset are expanded if it is factorized, and */
+/* the new dataset is factorized in the same way. prev_dataset without */
+/* the operations, e.g., from spg_get_dataset_with_options, is searched */
+/* from scratch as by spg_get_dataset. */
+/* Return NULL if failed */
+static SpglibDataset *update_dataset(SpglibDataset const *prev_dataset,
+                                     double const lattice[3][3],
+                                     double const position[][3],
+                                     int const types[], int const num_atom,
+                                     double const symprec,
+                                     double const angle_tolerance) {
+    int num_sym, is_factorized;
+    Symmetry *symmetry;
+    SpglibDataset *dataset;
+
+    symmetry = NULL;
+    dataset = NULL;
+
+    is_factorized = (prev_dataset->n_pure_translations > 0);
+    if (prev_dataset->n_operations == 0) {
+        return search_dataset(NULL, 0, NULL, lattice, position, types,
+                              num_atom, NULL, 0, SPGLIB_DATASET_ALL, symprec,
+                              angle_tolerance, is_factorized);
+    }
+
+    if (is_factorized) {
+        num_sym =
+            prev_dataset->n_operations * prev_dataset->n_pure_translations;
+    } else {
+        num_sym = prev_dataset->n_operations;
+    }
+
+    if ((symmetry = sym_alloc_symmetry(num_sym)) == NULL) {
+        spglib_error_code = SPGERR_SPACEGROUP_SEARCH_FAILED;
+        return NULL;
+    }
+    spg_expand_dataset_operations(symmetry->rot, symmetry->trans, num_sym,
+                                  prev_dataset);
+
+    dataset = search_dataset(NULL, 0, NULL, lattice, position, types,
+                             num_atom, symmetry, prev_dataset->hall_number,
+                             SPGLIB_DATASET_ALL, symprec, angle_tolerance,
+                             is_factorized);
+
+    sym_free_symmetry(symmetry);
+    symmetry = NULL;
+
+    return dataset;
+}
+
+/* Each call of get_dataset sets spglib_error_code of the thread that */
+/* processed the cell, which is copied to error_codes. The error code of */
+/* the calling thread is set to that of the first failed cell. Each cell */
+/* has its own work budget of the limits set on the calling thread. */
+/* Return the number of datasets found */
+static int get_datasets(SpglibDataset *datasets[], SpglibError error_codes[],
+                        double const lattices[][3][3],
+                        double const positions[][3], int const types[],
+                        int const offsets[], int const num_cells,
+                        double const symprec, double const angle_tolerance) {
+    int i, num_found;
+    long long max_overlap_checks, thread_max_overlap_checks;
+    double max_seconds, thread_max_seconds;
+
+    num_found = 0;
+    bdg_get_limits(&max_seconds, &max_overlap_checks);
+
+#pragma omp parallel for schedule(dynamic) reduction(+ : num_found) \
+    private(thread_max_seconds, thread_max_overlap_checks)
+    for (i = 0; i < num_cells; i++) {
+        bdg_get_limits(&thread_max_seconds, &thread_max_overlap_checks);
+        bdg_set_limits(max_seconds, max_overlap_checks);
+        datasets[i] = get_dataset(lattices[i], positions + offsets[i],
+                                  types + offsets[i],
+                                  offsets[i + 1] - offsets[i], 0,
+                                  SPGLIB_DATASET_ALL, symprec, angle_tolerance);
+        bdg_set_limits(thread_max_seconds, thread_max_overlap_checks);
+        error_codes[i] = spglib_error_code;
+        if (datasets[i] != NULL) {
+            num_found++;
+        }
+    }
+
+    spglib_error_code = SPGLIB_SUCCESS;
+    for (i = 0; i < num_cells; i++) {
+        if (error_codes[i] != SPGLIB_SUCCESS) {
+            spglib_error_code = error_codes[i];
+            break;
+        }
+    }
+
+    return num_found;
+}
+
+/* Return the number of tolerances at which the space group was found */
+static int get_dataset_tolerance_scan(
+    int spacegroup_numbers[], int hall_numbers[], int n_operations[],
+    double const lattice[3][3], double const position[][3], int const types[],
+    int const num_atom, double const symprecs[], int const num_symprec,
+    double const angle_tolerance) {
+    int i, j, num_separated, num_found;
+    int *indices, *separated_numbers;
+    double max_separated, min_too_close;
+    double *separated_symprecs;
+    Cell *cell;
+
+    cell = NULL;
+    indices = NULL;
+    separated_numbers = NULL;
+    separated_symprecs = NULL;
+    num_separated = 0;
+    num_found = 0;
+
+    for (i = 0; i < num_symprec; i++) {
+        spacegroup_numbers[i] = 0;
+        hall_numbers[i] = 0;
+        n_operations[i] = 0;
+    }
+
+    arn_begin();
+    bdg_begin();
+
+    if ((cell = cel_alloc_cell(num_atom, NOSPIN)) == NULL) {
+        goto err;
+    }
+
+    cel_set_cell(cell, lattice, position, types);
+
+    /* indices[:num_separated] are the tolerances where atoms are */
+    /* separated, and separated_numbers hold the results at them in three */
+    /* blocks of num_symprec. */
+    if ((indices = (int *)arn_malloc(sizeof(int) * num_symprec)) == NULL ||
+        (separated_numbers =
+             (int *)arn_malloc(sizeof(int) * 3 * num_symprec)) == NULL ||
+        (separated_symprecs =
+             (double *)arn_malloc(sizeof(double) * num_symprec)) == NULL) {
+        warning_memory("tolerance_scan");
+        goto err;
+    }
+
+    /* Atoms that are too close at a tolerance are too close at larger */
+    /* ones too, so the overlaps are checked only at the tolerances between */
+    /* the largest separated one and the smallest too close one so far. */
+    /* The order of the tolerances is kept. */
+    max_separated = -1;
+    min_too_close = -1;
+    for (i = 0; i < num_symprec; i++) {
+        if (symprecs[i] > max_separated &&
+            (min_too_close < 0 || symprecs[i] < min_too_close)) {
+            if (cel_any_overlap_with_same_type(cell, symprecs[i])) {
+                min_too_close = symprecs[i];
+            } else {
+                max_separated = symprecs[i];
+            }
+        }
+        if (symprecs[i] <= max_separated) {
+            indices[num_separated] = i;
+            separated_symprecs[num_separated] = symprecs[i];
+            num_separated++;
+        }
+    }
+
+    if (num_separated > 0) {
+        num_found = det_scan_tolerances(
+            separated_numbers, separated_numbers + num_symprec,
+            separated_numbers + 2 * num_symprec, cell, separated_symprecs,
+            num_separated, angle_tolerance);
+        for (j = 0; j < num_separated; j++) {
+            spacegroup_numbers[indices[j]] = separated_numbers[j];
+            hall_numbers[indices[j]] = separated_numbers[num_symprec + j];
+            n_operations[indices[j]] = separated_numbers[2 * num_symprec + j];
+        }
+    }
+
+    arn_free(separated_symprecs);
+    separated_symprecs = NULL;
+    arn_free(separated_numbers);
+    separated_numbers = NULL;
+    arn_free(indices);
+    indices = NULL;
+    cel_free_cell(cell);
+    cell = NULL;
+
+    /* The scan may have given up on the way. */
+    if (bdg_has_exceeded()) {
+        for (i = 0; i < num_symprec; i++) {
+            spacegroup_numbers[i] = 0;
+            hall_numbers[i] = 0;
+            n_operations[i] = 0;
+        }
+        bdg_end();
+        arn_end();
+        spglib_error_code = SPGERR_WORK_BUDGET_EXCEEDED;
+        return 0;
+    }
+    bdg_end();
+    arn_end();
+
+    if (num_found > 0) {
+        spglib_error_code = SPGLIB_SUCCESS;
+        return num_found;
+    }
+
+    for (i = 0; i < num_symprec; i++) {
+        n_operations[i] = 0;
+    }
+    if (num_separated == 0 && num_symprec > 0) {
+        spglib_error_code = SPGERR_ATOMS_TOO_CLOSE;
+    } else {
+        spglib_error_code = SPGERR_SPACEGROUP_SEARCH_FAILED;
+    }
+    return 0;
+
+err:
+    arn_free(separated_symprecs);
+    separated_symprecs = NULL;
+    arn_free(separated_numbers);
+    separated_numbers = NULL;
+    arn_free(indices);
+    indices = NULL;
+    cel_free_cell(cell);
+    cell = NULL;
+    bdg_end();
+    arn_end();
+    spglib_error_code = SPGERR_SPACEGROUP_SEARCH_FAILED;
+    return 0;
+}
+
 /* Return NULL if failed */
 static SpglibDataset *get_layer_dataset(
     double const lattice[3][3], double const position[][3], int const types[],
@@ -1124,13 +1631,11 @@ static SpglibDataset *get_layer_dataset(
     cell = NULL;
     container = NULL;
 
-    if ((dataset = init_dataset()) == NULL) {
-        goto not_found;
-    }
+    /* Everything except for the dataset is allocated in the arena. */
+    arn_begin();
+    bdg_begin();
 
     if ((cell = cel_alloc_cell(num_atom, NOSPIN)) == NULL) {
-        free(dataset);
-        dataset = NULL;
         goto not_found;
     }
 
@@ -1139,8 +1644,6 @@ static SpglibDataset *get_layer_dataset(
         if (cel_any_overlap_with_same_type(cell, symprec)) {
             cel_free_cell(cell);
             cell = NULL;
-            free(dataset);
-            dataset = NULL;
             goto atoms_too_close;
         }
     } else {
@@ -1155,16 +1658,24 @@ static SpglibDataset *get_layer_dataset(
                                                  symprec)) {
             cel_free_cell(cell);
             cell = NULL;
-            free(dataset);
-            dataset = NULL;
             goto atoms_too_close;
         }
     }
 
-    if ((container = det_determine_all(cell, hall_number, symprec,
-                                       angle_tolerance)) != NULL) {
-        if (set_dataset(dataset, cell, container->primitive,
-                        container->spacegroup, container->exact_structure)) {
+    container = det_determine_all(cell, hall_number, REFINE_POSITIONS,
+                                  symprec, angle_tolerance);
+
+    /* The search may have given up on the way. */
+    if (bdg_has_exceeded()) {
+        det_free_container(container);
+        container = NULL;
+    }
+
+    if (container != NULL) {
+        if ((dataset = new_dataset(NULL, 0, cell, container->primitive,
+                                   container->spacegroup,
+                                   container->exact_structure,
+                                   SPGLIB_DATASET_ALL, 0)) != NULL) {
             det_free_container(container);
             container = NULL;
             cel_free_cell(cell);
@@ -1177,19 +1688,23 @@ static SpglibDataset *get_layer_dataset(
 
     cel_free_cell(cell);
     cell = NULL;
-    free(dataset);
-    dataset = NULL;
 
 not_found:
-    spglib_error_code = SPGERR_SPACEGROUP_SEARCH_FAILED;
+    spglib_error_code = bdg_has_exceeded() ? SPGERR_WORK_BUDGET_EXCEEDED
+                                           : SPGERR_SPACEGROUP_SEARCH_FAILED;
+    bdg_end();
+    arn_end();
     return NULL;
 
 atoms_too_close:
+    bdg_end();
+    arn_end();
     spglib_error_code = SPGERR_ATOMS_TOO_CLOSE;
     return NULL;
 
 found:
-
+    bdg_end();
+    arn_end();
     spglib_error_code = SPGLIB_SUCCESS;
     return dataset;
 }
@@ -1236,11 +1751,6 @@ static SpglibMagneticDataset *get_magnetic_dataset(
         goto finalize;
     }
 
-    if ((dataset = init_magnetic_dataset()) == NULL) {
-        spglib_error_code = SPGERR_SPACEGROUP_SEARCH_FAILED;
-        goto finalize;
-    }
-
     /* Get magnetic symmetry operations of MSG */
     if ((magnetic_symmetry = get_symmetry_with_site_tensors(
              equivalent_atoms, &permutations, primitive_lattice, cell,
@@ -1274,9 +1784,9 @@ static SpglibMagneticDataset *get_magnetic_dataset(
         goto finalize;
     }
 
-    if (!set_magnetic_dataset(dataset, cell->size, exact_cell_std,
-                              magnetic_symmetry, msgdata, equivalent_atoms,
-                              primitive_lattice)) {
+    if ((dataset = new_magnetic_dataset(
+             cell->size, exact_cell_std, magnetic_symmetry, msgdata,
+             equivalent_atoms, primitive_lattice)) == NULL) {
         spglib_error_code = SPGERR_NONE;
         goto finalize;
     }
@@ -1309,11 +1819,11 @@ finalize:
         magnetic_symmetry = NULL;
     }
     if (fsg != NULL) {
-        free(fsg);
+        arn_free(fsg);
         fsg = NULL;
     }
     if (xsg != NULL) {
-        free(xsg);
+        arn_free(xsg);
         xsg = NULL;
     }
     if (representatives != NULL) {
@@ -1333,100 +1843,209 @@ finalize:
     }
 }
 
-static SpglibDataset *init_dataset(void) {
-    int i, j;
-    SpglibDataset *dataset;
+/* Arrays in the memory block of a dataset start at 16-byte boundaries. */
+static size_t get_aligned_size(size_t const size) {
+    return (size + 15) / 16 * 16;
+}
 
-    dataset = NULL;
+/* Return the array at the head of the block, and move the head to the */
+/* next array. Return NULL for an empty array. */
+static void *take_array(char **block, size_t const size) {
+    void *array;
 
-    if ((dataset = (SpglibDataset *)malloc(sizeof(SpglibDataset))) == NULL) {
-        warning_memory("dataset");
+    if (size == 0) {
         return NULL;
     }
+    array = *block;
+    *block += get_aligned_size(size);
+    return array;
+}
+
+/* Size in bytes of the memory block of a dataset. The arrays of Wyckoff */
+/* positions and equivalent atoms are included if with_wyckoffs is true. */
+static size_t get_dataset_size(int const n_operations,
+                               int const n_pure_translations, int const n_atoms,
+                               int const with_wyckoffs, int const n_std_atoms) {
+    int n_wyckoff_atoms;
+
+    n_wyckoff_atoms = with_wyckoffs ? n_atoms : 0;
+    return get_aligned_size(sizeof(SpglibDataset)) +
+           get_aligned_size(sizeof(int[3][3]) * n_operations) +
+           get_aligned_size(sizeof(double[3]) * n_operations) +
+           get_aligned_size(sizeof(double[3]) * n_pure_translations) +
+           get_aligned_size(sizeof(int) * n_atoms) +
+           get_aligned_size(sizeof(int) * n_wyckoff_atoms) * 3 +
+           get_aligned_size(sizeof(char[7]) * n_wyckoff_atoms) +
+           get_aligned_size(sizeof(double[3]) * n_std_atoms) +
+           get_aligned_size(sizeof(int) * n_std_atoms) * 2;
+}
+
+/* The dataset and all its arrays are allocated in one memory block, */
+/* which is released by spg_free_dataset with a single free. When buffer */
+/* is given, the block is placed at the first 16-byte boundary in buffer */
+/* instead. Only the numbers of elements and the arrays are set. */
+/* Return NULL if failed */
+static SpglibDataset *alloc_dataset(void *buffer, size_t const buffer_size,
+                                    int const n_operations,
+                                    int const n_pure_translations,
+                                    int const n_atoms, int const with_wyckoffs,
+                                    int const n_std_atoms) {
+    size_t size, offset;
+    SpglibDataset *dataset;
 
-    dataset->spacegroup_number = 0;
-    dataset->hall_number = 0;
-    strcpy(dataset->international_symbol, "");
-    strcpy(dataset->hall_symbol, "");
-    strcpy(dataset->choice, "");
-    dataset->origin_shift[0] = 0;
-    dataset->origin_shift[1] = 0;
-    dataset->origin_shift[2] = 0;
-    dataset->n_atoms = 0;
-    dataset->wyckoffs = NULL;
-    dataset->equivalent_atoms = NULL;
-    dataset->crystallographic_orbits = NULL;
-    dataset->mapping_to_primitive = NULL;
-    dataset->n_operations = 0;
-    dataset->rotations = NULL;
-    dataset->translations = NULL;
-    dataset->n_std_atoms = 0;
-    dataset->std_positions = NULL;
-    dataset->std_types = NULL;
-    for (i = 0; i < 3; i++) {
-        for (j = 0; j < 3; j++) {
-            dataset->std_rotation_matrix[i][j] = 0;
+    size = get_dataset_size(n_operations, n_pure_translations, n_atoms,
+                            with_wyckoffs, n_std_atoms);
+
+    if (buffer == NULL) {
+        if ((dataset = (SpglibDataset *)malloc(size)) == NULL) {
+            warning_memory("dataset");
+            return NULL;
+        }
+    } else {
+        offset = get_aligned_size((uintptr_t)buffer) - (uintptr_t)buffer;
+        if (offset + size > buffer_size) {
+            return NULL;
         }
+        dataset = (SpglibDataset *)((char *)buffer + offset);
     }
-    dataset->std_mapping_to_primitive = NULL;
-    /* dataset->pointgroup_number = 0; */
-    strcpy(dataset->pointgroup_symbol, "");
+
+    dataset->n_operations = n_operations;
+    dataset->n_pure_translations = n_pure_translations;
+    dataset->n_atoms = n_atoms;
+    dataset->n_std_atoms = n_std_atoms;
+    set_dataset_arrays(dataset, with_wyckoffs);
 
     return dataset;
 }
 
-/* If failed, return NULL. */
-static SpglibMagneticDataset *init_magnetic_dataset(void) {
-    int i, j;
-    SpglibMagneticDataset *dataset;
+/* The arrays are placed in the block of the dataset in this order from */
+/* the numbers of elements in the dataset. Empty arrays are NULL. */
+static void set_dataset_arrays(SpglibDataset *dataset,
+                               int const with_wyckoffs) {
+    int n_operations, n_atoms, n_wyckoff_atoms, n_std_atoms;
+    char *block;
 
-    dataset = NULL;
+    n_operations = dataset->n_operations;
+    n_atoms = dataset->n_atoms;
+    n_wyckoff_atoms = with_wyckoffs ? n_atoms : 0;
+    n_std_atoms = dataset->n_std_atoms;
 
-    if ((dataset = (SpglibMagneticDataset *)malloc(
-             sizeof(SpglibMagneticDataset))) == NULL) {
-        warning_memory("dataset");
+    block = (char *)dataset + get_aligned_size(sizeof(SpglibDataset));
+    dataset->rotations =
+        (int(*)[3][3])take_array(&block, sizeof(int[3][3]) * n_operations);
+    dataset->translations =
+        (double(*)[3])take_array(&block, sizeof(double[3]) * n_operations);
+    dataset->pure_translations = (double(*)[3])take_array(
+        &block, sizeof(double[3]) * dataset->n_pure_translations);
+    dataset->wyckoffs =
+        (int *)take_array(&block, sizeof(int) * n_wyckoff_atoms);
+    dataset->equivalent_atoms =
+        (int *)take_array(&block, sizeof(int) * n_wyckoff_atoms);
+    dataset->crystallographic_orbits =
+        (int *)take_array(&block, sizeof(int) * n_wyckoff_atoms);
+    dataset->mapping_to_primitive =
+        (int *)take_array(&block, sizeof(int) * n_atoms);
+    dataset->site_symmetry_symbols =
+        (char(*)[7])take_array(&block, sizeof(char[7]) * n_wyckoff_atoms);
+    dataset->std_positions =
+        (double(*)[3])take_array(&block, sizeof(double[3]) * n_std_atoms);
+    dataset->std_types = (int *)take_array(&block, sizeof(int) * n_std_atoms);
+    dataset->std_mapping_to_primitive =
+        (int *)take_array(&block, sizeof(int) * n_std_atoms);
+}
+
+/* The magnetic dataset and all its arrays are allocated in one memory */
+/* block as alloc_dataset. Return NULL if failed */
+static SpglibMagneticDataset *alloc_magnetic_dataset(
+    int const n_operations, int const n_atoms, int const n_std_atoms,
+    int const tensor_rank) {
+    int n_tensors;
+    size_t size;
+    char *block;
+    SpglibMagneticDataset *dataset;
+
+    if (tensor_rank == COLLINEAR) {
+        n_tensors = n_std_atoms;
+    } else if (tensor_rank == NONCOLLINEAR) {
+        n_tensors = n_std_atoms * 3;
+    } else {
+        /* NotImplemented */
         return NULL;
     }
 
-    dataset->uni_number = 0;
-    dataset->msg_type = 0;
-    dataset->hall_number = 0;
-    dataset->tensor_rank = 0;
-    dataset->n_operations = 0;
-    dataset->rotations = NULL;
-    dataset->translations = NULL;
-    dataset->time_reversals = NULL;
-    dataset->n_atoms = 0;
-    dataset->equivalent_atoms = NULL;
-    dataset->n_std_atoms = 0;
-    dataset->std_types = NULL;
-    dataset->std_positions = NULL;
-    dataset->std_tensors = NULL;
+    size = get_aligned_size(sizeof(SpglibMagneticDataset)) +
+           get_aligned_size(sizeof(int[3][3]) * n_operations) +
+           get_aligned_size(sizeof(double[3]) * n_operations) +
+           get_aligned_size(sizeof(int) * n_operations) +
+           get_aligned_size(sizeof(int) * n_atoms) +
+           get_aligned_size(sizeof(int) * n_std_atoms) +
+           get_aligned_size(sizeof(double[3]) * n_std_atoms) +
+           get_aligned_size(sizeof(double) * n_tensors);
 
-    for (i = 0; i < 3; i++) {
-        dataset->origin_shift[i] = 0;
-
-        for (j = 0; j < 3; j++) {
-            dataset->transformation_matrix[i][j] = 0;
-            dataset->std_lattice[i][j] = 0;
-            dataset->primitive_lattice[i][j] = 0;
-            dataset->std_rotation_matrix[i][j] = 0;
-        }
+    if ((dataset = (SpglibMagneticDataset *)malloc(size)) == NULL) {
+        warning_memory("dataset");
+        return NULL;
     }
 
+    block = (char *)dataset + get_aligned_size(sizeof(SpglibMagneticDataset));
+    dataset->n_operations = n_operations;
+    dataset->rotations =
+        (int(*)[3][3])take_array(&block, sizeof(int[3][3]) * n_operations);
+    dataset->translations =
+        (double(*)[3])take_array(&block, sizeof(double[3]) * n_operations);
+    dataset->time_reversals =
+        (int *)take_array(&block, sizeof(int) * n_operations);
+    dataset->n_atoms = n_atoms;
+    dataset->equivalent_atoms =
+        (int *)take_array(&block, sizeof(int) * n_atoms);
+    dataset->n_std_atoms = n_std_atoms;
+    dataset->std_types = (int *)take_array(&block, sizeof(int) * n_std_atoms);
+    dataset->std_positions =
+        (double(*)[3])take_array(&block, sizeof(double[3]) * n_std_atoms);
+    dataset->std_tensors =
+        (double *)take_array(&block, sizeof(double) * n_tensors);
+
     return dataset;
 }
 
-/* Return 0 if failed */
-static int set_dataset(SpglibDataset *dataset, Cell const *cell,
-                       Primitive const *primitive, Spacegroup const *spacegroup,
-                       ExactStructure *exstr) {
-    int i, j;
+/* exstr has to be computed at get_refine_level(options) or higher. */
+/* Return NULL if failed */
+static SpglibDataset *new_dataset(void *buffer, size_t const buffer_size,
+                                  Cell const *cell, Primitive const *primitive,
+                                  Spacegroup const *spacegroup,
+                                  ExactStructure const *exstr,
+                                  int const options, int const is_factorized) {
+    int i, j, n_operations, n_pure_translations, n_std_atoms, with_wyckoffs;
     double inv_lat[3][3];
     Pointgroup pointgroup;
+    SpglibDataset *dataset;
+
+    /* The first n_operations operations are the coset representatives of */
+    /* the pure translations. */
+    if (!(options & SPGLIB_DATASET_OPERATIONS)) {
+        n_pure_translations = 0;
+        n_operations = 0;
+    } else if (is_factorized) {
+        n_pure_translations = exstr->pure_trans->size;
+        n_operations = exstr->symmetry->size / n_pure_translations;
+    } else {
+        n_pure_translations = 0;
+        n_operations = exstr->symmetry->size;
+    }
+    with_wyckoffs = (options & SPGLIB_DATASET_WYCKOFFS) != 0;
+    if (options & SPGLIB_DATASET_STD_CELL) {
+        n_std_atoms = exstr->bravais->size;
+    } else {
+        n_std_atoms = 0;
+    }
+
+    if ((dataset = alloc_dataset(buffer, buffer_size, n_operations,
+                                 n_pure_translations, cell->size,
+                                 with_wyckoffs, n_std_atoms)) == NULL) {
+        return NULL;
+    }
 
     /* Spacegroup type, transformation matrix, origin shift */
-    dataset->n_atoms = cell->size;
     dataset->spacegroup_number = spacegroup->number;
     dataset->hall_number = spacegroup->hall_number;
     memcpy(dataset->international_symbol, spacegroup->international_short, 11);
@@ -1437,51 +2056,18 @@ static int set_dataset(SpglibDataset *dataset, Cell const *cell,
                            cell->lattice);
     mat_copy_vector_d3(dataset->origin_shift, spacegroup->origin_shift);
 
-    dataset->n_operations = exstr->symmetry->size;
-
-    if ((dataset->rotations = (int(*)[3][3])malloc(
-             sizeof(int[3][3]) * dataset->n_operations)) == NULL) {
-        warning_memory("dataset->rotations");
-        goto err;
-    }
-
-    if ((dataset->translations = (double(*)[3])malloc(
-             sizeof(double[3]) * dataset->n_operations)) == NULL) {
-        warning_memory("dataset->translations");
-        goto err;
+    for (i = 0; i < dataset->n_pure_translations; i++) {
+        mat_copy_vector_d3(dataset->pure_translations[i],
+                           exstr->pure_trans->vec[i]);
     }
 
-    for (i = 0; i < exstr->symmetry->size; i++) {
+    for (i = 0; i < dataset->n_operations; i++) {
         mat_copy_matrix_i3(dataset->rotations[i], exstr->symmetry->rot[i]);
         mat_copy_vector_d3(dataset->translations[i], exstr->symmetry->trans[i]);
     }
 
     /* Wyckoff positions */
-    if ((dataset->wyckoffs = (int *)malloc(sizeof(int) * dataset->n_atoms)) ==
-        NULL) {
-        warning_memory("dataset->wyckoffs");
-        goto err;
-    }
-
-    if ((dataset->site_symmetry_symbols =
-             (char(*)[7])malloc(sizeof(char[7]) * dataset->n_atoms)) == NULL) {
-        warning_memory("dataset->site_symmetry_symbols");
-        goto err;
-    }
-
-    if ((dataset->equivalent_atoms =
-             (int *)malloc(sizeof(int) * dataset->n_atoms)) == NULL) {
-        warning_memory("dataset->equivalent_atoms");
-        goto err;
-    }
-
-    if ((dataset->crystallographic_orbits =
-             (int *)malloc(sizeof(int) * dataset->n_atoms)) == NULL) {
-        warning_memory("dataset->crystallographic_orbits");
-        goto err;
-    }
-
-    for (i = 0; i < dataset->n_atoms; i++) {
+    for (i = 0; with_wyckoffs && i < dataset->n_atoms; i++) {
         dataset->wyckoffs[i] = exstr->wyckoffs[i];
         for (j = 0; j < 7; j++) {
             dataset->site_symmetry_symbols[i][j] =
@@ -1491,47 +2077,28 @@ static int set_dataset(SpglibDataset *dataset, Cell const *cell,
         dataset->crystallographic_orbits[i] = exstr->crystallographic_orbits[i];
     }
 
-    if ((dataset->mapping_to_primitive =
-             (int *)malloc(sizeof(int) * dataset->n_atoms)) == NULL) {
-        warning_memory("dataset->mapping_to_primitive");
-        goto err;
-    }
-
-    debug_print("refined cell after ref_get_Wyckoff_positions\n");
-    debug_print_matrix_d3(exstr->bravais->lattice);
-    for (i = 0; i < exstr->bravais->size; i++) {
-        debug_print("%d: %f %f %f\n", exstr->bravais->types[i],
-                    exstr->bravais->position[i][0],
-                    exstr->bravais->position[i][1],
-                    exstr->bravais->position[i][2]);
-    }
-
     mat_copy_matrix_d3(dataset->primitive_lattice, primitive->cell->lattice);
     for (i = 0; i < dataset->n_atoms; i++) {
         dataset->mapping_to_primitive[i] = primitive->mapping_table[i];
     }
 
-    dataset->n_std_atoms = exstr->bravais->size;
-    mat_copy_matrix_d3(dataset->std_lattice, exstr->bravais->lattice);
-
-    if ((dataset->std_positions = (double(*)[3])malloc(
-             sizeof(double[3]) * dataset->n_std_atoms)) == NULL) {
-        warning_memory("dataset->std_positions");
-        goto err;
-    }
-
-    if ((dataset->std_types =
-             (int *)malloc(sizeof(int) * dataset->n_std_atoms)) == NULL) {
-        warning_memory("dataset->std_types");
-        goto err;
-    }
-
-    if ((dataset->std_mapping_to_primitive =
-             (int *)malloc(sizeof(int) * dataset->n_std_atoms)) == NULL) {
-        warning_memory("dataset->std_mapping_to_primitive");
-        goto err;
+    /* The standardized lattice and rotation are zeros if not computed. */
+    if (options & SPGLIB_DATASET_STD_CELL) {
+        debug_print("refined cell after ref_get_Wyckoff_positions\n");
+        debug_print_matrix_d3(exstr->bravais->lattice);
+        for (i = 0; i < exstr->bravais->size; i++) {
+            debug_print("%d: %f %f %f\n", exstr->bravais->types[i],
+                        exstr->bravais->position[i][0],
+                        exstr->bravais->position[i][1],
+                        exstr->bravais->position[i][2]);
+        }
+        mat_copy_matrix_d3(dataset->std_lattice, exstr->bravais->lattice);
+        mat_copy_matrix_d3(dataset->std_rotation_matrix, exstr->rotation);
+    } else {
+        memset(dataset->std_lattice, 0, sizeof(dataset->std_lattice));
+        memset(dataset->std_rotation_matrix, 0,
+               sizeof(dataset->std_rotation_matrix));
     }
-
     for (i = 0; i < dataset->n_std_atoms; i++) {
         mat_copy_vector_d3(dataset->std_positions[i],
                            exstr->bravais->position[i]);
@@ -1540,62 +2107,26 @@ static int set_dataset(SpglibDataset *dataset, Cell const *cell,
             exstr->std_mapping_to_primitive[i];
     }
 
-    mat_copy_matrix_d3(dataset->std_rotation_matrix, exstr->rotation);
-
     /* dataset->pointgroup_number = spacegroup->pointgroup_number; */
     pointgroup = ptg_get_pointgroup(spacegroup->pointgroup_number);
     memcpy(dataset->pointgroup_symbol, pointgroup.symbol, 6);
 
-    return 1;
-
-err:
-    if (dataset->std_positions != NULL) {
-        free(dataset->std_positions);
-        dataset->std_positions = NULL;
-    }
-    if (dataset->std_mapping_to_primitive != NULL) {
-        free(dataset->std_mapping_to_primitive);
-        dataset->std_mapping_to_primitive = NULL;
-    }
-    if (dataset->equivalent_atoms != NULL) {
-        free(dataset->equivalent_atoms);
-        dataset->equivalent_atoms = NULL;
-    }
-    if (dataset->crystallographic_orbits != NULL) {
-        free(dataset->crystallographic_orbits);
-        dataset->crystallographic_orbits = NULL;
-    }
-    if (dataset->mapping_to_primitive != NULL) {
-        free(dataset->mapping_to_primitive);
-        dataset->mapping_to_primitive = NULL;
-    }
-    if (dataset->site_symmetry_symbols != NULL) {
-        free(dataset->site_symmetry_symbols);
-        dataset->site_symmetry_symbols = NULL;
-    }
-    if (dataset->wyckoffs != NULL) {
-        free(dataset->wyckoffs);
-        dataset->wyckoffs = NULL;
-    }
-    if (dataset->translations != NULL) {
-        free(dataset->translations);
-        dataset->translations = NULL;
-    }
-    if (dataset->rotations != NULL) {
-        free(dataset->rotations);
-        dataset->rotations = NULL;
-    }
-
-    return 0;
+    return dataset;
 }
 
-static int set_magnetic_dataset(SpglibMagneticDataset *dataset,
-                                int const num_atoms, Cell const *cell_std,
-                                MagneticSymmetry const *magnetic_symmetry,
-                                MagneticDataset const *msgdata,
-                                int const *equivalent_atoms,
-                                double const primitive_lattice[3][3]) {
+/* Return NULL if failed */
+static SpglibMagneticDataset *new_magnetic_dataset(
+    int const num_atoms, Cell const *cell_std,
+    MagneticSymmetry const *magnetic_symmetry, MagneticDataset const *msgdata,
+    int const *equivalent_atoms, double const primitive_lattice[3][3]) {
     int i, s;
+    SpglibMagneticDataset *dataset;
+
+    if ((dataset = alloc_magnetic_dataset(magnetic_symmetry->size, num_atoms,
+                                          cell_std->size,
+                                          cell_std->tensor_rank)) == NULL) {
+        return NULL;
+    }
 
     /* Magnetic space-group type */
     dataset->uni_number = msgdata->uni_number;
@@ -1604,22 +2135,6 @@ static int set_magnetic_dataset(SpglibMagneticDataset *dataset,
     dataset->tensor_rank = cell_std->tensor_rank;
 
     /* Magnetic symmetry operations */
-    dataset->n_operations = magnetic_symmetry->size;
-    if ((dataset->rotations = (int(*)[3][3])malloc(
-             sizeof(int[3][3]) * dataset->n_operations)) == NULL) {
-        warning_memory("dataset->rotations");
-        goto err;
-    }
-    if ((dataset->translations = (double(*)[3])malloc(
-             sizeof(double[3]) * dataset->n_operations)) == NULL) {
-        warning_memory("dataset->translations");
-        goto err;
-    }
-    if ((dataset->time_reversals =
-             (int *)malloc(sizeof(int *) * dataset->n_operations)) == NULL) {
-        warning_memory("dataset->time_reversals");
-        goto err;
-    }
     for (i = 0; i < dataset->n_operations; i++) {
         mat_copy_matrix_i3(dataset->rotations[i], magnetic_symmetry->rot[i]);
         mat_copy_vector_d3(dataset->translations[i],
@@ -1628,12 +2143,6 @@ static int set_magnetic_dataset(SpglibMagneticDataset *dataset,
     }
 
     /* Equivalent atoms */
-    dataset->n_atoms = num_atoms;
-    if ((dataset->equivalent_atoms =
-             (int *)malloc(sizeof(int) * dataset->n_atoms)) == NULL) {
-        warning_memory("dataset->equivalent_atoms");
-        goto err;
-    }
     for (i = 0; i < dataset->n_atoms; i++) {
         dataset->equivalent_atoms[i] = equivalent_atoms[i];
     }
@@ -1644,18 +2153,7 @@ static int set_magnetic_dataset(SpglibMagneticDataset *dataset,
     mat_copy_vector_d3(dataset->origin_shift, msgdata->origin_shift);
 
     /* Standardized crystal structure */
-    dataset->n_std_atoms = cell_std->size;
     mat_copy_matrix_d3(dataset->std_lattice, cell_std->lattice);
-
-    if ((dataset->std_types =
-             (int *)malloc(sizeof(int) * dataset->n_std_atoms)) == NULL)
-        goto err;
-    if ((dataset->std_positions = (double(*)[3])malloc(
-             sizeof(double[3]) * dataset->n_std_atoms)) == NULL)
-        goto err;
-    if ((dataset->std_tensors = spn_alloc_site_tensors(
-             dataset->n_std_atoms, cell_std->tensor_rank)) == NULL)
-        goto err;
     for (i = 0; i < dataset->n_std_atoms; i++) {
         dataset->std_types[i] = cell_std->types[i];
         for (s = 0; s < 3; s++) {
@@ -1676,39 +2174,18 @@ static int set_magnetic_dataset(SpglibMagneticDataset *dataset,
     /* Intermediate datum in symmetry search */
     mat_copy_matrix_d3(dataset->primitive_lattice, primitive_lattice);
 
-    return 1;
+    return dataset;
+}
 
-err:
-    if (dataset->rotations != NULL) {
-        free(dataset->rotations);
-        dataset->rotations = NULL;
-    }
-    if (dataset->translations != NULL) {
-        free(dataset->translations);
-        dataset->translations = NULL;
-    }
-    if (dataset->time_reversals != NULL) {
-        free(dataset->time_reversals);
-        dataset->time_reversals = NULL;
-    }
-    if (dataset->equivalent_atoms != NULL) {
-        free(dataset->equivalent_atoms);
-        dataset->equivalent_atoms = NULL;
+/* Standardized cell and Wyckoff positions are computed together. */
+static RefineLevel get_refine_level(int const options) {
+    if (options & (SPGLIB_DATASET_WYCKOFFS | SPGLIB_DATASET_STD_CELL)) {
+        return REFINE_POSITIONS;
     }
-    if (dataset->std_types != NULL) {
-        free(dataset->std_types);
-        dataset->std_types = NULL;
+    if (options & SPGLIB_DATASET_OPERATIONS) {
+        return REFINE_SYMMETRY;
     }
-    if (dataset->std_positions != NULL) {
-        free(dataset->std_positions);
-        dataset->std_positions = NULL;
-    }
-    if (dataset->std_tensors != NULL) {
-        free(dataset->std_tensors);
-        dataset->std_tensors = NULL;
-    }
-
-    return 0;
+    return REFINE_SPACEGROUP;
 }
 
 /* Return 0 if failed */
@@ -1722,7 +2199,8 @@ static int get_symmetry_from_dataset(
     num_sym = 0;
     dataset = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_OPERATIONS, symprec,
                                angle_tolerance)) == NULL) {
         return 0;
     }
@@ -1770,8 +2248,8 @@ static MagneticSymmetry *get_symmetry_with_site_tensors(
     equiv_atoms = NULL;
 
     if ((dataset = get_dataset(cell->lattice, cell->position, cell->types,
-                               cell->size, 0, symprec, angle_tolerance)) ==
-        NULL) {
+                               cell->size, 0, SPGLIB_DATASET_OPERATIONS,
+                               symprec, angle_tolerance)) == NULL) {
         goto err;
     }
 
@@ -1831,7 +2309,8 @@ static int get_multiplicity(double const lattice[3][3],
     size = 0;
     dataset = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_OPERATIONS, symprec,
                                angle_tolerance)) == NULL) {
         return 0;
     }
@@ -1861,7 +2340,8 @@ static int standardize_primitive(double lattice[3][3], double position[][3],
     primitive = NULL;
     bravais = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_STD_CELL, symprec,
                                angle_tolerance)) == NULL) {
         return 0;
     }
@@ -1941,7 +2421,8 @@ static int standardize_cell(double lattice[3][3], double position[][3],
     n_std_atoms = 0;
     dataset = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_STD_CELL, symprec,
                                angle_tolerance)) == NULL) {
         goto err;
     }
@@ -1991,7 +2472,8 @@ static int get_standardized_cell(double lattice[3][3], double position[][3],
     cell = NULL;
     primitive = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_SPACEGROUP_TYPE, symprec,
                                angle_tolerance)) == NULL) {
         goto err;
     }
@@ -2121,7 +2603,8 @@ static int get_international(char symbol[11], double const lattice[3][3],
 
     dataset = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_SPACEGROUP_TYPE, symprec,
                                angle_tolerance)) == NULL) {
         goto err;
     }
@@ -2156,7 +2639,8 @@ static int get_schoenflies(char symbol[7], double const lattice[3][3],
 
     dataset = NULL;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_SPACEGROUP_TYPE, symprec,
                                angle_tolerance)) == NULL) {
         goto err;
     }
@@ -2195,7 +2679,8 @@ static int get_ir_reciprocal_mesh(int grid_address[][3], int ir_mapping_table[],
     int num_ir, i;
     MatINT *rotations, *rot_reciprocal;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_OPERATIONS, symprec,
                                angle_tolerance)) == NULL) {
         return 0;
     }
@@ -2232,7 +2717,8 @@ static size_t get_dense_ir_reciprocal_mesh(
     size_t num_ir;
     MatINT *rotations, *rot_reciprocal;
 
-    if ((dataset = get_dataset(lattice, position, types, num_atom, 0, symprec,
+    if ((dataset = get_dataset(lattice, position, types, num_atom, 0,
+                               SPGLIB_DATASET_OPERATIONS, symprec,
                                angle_tolerance)) == NULL) {
         return 0;
     }
@@ -2403,7 +2889,7 @@ static int get_hall_number_from_symmetry(int const rotation[][3][3],
     prim_symmetry = NULL;
     if (spacegroup) {
         hall_number = spacegroup->hall_number;
-        free(spacegroup);
+        arn_free(spacegroup);
         spacegroup = NULL;
     } else {
         goto err;
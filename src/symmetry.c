@@ -38,12 +38,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "arena.h"
+#include "axes_database.h"
+#include "budget.h"
 #include "cell.h"
 #include "debug.h"
 #include "delaunay.h"
 #include "mathfunc.h"
 #include "overlap.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define NUM_ATOMS_CRITERION_FOR_OPENMP 1000
 #define ANGLE_REDUCE_RATE 0.95
 #define SIN_DTHETA2_CUTOFF 1e-12
@@ -51,69 +58,90 @@
 #define PI 3.14159265358979323846
 /* Tolerance of angle between lattice vectors in degrees */
 /* Negative value invokes converter from symprec. */
-static int relative_axes[][3] = {
-    {1, 0, 0},   {0, 1, 0},   {0, 0, 1},  {-1, 0, 0},  {0, -1, 0},   /* 5 */
-    {0, 0, -1},  {0, 1, 1},   {1, 0, 1},  {1, 1, 0},   {0, -1, -1},  /* 10 */
-    {-1, 0, -1}, {-1, -1, 0}, {0, 1, -1}, {-1, 0, 1},  {1, -1, 0},   /* 15 */
-    {0, -1, 1},  {1, 0, -1},  {-1, 1, 0}, {1, 1, 1},   {-1, -1, -1}, /* 20 */
-    {-1, 1, 1},  {1, -1, 1},  {1, 1, -1}, {1, -1, -1}, {-1, 1, -1},  /* 25 */
-    {-1, -1, 1},
-};
-
 static int identity[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
 
+static void init_search_context(SearchContext *context, Cell const *cell);
 static int get_index_with_least_atoms(Cell const *cell);
-static VecDBL *get_translation(int const rot[3][3], Cell const *cell,
+static OverlapChecker *get_overlap_checker(SearchContext *context);
+static void search_operation_translations(VecDBL *trans[],
+                                          PointSymmetry const *lattice_sym,
+                                          SearchContext *context,
+                                          double const symprec);
+static VecDBL *get_operation_translation(int const rot[3][3],
+                                         SearchContext *context,
+                                         double const symprec);
+static int verify_operation(int *is_symmetry, int permutation[],
+                            double *max_displacement, SearchContext *context,
+                            int const rot[3][3], double const trans[3],
+                            double const symprec);
+#ifdef _OPENMP
+static int set_thread_contexts(SearchContext *context, int const num_threads);
+#endif
+static VecDBL *get_translation(int const rot[3][3], SearchContext *context,
                                double const symprec, int const is_identity);
-static Symmetry *get_operations(Cell const *primitive, double const symprec,
+static Symmetry *get_operations(SearchContext *context, double const symprec,
                                 double const angle_symprec);
-static Symmetry *reduce_operation(Cell const *primitive,
+static Symmetry *reduce_operation(SearchContext *context,
                                   Symmetry const *symmetry,
                                   double const symprec,
                                   double const angle_symprec,
                                   int const is_pure_trans);
-static int search_translation_part(int atoms_found[], Cell const *cell,
+static int search_translation_part(int atoms_found[], SearchContext *context,
                                    int const rot[3][3],
                                    int const min_atom_index,
                                    double const origin[3], double const symprec,
-                                   int const is_identity);
+                                   int const is_identity,
+                                   int const candidates[]);
 static int search_pure_translations(int atoms_found[], Cell const *cell,
-                                    double const trans[3],
-                                    double const symprec);
+                                    OverlapChecker const *checker,
+                                    double const trans[3], double const symprec,
+                                    int const is_layer);
 static int is_overlap_all_atoms(double const test_trans[3], int const rot[3][3],
-                                Cell const *cell, double const symprec,
+                                SearchContext *context, double const symprec,
                                 int const is_identity);
 static PointSymmetry transform_pointsymmetry(
     PointSymmetry const *point_sym_prim, double const new_lattice[3][3],
     double const original_lattice[3][3]);
 static Symmetry *get_space_group_operations(PointSymmetry const *lattice_sym,
-                                            Cell const *primitive,
+                                            SearchContext *context,
                                             double const symprec);
 static void set_axes(int axes[3][3], int const a1, int const a2, int const a3);
-static PointSymmetry get_lattice_symmetry(Cell const *cell,
+static void set_axis_lengths_kept(int is_length_kept[3][26],
+                                  double const min_lattice[3][3],
+                                  double const metric_orig[3][3],
+                                  double const symprec);
+static PointSymmetry get_lattice_symmetry(SearchContext *context,
                                           double const symprec,
                                           double const angle_symprec);
+static int is_lattice_symmetry_reusable(SearchContext const *context,
+                                        double const min_lattice[3][3],
+                                        double const symprec,
+                                        double const angle_symprec);
 static int is_identity_metric(double const metric_rotated[3][3],
                               double const metric_orig[3][3],
                               double const symprec, double const angle_symprec);
 static double get_angle(double const metric[3][3], int const i, int const j);
 
-/* get_translation, search_translation_part and search_pure_translations */
+/* get_translation and search_translation_part */
 /* are duplicated to get the if statement outside the nested loops */
 /* I have not tested if it is better in efficiency. */
-static VecDBL *get_layer_translation(int const rot[3][3], Cell const *cell,
+static VecDBL *get_layer_translation(int const rot[3][3],
+                                     SearchContext *context,
                                      double const symprec,
                                      int const is_identity);
-static int search_layer_translation_part(int atoms_found[], Cell const *cell,
+static int search_layer_translation_part(int atoms_found[],
+                                         SearchContext *context,
                                          int const rot[3][3],
                                          int const min_atom_index,
                                          double const origin[3],
                                          double const symprec,
-                                         int const is_identity);
-static int search_layer_pure_translations(int atoms_found[], Cell const *cell,
-                                          double const trans[3],
-                                          int const periodic_axes[2],
-                                          double const symprec);
+                                         int const is_identity,
+                                         int const candidates[]);
+static int *get_pure_translation_candidates(SearchContext *context,
+                                            double const symprec);
+static void set_pure_translation_atoms(SearchContext *context,
+                                       int const atoms_found[],
+                                       double const symprec);
 
 /* Return NULL if failed */
 Symmetry *sym_alloc_symmetry(int const size) {
@@ -125,7 +153,7 @@ Symmetry *sym_alloc_symmetry(int const size) {
         return NULL;
     }
 
-    if ((symmetry = (Symmetry *)malloc(sizeof(Symmetry))) == NULL) {
+    if ((symmetry = (Symmetry *)arn_malloc(sizeof(Symmetry))) == NULL) {
         warning_memory("symmetry");
         return NULL;
     }
@@ -134,19 +162,19 @@ Symmetry *sym_alloc_symmetry(int const size) {
     symmetry->rot = NULL;
     symmetry->trans = NULL;
 
-    if ((symmetry->rot = (int(*)[3][3])malloc(sizeof(int[3][3]) * size)) ==
+    if ((symmetry->rot = (int(*)[3][3])arn_malloc(sizeof(int[3][3]) * size)) ==
         NULL) {
         warning_memory("symmetry->rot");
-        free(symmetry);
+        arn_free(symmetry);
         symmetry = NULL;
         return NULL;
     }
-    if ((symmetry->trans = (double(*)[3])malloc(sizeof(double[3]) * size)) ==
-        NULL) {
+    if ((symmetry->trans =
+             (double(*)[3])arn_malloc(sizeof(double[3]) * size)) == NULL) {
         warning_memory("symmetry->trans");
-        free(symmetry->rot);
+        arn_free(symmetry->rot);
         symmetry->rot = NULL;
-        free(symmetry);
+        arn_free(symmetry);
         symmetry = NULL;
         return NULL;
     }
@@ -156,12 +184,12 @@ Symmetry *sym_alloc_symmetry(int const size) {
 
 void sym_free_symmetry(Symmetry *symmetry) {
     if (symmetry->size > 0) {
-        free(symmetry->rot);
+        arn_free(symmetry->rot);
         symmetry->rot = NULL;
-        free(symmetry->trans);
+        arn_free(symmetry->trans);
         symmetry->trans = NULL;
     }
-    free(symmetry);
+    arn_free(symmetry);
 }
 
 /* Return NULL if failed */
@@ -174,7 +202,7 @@ MagneticSymmetry *sym_alloc_magnetic_symmetry(int const size) {
         return NULL;
     }
 
-    if ((symmetry = (MagneticSymmetry *)malloc(sizeof(MagneticSymmetry))) ==
+    if ((symmetry = (MagneticSymmetry *)arn_malloc(sizeof(MagneticSymmetry))) ==
         NULL) {
         warning_memory("symmetry");
         return NULL;
@@ -185,29 +213,29 @@ MagneticSymmetry *sym_alloc_magnetic_symmetry(int const size) {
     symmetry->trans = NULL;
     symmetry->timerev = NULL;
 
-    if ((symmetry->rot = (int(*)[3][3])malloc(sizeof(int[3][3]) * size)) ==
+    if ((symmetry->rot = (int(*)[3][3])arn_malloc(sizeof(int[3][3]) * size)) ==
         NULL) {
         warning_memory("symmetry->rot");
-        free(symmetry);
+        arn_free(symmetry);
         symmetry = NULL;
         return NULL;
     }
-    if ((symmetry->trans = (double(*)[3])malloc(sizeof(double[3]) * size)) ==
-        NULL) {
+    if ((symmetry->trans =
+             (double(*)[3])arn_malloc(sizeof(double[3]) * size)) == NULL) {
         warning_memory("symmetry->trans");
-        free(symmetry->rot);
+        arn_free(symmetry->rot);
         symmetry->rot = NULL;
-        free(symmetry);
+        arn_free(symmetry);
         symmetry = NULL;
         return NULL;
     }
-    if ((symmetry->timerev = (int *)malloc(sizeof(int *) * size)) == NULL) {
+    if ((symmetry->timerev = (int *)arn_malloc(sizeof(int *) * size)) == NULL) {
         warning_memory("symmetry->timerev");
-        free(symmetry->rot);
+        arn_free(symmetry->rot);
         symmetry->rot = NULL;
-        free(symmetry->trans);
+        arn_free(symmetry->trans);
         symmetry->trans = NULL;
-        free(symmetry);
+        arn_free(symmetry);
         symmetry = NULL;
         return NULL;
     }
@@ -216,44 +244,225 @@ MagneticSymmetry *sym_alloc_magnetic_symmetry(int const size) {
 
 void sym_free_magnetic_symmetry(MagneticSymmetry *symmetry) {
     if (symmetry->size > 0) {
-        free(symmetry->rot);
+        arn_free(symmetry->rot);
         symmetry->rot = NULL;
-        free(symmetry->trans);
+        arn_free(symmetry->trans);
         symmetry->trans = NULL;
-        free(symmetry->timerev);
+        arn_free(symmetry->timerev);
         symmetry->timerev = NULL;
     }
-    free(symmetry);
+    arn_free(symmetry);
 }
 
+/* The cell is not copied. It has to outlive the context and must not be */
+/* modified while the context is in use. */
 /* Return NULL if failed */
-Symmetry *sym_get_operation(Cell const *primitive, double const symprec,
+SearchContext *sym_alloc_search_context(Cell const *cell) {
+    SearchContext *context;
+
+    context = NULL;
+
+    if ((context = (SearchContext *)arn_malloc(sizeof(SearchContext))) ==
+        NULL) {
+        warning_memory("context");
+        return NULL;
+    }
+
+    init_search_context(context, cell);
+
+    return context;
+}
+
+void sym_free_search_context(SearchContext *context) {
+    int i;
+
+    if (context == NULL) {
+        return;
+    }
+    for (i = 0; i < context->num_thread_contexts; i++) {
+        if (context->thread_contexts[i].checker != NULL) {
+            ovl_overlap_checker_free(context->thread_contexts[i].checker);
+            context->thread_contexts[i].checker = NULL;
+        }
+        arn_free(context->thread_contexts[i].pure_trans_atoms);
+        context->thread_contexts[i].pure_trans_atoms = NULL;
+    }
+    arn_free(context->thread_contexts);
+    context->thread_contexts = NULL;
+    arn_free(context->failed_searches);
+    context->failed_searches = NULL;
+    arn_free(context->pure_trans_atoms);
+    context->pure_trans_atoms = NULL;
+    if (context->checker != NULL) {
+        ovl_overlap_checker_free(context->checker);
+        context->checker = NULL;
+    }
+    arn_free(context);
+}
+
+/* Return 1 if the step was recorded as failed with exactly these */
+/* tolerances. The searches are deterministic, so it would fail again. */
+int sym_has_failed(SearchContext const *context, SearchStep const step,
+                   double const symprec, double const angle_tolerance) {
+    int i;
+
+    for (i = 0; i < context->num_failed_searches; i++) {
+        if (context->failed_searches[i].step == step &&
+            context->failed_searches[i].symprec == symprec &&
+            context->failed_searches[i].angle_tolerance == angle_tolerance) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* The failure is simply not recorded if memory allocation fails. */
+void sym_set_failed(SearchContext *context, SearchStep const step,
+                    double const symprec, double const angle_tolerance) {
+    int max_failed_searches;
+    FailedSearch *failed_searches;
+
+    if (context->num_failed_searches == context->max_failed_searches) {
+        max_failed_searches = context->max_failed_searches * 2 + 16;
+        if ((failed_searches = (FailedSearch *)arn_realloc(
+                 context->failed_searches,
+                 sizeof(FailedSearch) * max_failed_searches)) == NULL) {
+            warning_memory("failed_searches");
+            return;
+        }
+        context->failed_searches = failed_searches;
+        context->max_failed_searches = max_failed_searches;
+    }
+
+    context->failed_searches[context->num_failed_searches].step = step;
+    context->failed_searches[context->num_failed_searches].symprec = symprec;
+    context->failed_searches[context->num_failed_searches].angle_tolerance =
+        angle_tolerance;
+    context->num_failed_searches++;
+}
+
+/* Return NULL if failed */
+Symmetry *sym_get_operation(SearchContext *context, double const symprec,
                             double const angle_tolerance) {
     debug_print("sym_get_operations:\n");
 
-    return get_operations(primitive, symprec, angle_tolerance);
+    return get_operations(context, symprec, angle_tolerance);
 }
 
 /* Return NULL if failed */
-Symmetry *sym_reduce_operation(Cell const *primitive, Symmetry const *symmetry,
-                               double const symprec,
+Symmetry *sym_reduce_operation(SearchContext *context,
+                               Symmetry const *symmetry, double const symprec,
                                double const angle_tolerance) {
-    return reduce_operation(primitive, symmetry, symprec, angle_tolerance, 0);
+    return reduce_operation(context, symmetry, symprec, angle_tolerance, 0);
+}
+
+/* Return 1 if all the operations of symmetry map the cell onto itself, */
+/* 0 if not, and -1 if failed. */
+int sym_check_operations(SearchContext *context, Symmetry const *symmetry,
+                         double const symprec) {
+    int i, is_overlap;
+
+    for (i = 0; i < symmetry->size; i++) {
+        is_overlap = is_overlap_all_atoms(
+            symmetry->trans[i], symmetry->rot[i], context, symprec,
+            mat_check_identity_matrix_i3(symmetry->rot[i], identity));
+        if (is_overlap != 1) {
+            return is_overlap;
+        }
+    }
+
+    return 1;
+}
+
+/* is_symmetry[i] = 1 if the i-th operation maps the cell onto itself, */
+/* otherwise 0. For those operations, the i-th operation maps the j-th */
+/* atom onto the permutations[i * size + j]-th atom with the largest */
+/* Cartesian displacement max_displacements[i]. For the others, they are */
+/* -1. permutations and max_displacements can be NULL. Large cells are */
+/* processed in parallel over the operations when OpenMP is enabled. */
+/* Return the number of the operations that hold, or -1 if failed. */
+int sym_verify_operations(int is_symmetry[], int permutations[],
+                          double max_displacements[], SearchContext *context,
+                          int const rot[][3][3], double const trans[][3],
+                          int const num_operations, double const symprec) {
+    int i, num_sym, is_failed;
+    int *permutation;
+    double *max_displacement;
+#ifdef _OPENMP
+    int num_threads;
+    SearchContext *thread_context;
+    WorkBudget *budget;
+#endif
+
+    is_failed = 0;
+
+#ifdef _OPENMP
+    num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+    if (context->cell->size >= NUM_ATOMS_CRITERION_FOR_OPENMP &&
+        num_operations > 1 && num_threads > 1 &&
+        set_thread_contexts(context, num_threads)) {
+        budget = bdg_get_budget();
+#pragma omp parallel private(thread_context, permutation, max_displacement) \
+    num_threads(num_threads)
+        {
+            bdg_begin_shared(budget);
+            thread_context = &context->thread_contexts[omp_get_thread_num()];
+#pragma omp for schedule(dynamic) reduction(| : is_failed)
+            for (i = 0; i < num_operations; i++) {
+                permutation = permutations == NULL
+                                  ? NULL
+                                  : permutations + i * context->cell->size;
+                max_displacement =
+                    max_displacements == NULL ? NULL : max_displacements + i;
+                is_failed |= !verify_operation(
+                    is_symmetry + i, permutation, max_displacement,
+                    thread_context, rot[i], trans[i], symprec);
+            }
+            bdg_end();
+        }
+        goto count;
+    }
+#endif
+
+    for (i = 0; i < num_operations; i++) {
+        permutation = permutations == NULL
+                          ? NULL
+                          : permutations + i * context->cell->size;
+        max_displacement =
+            max_displacements == NULL ? NULL : max_displacements + i;
+        is_failed |=
+            !verify_operation(is_symmetry + i, permutation, max_displacement,
+                              context, rot[i], trans[i], symprec);
+    }
+
+#ifdef _OPENMP
+count:
+#endif
+    if (is_failed) {
+        return -1;
+    }
+    num_sym = 0;
+    for (i = 0; i < num_operations; i++) {
+        num_sym += is_symmetry[i];
+    }
+    return num_sym;
 }
 
 /* Return NULL if failed */
-VecDBL *sym_get_pure_translation(Cell const *cell, double const symprec) {
+VecDBL *sym_get_pure_translation(SearchContext *context, double const symprec) {
     int multi;
+    Cell const *cell;
     VecDBL *pure_trans;
 
     debug_print("sym_get_pure_translation (tolerance = %f):\n", symprec);
 
+    cell = context->cell;
     multi = 0;
     pure_trans = NULL;
     if (cell->aperiodic_axis == -1) {
-        pure_trans = get_translation(identity, cell, symprec, 1);
+        pure_trans = get_translation(identity, context, symprec, 1);
     } else {
-        pure_trans = get_layer_translation(identity, cell, symprec, 1);
+        pure_trans = get_layer_translation(identity, context, symprec, 1);
     }
     if (pure_trans == NULL) {
         debug_print("spglib: get_translation failed.\n");
@@ -273,7 +482,8 @@ VecDBL *sym_get_pure_translation(Cell const *cell, double const symprec) {
 }
 
 /* Return NULL if failed */
-VecDBL *sym_reduce_pure_translation(Cell const *cell, VecDBL const *pure_trans,
+VecDBL *sym_reduce_pure_translation(SearchContext *context,
+                                    VecDBL const *pure_trans,
                                     double const symprec,
                                     double const angle_tolerance) {
     int i, multi;
@@ -295,7 +505,7 @@ VecDBL *sym_reduce_pure_translation(Cell const *cell, VecDBL const *pure_trans,
         mat_copy_vector_d3(symmetry->trans[i], pure_trans->vec[i]);
     }
 
-    if ((symmetry_reduced = reduce_operation(cell, symmetry, symprec,
+    if ((symmetry_reduced = reduce_operation(context, symmetry, symprec,
                                              angle_tolerance, 1)) == NULL) {
         sym_free_symmetry(symmetry);
         symmetry = NULL;
@@ -333,7 +543,7 @@ VecDBL *sym_reduce_pure_translation(Cell const *cell, VecDBL const *pure_trans,
 /* 3) The spacegroup operations for the primitive cell are */
 /*    transformed to those of original input cells, if the input cell */
 /*    was not a primitive cell. */
-static Symmetry *get_operations(Cell const *primitive, double const symprec,
+static Symmetry *get_operations(SearchContext *context, double const symprec,
                                 double const angle_symprec) {
     PointSymmetry lattice_sym;
     Symmetry *symmetry;
@@ -342,12 +552,12 @@ static Symmetry *get_operations(Cell const *primitive, double const symprec,
 
     symmetry = NULL;
 
-    lattice_sym = get_lattice_symmetry(primitive, symprec, angle_symprec);
+    lattice_sym = get_lattice_symmetry(context, symprec, angle_symprec);
     if (lattice_sym.size == 0) {
         return NULL;
     }
 
-    if ((symmetry = get_space_group_operations(&lattice_sym, primitive,
+    if ((symmetry = get_space_group_operations(&lattice_sym, context,
                                                symprec)) == NULL) {
         return NULL;
     }
@@ -356,7 +566,7 @@ static Symmetry *get_operations(Cell const *primitive, double const symprec,
 }
 
 /* Return NULL if failed */
-static Symmetry *reduce_operation(Cell const *primitive,
+static Symmetry *reduce_operation(SearchContext *context,
                                   Symmetry const *symmetry,
                                   double const symprec,
                                   double const angle_symprec,
@@ -377,8 +587,7 @@ static Symmetry *reduce_operation(Cell const *primitive,
         point_symmetry.size = 1;
         mat_copy_matrix_i3(point_symmetry.rot[0], identity);
     } else {
-        point_symmetry =
-            get_lattice_symmetry(primitive, symprec, angle_symprec);
+        point_symmetry = get_lattice_symmetry(context, symprec, angle_symprec);
         if (point_symmetry.size == 0) {
             return NULL;
         }
@@ -400,7 +609,7 @@ static Symmetry *reduce_operation(Cell const *primitive,
             if (mat_check_identity_matrix_i3(point_symmetry.rot[i],
                                              symmetry->rot[j])) {
                 if (is_overlap_all_atoms(symmetry->trans[j], symmetry->rot[j],
-                                         primitive, symprec, 0)) {
+                                         context, symprec, 0) == 1) {
                     mat_copy_matrix_i3(rot->mat[num_sym], symmetry->rot[j]);
                     mat_copy_vector_d3(trans->vec[num_sym], symmetry->trans[j]);
                     num_sym++;
@@ -427,20 +636,22 @@ static Symmetry *reduce_operation(Cell const *primitive,
 /* Look for the translations which satisfy the input symmetry operation. */
 /* This function is heaviest in this code. */
 /* Return NULL if failed */
-static VecDBL *get_translation(int const rot[3][3], Cell const *cell,
+static VecDBL *get_translation(int const rot[3][3], SearchContext *context,
                                double const symprec, int const is_identity) {
     int i, j, k, min_atom_index, num_trans;
     int *is_found;
     double origin[3];
+    Cell const *cell;
     VecDBL *trans;
 
     debug_print("get_translation (tolerance = %f):\n", symprec);
 
+    cell = context->cell;
     num_trans = 0;
     is_found = NULL;
     trans = NULL;
 
-    if ((is_found = (int *)malloc(sizeof(int) * cell->size)) == NULL) {
+    if ((is_found = (int *)arn_malloc(sizeof(int) * cell->size)) == NULL) {
         warning_memory("is_found");
         return NULL;
     }
@@ -460,9 +671,16 @@ static VecDBL *get_translation(int const rot[3][3], Cell const *cell,
      */
     mat_multiply_matrix_vector_id3(origin, rot, cell->position[min_atom_index]);
 
-    num_trans = search_translation_part(is_found, cell, rot, min_atom_index,
-                                        origin, symprec, is_identity);
-    if (num_trans == -1 || num_trans == 0) {
+    num_trans = search_translation_part(
+        is_found, context, rot, min_atom_index, origin, symprec, is_identity,
+        is_identity ? get_pure_translation_candidates(context, symprec) : NULL);
+    if (num_trans == -1) {
+        goto ret;
+    }
+    if (is_identity) {
+        set_pure_translation_atoms(context, is_found, symprec);
+    }
+    if (num_trans == 0) {
         goto ret;
     }
 
@@ -482,25 +700,28 @@ static VecDBL *get_translation(int const rot[3][3], Cell const *cell,
     }
 
 ret:
-    free(is_found);
+    arn_free(is_found);
     is_found = NULL;
 
     return trans;
 }
 
 /* Returns -1 on failure. */
-static int search_translation_part(int atoms_found[], Cell const *cell,
+static int search_translation_part(int atoms_found[], SearchContext *context,
                                    int const rot[3][3],
                                    int const min_atom_index,
                                    double const origin[3], double const symprec,
-                                   int const is_identity) {
+                                   int const is_identity,
+                                   int const candidates[]) {
     int i, j, num_trans, is_overlap;
     double trans[3];
+    Cell const *cell;
     OverlapChecker *checker;
 
+    cell = context->cell;
     checker = NULL;
 
-    if ((checker = ovl_overlap_checker_init(cell)) == NULL) {
+    if ((checker = get_overlap_checker(context)) == NULL) {
         return -1;
     }
 
@@ -515,6 +736,10 @@ static int search_translation_part(int atoms_found[], Cell const *cell,
             continue;
         }
 
+        if (candidates != NULL && !candidates[i]) {
+            continue;
+        }
+
         for (j = 0; j < 3; j++) {
             trans[j] = cell->position[i][j] - origin[j];
         }
@@ -522,37 +747,35 @@ static int search_translation_part(int atoms_found[], Cell const *cell,
         is_overlap =
             ovl_check_total_overlap(checker, trans, rot, symprec, is_identity);
         if (is_overlap == -1) {
-            goto err;
+            return -1;
         } else if (is_overlap) {
             atoms_found[i] = 1;
             num_trans++;
             if (is_identity) {
-                num_trans +=
-                    search_pure_translations(atoms_found, cell, trans, symprec);
+                num_trans += search_pure_translations(
+                    atoms_found, cell, checker, trans, symprec, 0);
             }
         }
     }
 
-    ovl_overlap_checker_free(checker);
-    checker = NULL;
     return num_trans;
-
-err:
-    ovl_overlap_checker_free(checker);
-    checker = NULL;
-    return -1;
 }
 
+/* Marks the atoms reached from the atoms found so far by repeating the */
+/* pure translation 'trans'. Each translated position is looked up in the */
+/* cell list of the OverlapChecker instead of being compared with all */
+/* atoms, so the cost is proportional to the number of marked atoms. */
 static int search_pure_translations(int atoms_found[], Cell const *cell,
-                                    double const trans[3],
-                                    double const symprec) {
-    int i, j, num_trans, i_atom, initial_atom;
+                                    OverlapChecker const *checker,
+                                    double const trans[3], double const symprec,
+                                    int const is_layer) {
+    int i, j, num_trans, i_atom, j_atom, initial_atom;
     int *copy_atoms_found;
     double vec[3];
 
     num_trans = 0;
 
-    copy_atoms_found = (int *)malloc(sizeof(int) * cell->size);
+    copy_atoms_found = (int *)arn_malloc(sizeof(int) * cell->size);
     for (i = 0; i < cell->size; i++) {
         copy_atoms_found[i] = atoms_found[i];
     }
@@ -569,19 +792,16 @@ static int search_pure_translations(int atoms_found[], Cell const *cell,
                 vec[j] = cell->position[i_atom][j] + trans[j];
             }
 
-            for (j = 0; j < cell->size; j++) {
-                if (cel_is_overlap_with_same_type(
-                        vec, cell->position[j], cell->types[i_atom],
-                        cell->types[j], cell->lattice, symprec)) {
-                    if (!atoms_found[j]) {
-                        atoms_found[j] = 1;
-                        num_trans++;
-                    }
-                    i_atom = j;
-
-                    break;
-                }
+            j_atom = ovl_find_overlap(checker, vec, cell->types[i_atom],
+                                      symprec, is_layer);
+            if (j_atom == -1) {
+                break;
+            }
+            if (!atoms_found[j_atom]) {
+                atoms_found[j_atom] = 1;
+                num_trans++;
             }
+            i_atom = j_atom;
 
             if (i_atom == initial_atom) {
                 break;
@@ -589,38 +809,90 @@ static int search_pure_translations(int atoms_found[], Cell const *cell,
         }
     }
 
-    free(copy_atoms_found);
+    arn_free(copy_atoms_found);
 
     return num_trans;
 }
 
+/* A pure translation found with a tolerance is also found with larger */
+/* ones, because the overlap check accepts an operation iff all atoms can */
+/* be matched within the tolerance. So when the tolerance is reduced, */
+/* only the atoms reached by the pure translations found last need to be */
+/* tried again. NULL is returned if all atoms have to be tried. */
+static int *get_pure_translation_candidates(SearchContext *context,
+                                            double const symprec) {
+    if (context->pure_trans_atoms == NULL ||
+        symprec > context->pure_trans_symprec) {
+        return NULL;
+    }
+    context->num_pure_trans_reuses++;
+    return context->pure_trans_atoms;
+}
+
+/* The atoms are simply not kept if memory allocation fails. */
+static void set_pure_translation_atoms(SearchContext *context,
+                                       int const atoms_found[],
+                                       double const symprec) {
+    int i;
+
+    if (context->pure_trans_atoms == NULL) {
+        if ((context->pure_trans_atoms = (int *)arn_malloc(
+                 sizeof(int) * context->cell->size)) == NULL) {
+            warning_memory("pure_trans_atoms");
+            return;
+        }
+    }
+    for (i = 0; i < context->cell->size; i++) {
+        context->pure_trans_atoms[i] = atoms_found[i];
+    }
+    context->pure_trans_symprec = symprec;
+}
+
 /* Thoroughly confirms that a given symmetry operation is a symmetry. */
 /* This is a convenient wrapper around ovl_check_total_overlap. */
 /* -1: Error.  0: Not a symmetry.  1: Is a symmetry. */
 static int is_overlap_all_atoms(double const trans[3], int const rot[3][3],
-                                Cell const *cell, double const symprec,
+                                SearchContext *context, double const symprec,
                                 int const is_identity) {
     OverlapChecker *checker;
-    int result;
 
     checker = NULL;
 
-    if ((checker = ovl_overlap_checker_init(cell)) == NULL) {
+    if ((checker = get_overlap_checker(context)) == NULL) {
         return -1;
     }
 
-    if (cell->aperiodic_axis == -1) {
-        result =
-            ovl_check_total_overlap(checker, trans, rot, symprec, is_identity);
+    if (context->cell->aperiodic_axis == -1) {
+        return ovl_check_total_overlap(checker, trans, rot, symprec,
+                                       is_identity);
     } else {
-        result = ovl_check_layer_total_overlap(checker, trans, rot, symprec,
-                                               is_identity);
+        return ovl_check_layer_total_overlap(checker, trans, rot, symprec,
+                                             is_identity);
     }
+}
 
-    ovl_overlap_checker_free(checker);
-    checker = NULL;
+static void init_search_context(SearchContext *context, Cell const *cell) {
+    context->cell = cell;
+    context->checker = NULL;
+    context->num_thread_contexts = 0;
+    context->thread_contexts = NULL;
+    context->lattice_sym.size = 0;
+    context->pure_trans_atoms = NULL;
+    context->pure_trans_symprec = 0;
+    context->num_lattice_sym_reuses = 0;
+    context->num_pure_trans_reuses = 0;
+    context->num_failed_searches = 0;
+    context->max_failed_searches = 0;
+    context->failed_searches = NULL;
+}
 
-    return result;
+/* The OverlapChecker of the cell is built once and kept in the context. */
+/* Return NULL if failed */
+static OverlapChecker *get_overlap_checker(SearchContext *context) {
+    if (context->checker == NULL) {
+        context->checker = ovl_overlap_checker_init(context->cell);
+    }
+    return context->checker;
 }
 
 static int get_index_with_least_atoms(Cell const *cell) {
@@ -629,7 +901,7 @@ static int get_index_with_least_atoms(Cell const *cell) {
 
     mapping = NULL;
 
-    if ((mapping = (int *)malloc(sizeof(int) * cell->size)) == NULL) {
+    if ((mapping = (int *)arn_malloc(sizeof(int) * cell->size)) == NULL) {
         warning_memory("mapping");
         return -1;
     }
@@ -656,7 +928,7 @@ static int get_index_with_least_atoms(Cell const *cell) {
         }
     }
 
-    free(mapping);
+    arn_free(mapping);
     mapping = NULL;
 
     return min_index;
@@ -665,21 +937,24 @@ static int get_index_with_least_atoms(Cell const *cell) {
 /* Look for the translations which satisfy the input symmetry operation. */
 /* This function is heaviest in this code. */
 /* Return NULL if failed */
-static VecDBL *get_layer_translation(int const rot[3][3], Cell const *cell,
+static VecDBL *get_layer_translation(int const rot[3][3],
+                                     SearchContext *context,
                                      double const symprec,
                                      int const is_identity) {
     int i, j, k, min_atom_index, num_trans;
     int *is_found;
     double origin[3];
+    Cell const *cell;
     VecDBL *trans;
 
     debug_print("get_translation (tolerance = %f):\n", symprec);
 
+    cell = context->cell;
     num_trans = 0;
     is_found = NULL;
     trans = NULL;
 
-    if ((is_found = (int *)malloc(sizeof(int) * cell->size)) == NULL) {
+    if ((is_found = (int *)arn_malloc(sizeof(int) * cell->size)) == NULL) {
         warning_memory("is_found");
         return NULL;
     }
@@ -700,8 +975,15 @@ static VecDBL *get_layer_translation(int const rot[3][3], Cell const *cell,
     mat_multiply_matrix_vector_id3(origin, rot, cell->position[min_atom_index]);
 
     num_trans = search_layer_translation_part(
-        is_found, cell, rot, min_atom_index, origin, symprec, is_identity);
-    if (num_trans == -1 || num_trans == 0) {
+        is_found, context, rot, min_atom_index, origin, symprec, is_identity,
+        is_identity ? get_pure_translation_candidates(context, symprec) : NULL);
+    if (num_trans == -1) {
+        goto ret;
+    }
+    if (is_identity) {
+        set_pure_translation_atoms(context, is_found, symprec);
+    }
+    if (num_trans == 0) {
         goto ret;
     }
 
@@ -723,26 +1005,30 @@ static VecDBL *get_layer_translation(int const rot[3][3], Cell const *cell,
     }
 
 ret:
-    free(is_found);
+    arn_free(is_found);
     is_found = NULL;
 
     return trans;
 }
 
 /* Returns -1 on failure. */
-static int search_layer_translation_part(int atoms_found[], Cell const *cell,
+static int search_layer_translation_part(int atoms_found[],
+                                         SearchContext *context,
                                          int const rot[3][3],
                                          int const min_atom_index,
                                          double const origin[3],
                                          double const symprec,
-                                         int const is_identity) {
+                                         int const is_identity,
+                                         int const candidates[]) {
     int i, j, num_trans, is_overlap;
     double trans[3];
+    Cell const *cell;
     OverlapChecker *checker;
 
+    cell = context->cell;
     checker = NULL;
 
-    if ((checker = ovl_overlap_checker_init(cell)) == NULL) {
+    if ((checker = get_overlap_checker(context)) == NULL) {
         return -1;
     }
 
@@ -757,6 +1043,10 @@ static int search_layer_translation_part(int atoms_found[], Cell const *cell,
             continue;
         }
 
+        if (candidates != NULL && !candidates[i]) {
+            continue;
+        }
+
         for (j = 0; j < 3; j++) {
             trans[j] = cell->position[i][j] - origin[j];
         }
@@ -764,83 +1054,23 @@ static int search_layer_translation_part(int atoms_found[], Cell const *cell,
         is_overlap = ovl_check_layer_total_overlap(checker, trans, rot, symprec,
                                                    is_identity);
         if (is_overlap == -1) {
-            goto err;
+            return -1;
         } else if (is_overlap) {
             atoms_found[i] = 1;
             num_trans++;
             if (is_identity) {
-                num_trans += search_layer_pure_translations(
-                    atoms_found, cell, trans, checker->periodic_axes, symprec);
+                num_trans += search_pure_translations(
+                    atoms_found, cell, checker, trans, symprec, 1);
             }
         }
     }
 
-    ovl_overlap_checker_free(checker);
-    checker = NULL;
-    return num_trans;
-
-err:
-    ovl_overlap_checker_free(checker);
-    checker = NULL;
-    return -1;
-}
-
-static int search_layer_pure_translations(int atoms_found[], Cell const *cell,
-                                          double const trans[3],
-                                          int const periodic_axes[2],
-                                          double const symprec) {
-    int i, j, num_trans, i_atom, initial_atom;
-    int *copy_atoms_found;
-    double vec[3];
-
-    num_trans = 0;
-
-    copy_atoms_found = (int *)malloc(sizeof(int) * cell->size);
-    for (i = 0; i < cell->size; i++) {
-        copy_atoms_found[i] = atoms_found[i];
-    }
-
-    for (initial_atom = 0; initial_atom < cell->size; initial_atom++) {
-        if (!copy_atoms_found[initial_atom]) {
-            continue;
-        }
-
-        i_atom = initial_atom;
-
-        for (i = 0; i < cell->size; i++) {
-            for (j = 0; j < 3; j++) {
-                vec[j] = cell->position[i_atom][j] + trans[j];
-            }
-
-            for (j = 0; j < cell->size; j++) {
-                if (cel_layer_is_overlap_with_same_type(
-                        vec, cell->position[j], cell->types[i_atom],
-                        cell->types[j], cell->lattice, periodic_axes,
-                        symprec)) {
-                    if (!atoms_found[j]) {
-                        atoms_found[j] = 1;
-                        num_trans++;
-                    }
-                    i_atom = j;
-
-                    break;
-                }
-            }
-
-            if (i_atom == initial_atom) {
-                break;
-            }
-        }
-    }
-
-    free(copy_atoms_found);
-
     return num_trans;
 }
 
 /* Return NULL if failed */
 static Symmetry *get_space_group_operations(PointSymmetry const *lattice_sym,
-                                            Cell const *primitive,
+                                            SearchContext *context,
                                             double const symprec) {
     int i, j, num_sym, total_num_sym;
     VecDBL **trans;
@@ -851,7 +1081,7 @@ static Symmetry *get_space_group_operations(PointSymmetry const *lattice_sym,
     trans = NULL;
     symmetry = NULL;
 
-    if ((trans = (VecDBL **)malloc(sizeof(VecDBL *) * lattice_sym->size)) ==
+    if ((trans = (VecDBL **)arn_malloc(sizeof(VecDBL *) * lattice_sym->size)) ==
         NULL) {
         warning_memory("trans");
         return NULL;
@@ -861,27 +1091,15 @@ static Symmetry *get_space_group_operations(PointSymmetry const *lattice_sym,
         trans[i] = NULL;
     }
 
-    total_num_sym = 0;
-
-    if (primitive->aperiodic_axis == -1) {
-        for (i = 0; i < lattice_sym->size; i++) {
-            if ((trans[i] = get_translation(lattice_sym->rot[i], primitive,
-                                            symprec, 0)) != NULL) {
-                debug_print("  match translation %d/%d; tolerance = %f\n",
-                            i + 1, lattice_sym->size, symprec);
+    search_operation_translations(trans, lattice_sym, context, symprec);
 
-                total_num_sym += trans[i]->size;
-            }
-        }
-    } else {
-        for (i = 0; i < lattice_sym->size; i++) {
-            if ((trans[i] = get_layer_translation(
-                     lattice_sym->rot[i], primitive, symprec, 0)) != NULL) {
-                debug_print("  match translation %d/%d; tolerance = %f\n",
-                            i + 1, lattice_sym->size, symprec);
+    total_num_sym = 0;
+    for (i = 0; i < lattice_sym->size; i++) {
+        if (trans[i] != NULL) {
+            debug_print("  match translation %d/%d; tolerance = %f\n", i + 1,
+                        lattice_sym->size, symprec);
 
-                total_num_sym += trans[i]->size;
-            }
+            total_num_sym += trans[i]->size;
         }
     }
 
@@ -908,27 +1126,149 @@ ret:
             trans[i] = NULL;
         }
     }
-    free(trans);
+    arn_free(trans);
     trans = NULL;
 
     return symmetry;
 }
 
+/* trans[i] is set to the translations found for lattice_sym->rot[i] or */
+/* NULL. Large cells are searched in parallel over the rotations when */
+/* OpenMP is enabled. Each thread uses its own OverlapChecker and writes */
+/* only trans[i], so the result is identical to the serial search. */
+static void search_operation_translations(VecDBL *trans[],
+                                          PointSymmetry const *lattice_sym,
+                                          SearchContext *context,
+                                          double const symprec) {
+    int i;
+#ifdef _OPENMP
+    int num_threads;
+    SearchContext *thread_context;
+    WorkBudget *budget;
+
+    /* Cells of spg_get_datasets are already processed in parallel. */
+    num_threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+    if (context->cell->size >= NUM_ATOMS_CRITERION_FOR_OPENMP &&
+        lattice_sym->size > 1 && num_threads > 1 &&
+        set_thread_contexts(context, num_threads)) {
+        budget = bdg_get_budget();
+#pragma omp parallel private(thread_context) num_threads(num_threads)
+        {
+            bdg_begin_shared(budget);
+            thread_context = &context->thread_contexts[omp_get_thread_num()];
+#pragma omp for schedule(dynamic)
+            for (i = 0; i < lattice_sym->size; i++) {
+                trans[i] = get_operation_translation(lattice_sym->rot[i],
+                                                     thread_context, symprec);
+            }
+            bdg_end();
+        }
+        return;
+    }
+#endif
+
+    for (i = 0; i < lattice_sym->size; i++) {
+        trans[i] =
+            get_operation_translation(lattice_sym->rot[i], context, symprec);
+    }
+}
+
+/* Return NULL if failed */
+static VecDBL *get_operation_translation(int const rot[3][3],
+                                         SearchContext *context,
+                                         double const symprec) {
+    if (context->cell->aperiodic_axis == -1) {
+        return get_translation(rot, context, symprec, 0);
+    } else {
+        return get_layer_translation(rot, context, symprec, 0);
+    }
+}
+
+/* Return 0 if failed */
+static int verify_operation(int *is_symmetry, int permutation[],
+                            double *max_displacement, SearchContext *context,
+                            int const rot[3][3], double const trans[3],
+                            double const symprec) {
+    int i, is_overlap;
+    OverlapChecker *checker;
+
+    if ((checker = get_overlap_checker(context)) == NULL) {
+        is_overlap = -1;
+    } else {
+        is_overlap = ovl_get_overlap_mapping(
+            permutation, max_displacement, checker, trans, rot, symprec,
+            mat_check_identity_matrix_i3(rot, identity),
+            context->cell->aperiodic_axis != -1);
+    }
+
+    *is_symmetry = (is_overlap == 1);
+    /* The mapping may be partially set by a failed check. */
+    if (is_overlap != 1) {
+        if (permutation != NULL) {
+            for (i = 0; i < context->cell->size; i++) {
+                permutation[i] = -1;
+            }
+        }
+        if (max_displacement != NULL) {
+            *max_displacement = -1;
+        }
+    }
+
+    return is_overlap != -1;
+}
+
+#ifdef _OPENMP
+/* The thread contexts share the cell and keep their checkers between */
+/* calls. They are reallocated only when more threads are requested. */
+/* Return 0 if failed */
+static int set_thread_contexts(SearchContext *context, int const num_threads) {
+    int i;
+    SearchContext *thread_contexts;
+
+    if (context->num_thread_contexts >= num_threads) {
+        return 1;
+    }
+
+    if ((thread_contexts = (SearchContext *)arn_malloc(sizeof(SearchContext) *
+                                                   num_threads)) == NULL) {
+        warning_memory("thread_contexts");
+        return 0;
+    }
+
+    for (i = 0; i < num_threads; i++) {
+        if (i < context->num_thread_contexts) {
+            thread_contexts[i] = context->thread_contexts[i];
+        } else {
+            init_search_context(&thread_contexts[i], context->cell);
+        }
+    }
+    arn_free(context->thread_contexts);
+    context->thread_contexts = thread_contexts;
+    context->num_thread_contexts = num_threads;
+
+    return 1;
+}
+#endif
+
+/* The lattice symmetry found last is kept in the context. When the */
+/* tolerances are reduced, only its operations are tested again. */
 /* lattice_sym.size = 0 is returned if failed. */
-static PointSymmetry get_lattice_symmetry(Cell const *cell,
+static PointSymmetry get_lattice_symmetry(SearchContext *context,
                                           double const symprec,
                                           double const angle_symprec) {
-    int i, j, k, attempt, num_sym, aperiodic_axis;
+    int i, attempt, num_sym, aperiodic_axis, num_candidates;
     double angle_tol;
-    int axes[3][3];
+    int axes[3][3], indices[3], is_length_kept[3][26];
     double lattice[3][3], min_lattice[3][3];
     double metric[3][3], metric_orig[3][3];
+    Cell const *cell;
     PointSymmetry lattice_sym;
 
     debug_print("get_lattice_symmetry:\n");
 
     lattice_sym.size = 0;
 
+    cell = context->cell;
     aperiodic_axis = cell->aperiodic_axis;
 
     if (aperiodic_axis == -1) {
@@ -945,79 +1285,96 @@ static PointSymmetry get_lattice_symmetry(Cell const *cell,
     mat_get_metric(metric_orig, min_lattice);
     angle_tol = angle_symprec;
 
+    if (is_lattice_symmetry_reusable(context, min_lattice, symprec,
+                                     angle_symprec)) {
+        context->num_lattice_sym_reuses++;
+        num_sym = 0;
+        for (i = 0; i < context->lattice_sym.size; i++) {
+            mat_multiply_matrix_di3(lattice, min_lattice,
+                                    context->lattice_sym.rot[i]);
+            mat_get_metric(metric, lattice);
+            if (is_identity_metric(metric, metric_orig, symprec, angle_tol)) {
+                mat_copy_matrix_i3(lattice_sym.rot[num_sym],
+                                   context->lattice_sym.rot[i]);
+                num_sym++;
+            }
+        }
+        lattice_sym.size = num_sym;
+        goto found;
+    }
+
+    /* Candidates changing the length of a lattice vector are rejected */
+    /* before the metric tensor is computed. */
+    set_axis_lengths_kept(is_length_kept, min_lattice, metric_orig, symprec);
+    num_candidates = axdb_get_num_unimodular_axes();
+
     for (attempt = 0; attempt < NUM_ATTEMPT; attempt++) {
+        if (bdg_is_exceeded()) {
+            goto err;
+        }
         num_sym = 0;
-        for (i = 0; i < 26; i++) {
-            for (j = 0; j < 26; j++) {
-                for (k = 0; k < 26; k++) {
-                    set_axes(axes, i, j, k);
-                    /* For layer groups, the off-diagonal elements for the
-                     * aperiodic axis are set to be zero.
-                     * Please note that for inclined aperiodic axis, some
-                     * operations will not be found */
-                    switch (aperiodic_axis) {
-                        case 2:
-                            /*    {{W_11, W_12,      0}, *
-                             * W = {W_21, W_22,      0}, *
-                             *     {   0,    0, (+/-)1}} */
-                            if (axes[0][2] || axes[1][2] || axes[2][0] ||
-                                axes[2][1])
-                                continue;
-                            break;
-                        case 0:
-                            /*    {{(+/-)1,    0,    0}, *
-                             * W = {     0, W_22, W_23}, *
-                             *     {     0, W_32, W_33}} */
-                            if (axes[0][1] || axes[0][2] || axes[1][0] ||
-                                axes[2][0])
-                                continue;
-                            break;
-                        case 1:
-                            /*    {{W_11,      0, W_13}, *
-                             * W = {   0, (+/-)1,    0}, *
-                             *     {W_31,      0, W_33}} */
-                            if (axes[0][1] || axes[1][0] || axes[1][2] ||
-                                axes[2][1])
-                                continue;
-                            break;
-                        default:
-                            break;
-                    }
-                    if (!((mat_get_determinant_i3(axes) == 1) ||
-                          (mat_get_determinant_i3(axes) == -1))) {
+        for (i = 0; i < num_candidates; i++) {
+            axdb_get_unimodular_axes(indices, i);
+            if (!(is_length_kept[0][indices[0]] &&
+                  is_length_kept[1][indices[1]] &&
+                  is_length_kept[2][indices[2]])) {
+                continue;
+            }
+            set_axes(axes, indices[0], indices[1], indices[2]);
+            /* For layer groups, the off-diagonal elements for the
+             * aperiodic axis are set to be zero.
+             * Please note that for inclined aperiodic axis, some
+             * operations will not be found */
+            switch (aperiodic_axis) {
+                case 2:
+                    /*    {{W_11, W_12,      0}, *
+                     * W = {W_21, W_22,      0}, *
+                     *     {   0,    0, (+/-)1}} */
+                    if (axes[0][2] || axes[1][2] || axes[2][0] || axes[2][1])
                         continue;
-                    }
-                    mat_multiply_matrix_di3(lattice, min_lattice, axes);
-                    mat_get_metric(metric, lattice);
-
-                    if (is_identity_metric(metric, metric_orig, symprec,
-                                           angle_tol)) {
-                        if ((aperiodic_axis == -1 && num_sym >= 48) ||
-                            (aperiodic_axis != -1 && num_sym >= 24)) {
-                            debug_print(
-                                "spglib: Too many lattice symmetries were "
-                                "found.\n");
-                            if (angle_tol > 0) {
-                                angle_tol *= ANGLE_REDUCE_RATE;
-                                debug_print(
-                                    "        Reducing angle tolerance to %f\n",
+                    break;
+                case 0:
+                    /*    {{(+/-)1,    0,    0}, *
+                     * W = {     0, W_22, W_23}, *
+                     *     {     0, W_32, W_33}} */
+                    if (axes[0][1] || axes[0][2] || axes[1][0] || axes[2][0])
+                        continue;
+                    break;
+                case 1:
+                    /*    {{W_11,      0, W_13}, *
+                     * W = {   0, (+/-)1,    0}, *
+                     *     {W_31,      0, W_33}} */
+                    if (axes[0][1] || axes[1][0] || axes[1][2] || axes[2][1])
+                        continue;
+                    break;
+                default:
+                    break;
+            }
+            mat_multiply_matrix_di3(lattice, min_lattice, axes);
+            mat_get_metric(metric, lattice);
+
+            if (is_identity_metric(metric, metric_orig, symprec, angle_tol)) {
+                if ((aperiodic_axis == -1 && num_sym >= 48) ||
+                    (aperiodic_axis != -1 && num_sym >= 24)) {
+                    debug_print(
+                        "spglib: Too many lattice symmetries were found.\n");
+                    if (angle_tol > 0) {
+                        angle_tol *= ANGLE_REDUCE_RATE;
+                        debug_print("        Reducing angle tolerance to %f\n",
                                     angle_tol);
-                            }
-                            goto next_attempt;
-                        }
-
-                        mat_copy_matrix_i3(lattice_sym.rot[num_sym], axes);
-                        num_sym++;
                     }
+                    goto next_attempt;
                 }
+
+                mat_copy_matrix_i3(lattice_sym.rot[num_sym], axes);
+                num_sym++;
             }
         }
 
         if ((aperiodic_axis == -1 && num_sym <= 48) ||
             (aperiodic_axis != -1 && num_sym <= 24) || angle_tol < 0) {
             lattice_sym.size = num_sym;
-            return transform_pointsymmetry(&lattice_sym, cell->lattice,
-                                           min_lattice);
+            goto found;
         }
 
     next_attempt:;
@@ -1026,6 +1383,49 @@ static PointSymmetry get_lattice_symmetry(Cell const *cell,
 err:
     debug_print("get_lattice_symmetry failed.\n");
     return lattice_sym;
+
+found:
+    context->lattice_sym = lattice_sym;
+    mat_copy_matrix_d3(context->min_lattice, min_lattice);
+    context->lattice_sym_symprec = symprec;
+    context->lattice_sym_angle_tolerance = angle_tol;
+    return transform_pointsymmetry(&lattice_sym, cell->lattice, min_lattice);
+}
+
+/* The operations passing is_identity_metric with smaller tolerances are */
+/* a subset of those passing with larger ones. So the lattice symmetry in */
+/* the context can be filtered if the Delaunay reduced lattice is */
+/* unchanged. It has at most 48 operations, therefore the angle tolerance */
+/* would not be reduced by get_lattice_symmetry. */
+static int is_lattice_symmetry_reusable(SearchContext const *context,
+                                        double const min_lattice[3][3],
+                                        double const symprec,
+                                        double const angle_symprec) {
+    int i, j;
+
+    if (context->lattice_sym.size == 0 ||
+        symprec > context->lattice_sym_symprec) {
+        return 0;
+    }
+
+    if (angle_symprec > 0) {
+        if (context->lattice_sym_angle_tolerance <= 0 ||
+            angle_symprec > context->lattice_sym_angle_tolerance) {
+            return 0;
+        }
+    } else if (context->lattice_sym_angle_tolerance > 0) {
+        return 0;
+    }
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            if (context->min_lattice[i][j] != min_lattice[i][j]) {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
 }
 
 static int is_identity_metric(double const metric_rotated[3][3],
@@ -1132,16 +1532,45 @@ err:
 }
 
 // @brief Set an integer matrix to `axes`. Three integer vectors are specified
-//        by indices of array `symmetry.c:relative_axes`.
+//        by indices of array `axes_database.c:relative_axes`.
 static void set_axes(int axes[3][3], int const a1, int const a2, int const a3) {
     int i;
+    int axis[3];
+
+    axdb_get_relative_axis(axis, a1);
     for (i = 0; i < 3; i++) {
-        axes[i][0] = relative_axes[a1][i];
+        axes[i][0] = axis[i];
     }
+    axdb_get_relative_axis(axis, a2);
     for (i = 0; i < 3; i++) {
-        axes[i][1] = relative_axes[a2][i];
+        axes[i][1] = axis[i];
     }
+    axdb_get_relative_axis(axis, a3);
     for (i = 0; i < 3; i++) {
-        axes[i][2] = relative_axes[a3][i];
+        axes[i][2] = axis[i];
+    }
+}
+
+/* is_length_kept[i][j] = 1 if the j-th relative axis of min_lattice has */
+/* the length of the i-th lattice vector. The lengths are computed in the */
+/* same way as in is_identity_metric, so no candidate is lost. */
+static void set_axis_lengths_kept(int is_length_kept[3][26],
+                                  double const min_lattice[3][3],
+                                  double const metric_orig[3][3],
+                                  double const symprec) {
+    int i, j;
+    double length;
+    int axes[3][3];
+    double lattice[3][3], metric[3][3];
+
+    for (j = 0; j < 26; j++) {
+        set_axes(axes, j, j, j);
+        mat_multiply_matrix_di3(lattice, min_lattice, axes);
+        mat_get_metric(metric, lattice);
+        length = sqrt(metric[0][0]);
+        for (i = 0; i < 3; i++) {
+            is_length_kept[i][j] =
+                !(mat_Dabs(sqrt(metric_orig[i][i]) - length) > symprec);
+        }
     }
 }
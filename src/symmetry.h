@@ -37,6 +37,7 @@
 
 #include "cell.h"
 #include "mathfunc.h"
+#include "overlap.h"
 
 typedef struct {
     int size;
@@ -56,19 +57,80 @@ typedef struct {
     int size;
 } PointSymmetry;
 
+/* Steps of the symmetry search whose failures are remembered. */
+typedef enum {
+    SEARCH_STEP_PRIMITIVE,
+    SEARCH_STEP_SPACEGROUP,
+} SearchStep;
+
+typedef struct {
+    SearchStep step;
+    double symprec;
+    double angle_tolerance;
+} FailedSearch;
+
+/* State of the symmetry searches of one cell that does not depend on the */
+/* tolerance, or that can be reused when the callers retry with reduced */
+/* tolerances. The OverlapChecker does not depend on the tolerance and is */
+/* created at its first use. thread_contexts hold the checkers of the */
+/* threads that search translations in parallel. */
+typedef struct SearchContext {
+    Cell const *cell;
+    OverlapChecker *checker;
+    int num_thread_contexts;
+    struct SearchContext *thread_contexts;
+
+    /* Lattice symmetry found last in the basis of the Delaunay reduced */
+    /* lattice min_lattice. lattice_sym.size = 0 if not yet found. */
+    PointSymmetry lattice_sym;
+    double min_lattice[3][3];
+    double lattice_sym_symprec;
+    double lattice_sym_angle_tolerance;
+
+    /* Atoms reached by the pure translations found last and its */
+    /* tolerance. NULL if not yet searched. */
+    int *pure_trans_atoms;
+    double pure_trans_symprec;
+
+    /* Numbers of the searches that reused the above. */
+    int num_lattice_sym_reuses;
+    int num_pure_trans_reuses;
+
+    /* Steps that failed and their tolerances. */
+    int num_failed_searches;
+    int max_failed_searches;
+    FailedSearch *failed_searches;
+} SearchContext;
+
 Symmetry *sym_alloc_symmetry(int const size);
 SPG_API_TEST void sym_free_symmetry(Symmetry *symmetry);
 MagneticSymmetry *sym_alloc_magnetic_symmetry(int const size);
 void sym_free_magnetic_symmetry(MagneticSymmetry *symmetry);
-SPG_API_TEST Symmetry *sym_get_operation(Cell const *primitive,
+SPG_API_TEST SearchContext *sym_alloc_search_context(Cell const *cell);
+SPG_API_TEST void sym_free_search_context(SearchContext *context);
+SPG_API_TEST Symmetry *sym_get_operation(SearchContext *context,
                                          double const symprec,
                                          double const angle_tolerance);
-Symmetry *sym_reduce_operation(Cell const *primitive, Symmetry const *symmetry,
-                               double const symprec,
+Symmetry *sym_reduce_operation(SearchContext *context,
+                               Symmetry const *symmetry, double const symprec,
                                double const angle_tolerance);
-VecDBL *sym_get_pure_translation(Cell const *cell, double const symprec);
-VecDBL *sym_reduce_pure_translation(Cell const *cell, VecDBL const *pure_trans,
+int sym_check_operations(SearchContext *context, Symmetry const *symmetry,
+                         double const symprec);
+int sym_verify_operations(int is_symmetry[], int permutations[],
+                          double max_displacements[], SearchContext *context,
+                          int const rot[][3][3], double const trans[][3],
+                          int const num_operations, double const symprec);
+SPG_API_TEST VecDBL *sym_get_pure_translation(SearchContext *context,
+                                              double const symprec);
+VecDBL *sym_reduce_pure_translation(SearchContext *context,
+                                    VecDBL const *pure_trans,
                                     double const symprec,
                                     double const angle_tolerance);
+SPG_API_TEST int sym_has_failed(SearchContext const *context,
+                                SearchStep const step, double const symprec,
+                                double const angle_tolerance);
+SPG_API_TEST void sym_set_failed(SearchContext *context, SearchStep const step,
+                                 double const symprec,
+                                 double const angle_tolerance);
 
 #endif
@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include <gtest/gtest.h>
 
 extern "C" {
@@ -75,6 +77,57 @@ TEST(FindPrimitiveCell, test_spg_find_primitive_corundum) {
     show_cell(lattice, position, types, num_primitive_atom);
 }
 
+TEST(FindPrimitiveCell, test_spg_find_primitive_sublattice_first) {
+    // 8x8x8 supercell of simple cubic structure. The atoms of the 4x4x4
+    // sublattice come first, so the first pure translations found are not
+    // primitive lattice vectors.
+    int const n = 8;
+    int const num_atom = n * n * n;
+    double lattice[3][3] = {{3.0 * n, 0, 0}, {0, 3.0 * n, 0}, {0, 0, 3.0 * n}};
+    int i, j, k, m, is_sublattice, num_primitive_atom;
+    double symprec = 1e-5;
+
+    double(*position)[3];
+    int *types;
+
+    position = (double(*)[3])malloc(sizeof(double[3]) * num_atom);
+    types = (int *)malloc(sizeof(int) * num_atom);
+
+    m = 0;
+    for (is_sublattice = 1; is_sublattice >= 0; is_sublattice--) {
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++) {
+                for (k = 0; k < n; k++) {
+                    if ((i % 2 == 0 && j % 2 == 0 && k % 2 == 0) !=
+                        is_sublattice) {
+                        continue;
+                    }
+                    position[m][0] = (double)i / n;
+                    position[m][1] = (double)j / n;
+                    position[m][2] = (double)k / n;
+                    types[m] = 1;
+                    m++;
+                }
+            }
+        }
+    }
+
+    /* lattice, position, and types are overwritten. */
+    num_primitive_atom =
+        spg_find_primitive(lattice, position, types, num_atom, symprec);
+    ASSERT_EQ(num_primitive_atom, 1);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            EXPECT_NEAR(fabs(lattice[i][j]), i == j ? 3 : 0, symprec);
+        }
+    }
+
+    free(position);
+    position = NULL;
+    free(types);
+    types = NULL;
+}
+
 TEST(FindPrimitiveCell, test_spg_refine_cell_BCC) {
     double lattice[3][3] = {{0, 2, 2}, {2, 0, 2}, {2, 2, 0}};
 
@@ -81,3 +81,1045 @@ TEST(SymmetrySearch, test_spg_get_multiplicity) {
     size = spg_get_multiplicity(lattice, position, types, num_atom, 1e-5);
     ASSERT_EQ(size, 48);
 }
+
+TEST(SymmetrySearch, test_spg_get_dataset_large_supercell) {
+    // 8x8x8 supercell of CsCl-type structure with 1024 atoms, where one atom
+    // is substituted to make the supercell primitive. The cell is large
+    // enough to search translations in parallel when OpenMP is enabled.
+    int const n = 8;
+    int const num_atom = 2 * n * n * n;
+    double lattice[3][3] = {{4.0 * n, 0, 0}, {0, 4.0 * n, 0}, {0, 0, 4.0 * n}};
+    int i, j, k, m;
+
+    double(*position)[3];
+    int *types;
+    SpglibDataset *dataset;
+
+    position = (double(*)[3])malloc(sizeof(double[3]) * num_atom);
+    types = (int *)malloc(sizeof(int) * num_atom);
+
+    m = 0;
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            for (k = 0; k < n; k++) {
+                position[m][0] = (double)i / n;
+                position[m][1] = (double)j / n;
+                position[m][2] = (double)k / n;
+                types[m] = 1;
+                position[m + 1][0] = (i + 0.5) / n;
+                position[m + 1][1] = (j + 0.5) / n;
+                position[m + 1][2] = (k + 0.5) / n;
+                types[m + 1] = 2;
+                m += 2;
+            }
+        }
+    }
+
+    types[0] = 3;
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->spacegroup_number, 221);
+    EXPECT_EQ(dataset->n_operations, 48);
+
+    spg_free_dataset(dataset);
+    dataset = NULL;
+    free(position);
+    position = NULL;
+    free(types);
+    types = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_fcc_conventional_supercell) {
+    // 3x3x3 supercell of the conventional cell of fcc. The supercell is not
+    // a diagonal multiple of the primitive cell, so its 108 lattice points
+    // are collected from a larger frame of the primitive lattice.
+    int const n = 3;
+    int const num_atom = 4 * n * n * n;
+    double lattice[3][3] = {{4.0 * n, 0, 0}, {0, 4.0 * n, 0}, {0, 0, 4.0 * n}};
+    double const basis[4][3] = {
+        {0, 0, 0}, {0, 0.5, 0.5}, {0.5, 0, 0.5}, {0.5, 0.5, 0}};
+    int i, j, k, l, m, num_pure_trans;
+
+    double(*position)[3];
+    int *types;
+    SpglibDataset *dataset;
+
+    position = (double(*)[3])malloc(sizeof(double[3]) * num_atom);
+    types = (int *)malloc(sizeof(int) * num_atom);
+
+    m = 0;
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            for (k = 0; k < n; k++) {
+                for (l = 0; l < 4; l++) {
+                    position[m][0] = (i + basis[l][0]) / n;
+                    position[m][1] = (j + basis[l][1]) / n;
+                    position[m][2] = (k + basis[l][2]) / n;
+                    types[m] = 1;
+                    m++;
+                }
+            }
+        }
+    }
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->spacegroup_number, 225);
+    EXPECT_EQ(dataset->n_operations, 48 * num_atom);
+
+    // One pure translation per lattice point of the supercell.
+    num_pure_trans = 0;
+    for (i = 0; i < dataset->n_operations; i++) {
+        if (dataset->rotations[i][0][0] == 1 &&
+            dataset->rotations[i][1][1] == 1 &&
+            dataset->rotations[i][2][2] == 1) {
+            num_pure_trans++;
+        }
+    }
+    EXPECT_EQ(num_pure_trans, num_atom);
+
+    spg_free_dataset(dataset);
+    dataset = NULL;
+    free(position);
+    position = NULL;
+    free(types);
+    types = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_large_supercell_translations) {
+    // 8x8x8 supercell of CsCl-type structure with 1024 atoms. Pure
+    // translations are looked up in the cell list of the overlap checker and
+    // the overlap of atoms is checked by a sweep for this size of cell.
+    int const n = 8;
+    int const num_atom = 2 * n * n * n;
+    double lattice[3][3] = {{4.0 * n, 0, 0}, {0, 4.0 * n, 0}, {0, 0, 4.0 * n}};
+    int i, j, k, m;
+
+    double(*position)[3];
+    int *types;
+    SpglibDataset *dataset;
+
+    position = (double(*)[3])malloc(sizeof(double[3]) * num_atom);
+    types = (int *)malloc(sizeof(int) * num_atom);
+
+    m = 0;
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < n; j++) {
+            for (k = 0; k < n; k++) {
+                position[m][0] = (double)i / n;
+                position[m][1] = (double)j / n;
+                position[m][2] = (double)k / n;
+                types[m] = 1;
+                position[m + 1][0] = (i + 0.5) / n;
+                position[m + 1][1] = (j + 0.5) / n;
+                position[m + 1][2] = (k + 0.5) / n;
+                types[m + 1] = 2;
+                m += 2;
+            }
+        }
+    }
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->spacegroup_number, 221);
+    EXPECT_EQ(dataset->n_operations, 48 * n * n * n);
+    for (i = 0; i < num_atom; i++) {
+        EXPECT_EQ(dataset->mapping_to_primitive[i], types[i] - 1);
+    }
+    spg_free_dataset(dataset);
+    dataset = NULL;
+
+    // Move an atom close to the atom at the origin across the cell boundary.
+    position[2][0] = 1 - 1e-7;
+    position[2][1] = 0;
+    position[2][2] = 0;
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    EXPECT_EQ(dataset, nullptr);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_ATOMS_TOO_CLOSE);
+
+    free(position);
+    position = NULL;
+    free(types);
+    types = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_get_datasets) {
+    // Rutile, wurtzite, and a cell with overlapping atoms packed in one array
+    double lattices[3][3][3] = {
+        {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}},
+        {{3.111, -1.5555, 0}, {0, 2.6942050311733885, 0}, {0, 0, 4.988}},
+        {{4, 0, 0}, {0, 4, 0}, {0, 0, 4}}};
+    double positions[][3] = {
+        {0, 0, 0},         {0.5, 0.5, 0.5},   {0.3, 0.3, 0},
+        {0.7, 0.7, 0},     {0.2, 0.8, 0.5},   {0.8, 0.2, 0.5},
+        {1.0 / 3, 2.0 / 3, 0}, {2.0 / 3, 1.0 / 3, 0.5},
+        {1.0 / 3, 2.0 / 3, 0.6181}, {2.0 / 3, 1.0 / 3, 0.1181},
+        {0, 0, 0},         {0, 0, 0}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 1, 1};
+    int offsets[] = {0, 6, 10, 12};
+    int const num_cells = 3;
+    int const spacegroup_numbers[] = {136, 186};
+    int i, num_found;
+
+    SpglibDataset *datasets[3];
+    SpglibError error_codes[3];
+    SpglibDataset *dataset;
+
+    num_found = spg_get_datasets(datasets, error_codes, lattices, positions,
+                                 types, offsets, num_cells, 1e-5);
+    ASSERT_EQ(num_found, 2);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_ATOMS_TOO_CLOSE);
+
+    for (i = 0; i < 2; i++) {
+        ASSERT_NE(datasets[i], nullptr);
+        EXPECT_EQ(error_codes[i], SPGLIB_SUCCESS);
+        EXPECT_EQ(datasets[i]->spacegroup_number, spacegroup_numbers[i]);
+
+        // Same as the dataset of the single cell
+        dataset = spg_get_dataset(lattices[i], positions + offsets[i],
+                                  types + offsets[i],
+                                  offsets[i + 1] - offsets[i], 1e-5);
+        ASSERT_NE(dataset, nullptr);
+        EXPECT_EQ(datasets[i]->hall_number, dataset->hall_number);
+        EXPECT_EQ(datasets[i]->n_operations, dataset->n_operations);
+        EXPECT_EQ(datasets[i]->n_atoms, dataset->n_atoms);
+        spg_free_dataset(dataset);
+        dataset = NULL;
+
+        spg_free_dataset(datasets[i]);
+        datasets[i] = NULL;
+    }
+
+    EXPECT_EQ(datasets[2], nullptr);
+    EXPECT_EQ(error_codes[2], SPGERR_ATOMS_TOO_CLOSE);
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_tolerance_scan) {
+    // Rutile with an O atom displaced by 0.02 A
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}};
+    double positions[][3] = {{0, 0, 0},     {0.5, 0.5, 0.5}, {0.305, 0.3, 0},
+                             {0.7, 0.7, 0}, {0.2, 0.8, 0.5}, {0.8, 0.2, 0.5}};
+    int types[] = {1, 1, 2, 2, 2, 2};
+    int const num_atom = 6;
+    double const symprecs[] = {1e-5, 1e-4, 1e-3, 3e-3, 1e-2, 3e-2,
+                               0.1,  0.2,  0.3,  0.5,  2.5};
+    int const num_symprec = 11;
+    int spacegroup_numbers[11], hall_numbers[11], n_operations[11];
+    int i, num_found;
+
+    SpglibDataset *dataset;
+
+    num_found = spg_get_dataset_tolerance_scan(
+        spacegroup_numbers, hall_numbers, n_operations, lattice, positions,
+        types, num_atom, symprecs, num_symprec);
+    ASSERT_EQ(num_found, 10);
+    EXPECT_EQ(spg_get_error_code(), SPGLIB_SUCCESS);
+    EXPECT_EQ(spacegroup_numbers[0], 6);
+    EXPECT_EQ(spacegroup_numbers[9], 136);
+
+    // Same as the datasets searched at each tolerance
+    for (i = 0; i < num_symprec - 1; i++) {
+        dataset = spg_get_dataset(lattice, positions, types, num_atom,
+                                  symprecs[i]);
+        ASSERT_NE(dataset, nullptr);
+        EXPECT_EQ(spacegroup_numbers[i], dataset->spacegroup_number);
+        EXPECT_EQ(hall_numbers[i], dataset->hall_number);
+        EXPECT_EQ(n_operations[i], dataset->n_operations);
+        spg_free_dataset(dataset);
+        dataset = NULL;
+    }
+
+    // The atoms are too close at the largest tolerance
+    EXPECT_EQ(spacegroup_numbers[10], 0);
+    EXPECT_EQ(hall_numbers[10], 0);
+    EXPECT_EQ(n_operations[10], 0);
+
+    // Unsorted tolerances give the same results at each tolerance
+    int const order[11] = {6, 10, 0, 3, 9, 1, 8, 2, 5, 4, 7};
+    double unsorted_symprecs[11];
+    int unsorted_spacegroup_numbers[11], unsorted_hall_numbers[11];
+    int unsorted_n_operations[11];
+    for (i = 0; i < num_symprec; i++) {
+        unsorted_symprecs[i] = symprecs[order[i]];
+    }
+    num_found = spg_get_dataset_tolerance_scan(
+        unsorted_spacegroup_numbers, unsorted_hall_numbers,
+        unsorted_n_operations, lattice, positions, types, num_atom,
+        unsorted_symprecs, num_symprec);
+    ASSERT_EQ(num_found, 10);
+    EXPECT_EQ(spg_get_error_code(), SPGLIB_SUCCESS);
+    for (i = 0; i < num_symprec; i++) {
+        EXPECT_EQ(unsorted_spacegroup_numbers[i],
+                  spacegroup_numbers[order[i]]);
+        EXPECT_EQ(unsorted_hall_numbers[i], hall_numbers[order[i]]);
+        EXPECT_EQ(unsorted_n_operations[i], n_operations[order[i]]);
+    }
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_tolerance_scan_too_close) {
+    // Two atoms 0.04 A apart are too close at the first tolerance of the
+    // unsorted tolerances but not at the second one.
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 4}};
+    double positions[][3] = {{0, 0, 0}, {0.01, 0, 0}};
+    int types[] = {1, 1};
+    int const num_atom = 2;
+    double const symprecs[] = {0.1, 1e-5};
+    int spacegroup_numbers[2], hall_numbers[2], n_operations[2];
+    int num_found;
+
+    SpglibDataset *dataset;
+
+    dataset = spg_get_dataset(lattice, positions, types, num_atom, 0.1);
+    EXPECT_EQ(dataset, nullptr);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_ATOMS_TOO_CLOSE);
+
+    num_found = spg_get_dataset_tolerance_scan(
+        spacegroup_numbers, hall_numbers, n_operations, lattice, positions,
+        types, num_atom, symprecs, 2);
+    ASSERT_EQ(num_found, 1);
+    EXPECT_EQ(spacegroup_numbers[0], 0);
+    EXPECT_EQ(hall_numbers[0], 0);
+    EXPECT_EQ(n_operations[0], 0);
+
+    dataset = spg_get_dataset(lattice, positions, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(spacegroup_numbers[1], dataset->spacegroup_number);
+    EXPECT_EQ(hall_numbers[1], dataset->hall_number);
+    EXPECT_EQ(n_operations[1], dataset->n_operations);
+    spg_free_dataset(dataset);
+
+    // All tolerances are too close
+    num_found = spg_get_dataset_tolerance_scan(
+        spacegroup_numbers, hall_numbers, n_operations, lattice, positions,
+        types, num_atom, symprecs, 1);
+    EXPECT_EQ(num_found, 0);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_ATOMS_TOO_CLOSE);
+}
+
+TEST(SymmetrySearch, test_spg_get_factorized_dataset) {
+    // Rutile doubled along c
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}};
+    double position[][3] = {
+        {0, 0, 0},        {0.5, 0.5, 0.25}, {0.3, 0.3, 0},    {0.7, 0.7, 0},
+        {0.2, 0.8, 0.25}, {0.8, 0.2, 0.25}, {0, 0, 0.5},      {0.5, 0.5, 0.75},
+        {0.3, 0.3, 0.5},  {0.7, 0.7, 0.5},  {0.2, 0.8, 0.75}, {0.8, 0.2, 0.75}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2};
+    int const num_atom = 12;
+    int rotations[32][3][3];
+    double translations[32][3];
+    int i, j, k, num_sym;
+
+    SpglibDataset *dataset, *factorized;
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->n_pure_translations, 0);
+    EXPECT_EQ(dataset->pure_translations, nullptr);
+
+    factorized =
+        spg_get_factorized_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(factorized, nullptr);
+    EXPECT_EQ(factorized->spacegroup_number, 136);
+    ASSERT_EQ(factorized->n_pure_translations, 2);
+    ASSERT_EQ(factorized->n_operations, 16);
+    for (j = 0; j < 3; j++) {
+        EXPECT_EQ(factorized->pure_translations[0][j], 0);
+    }
+    for (i = 0; i < num_atom; i++) {
+        EXPECT_EQ(factorized->equivalent_atoms[i],
+                  dataset->equivalent_atoms[i]);
+    }
+
+    // Expanded operations are those of spg_get_dataset in the same order.
+    num_sym = spg_expand_dataset_operations(rotations, translations, 32,
+                                            factorized);
+    ASSERT_EQ(num_sym, dataset->n_operations);
+    for (i = 0; i < num_sym; i++) {
+        for (j = 0; j < 3; j++) {
+            for (k = 0; k < 3; k++) {
+                EXPECT_EQ(rotations[i][j][k], dataset->rotations[i][j][k]);
+            }
+            EXPECT_EQ(translations[i][j], dataset->translations[i][j]);
+        }
+    }
+
+    EXPECT_EQ(spg_expand_dataset_operations(rotations, translations, 31,
+                                            factorized),
+              0);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_ARRAY_SIZE_SHORTAGE);
+
+    spg_free_dataset(factorized);
+    factorized = NULL;
+    spg_free_dataset(dataset);
+    dataset = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_in_buffer) {
+    // Rutile doubled along c
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}};
+    double position[][3] = {
+        {0, 0, 0},        {0.5, 0.5, 0.25}, {0.3, 0.3, 0},    {0.7, 0.7, 0},
+        {0.2, 0.8, 0.25}, {0.8, 0.2, 0.25}, {0, 0, 0.5},      {0.5, 0.5, 0.75},
+        {0.3, 0.3, 0.5},  {0.7, 0.7, 0.5},  {0.2, 0.8, 0.75}, {0.8, 0.2, 0.75}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2};
+    int const num_atom = 12;
+    size_t buffer_size;
+    void *buffer;
+    int i, j, k, trial;
+
+    SpglibDataset *dataset, *in_buffer;
+    SpglibWorkspace *workspace;
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+
+    buffer_size = spg_get_dataset_buffer_size(num_atom);
+    buffer = malloc(buffer_size);
+    workspace = spg_alloc_workspace();
+    ASSERT_NE(workspace, nullptr);
+
+    // The workspace keeps its memory between the calls.
+    for (trial = 0; trial < 2; trial++) {
+        in_buffer = spg_get_dataset_in_buffer(buffer, buffer_size, workspace,
+                                              lattice, position, types,
+                                              num_atom, 1e-5);
+        ASSERT_NE(in_buffer, nullptr);
+        EXPECT_GE((char *)in_buffer, (char *)buffer);
+        EXPECT_LT((char *)in_buffer, (char *)buffer + buffer_size);
+        EXPECT_EQ(in_buffer->spacegroup_number, dataset->spacegroup_number);
+        EXPECT_EQ(in_buffer->hall_number, dataset->hall_number);
+        ASSERT_EQ(in_buffer->n_operations, dataset->n_operations);
+        for (i = 0; i < dataset->n_operations; i++) {
+            for (j = 0; j < 3; j++) {
+                for (k = 0; k < 3; k++) {
+                    EXPECT_EQ(in_buffer->rotations[i][j][k],
+                              dataset->rotations[i][j][k]);
+                }
+                EXPECT_EQ(in_buffer->translations[i][j],
+                          dataset->translations[i][j]);
+            }
+        }
+        for (i = 0; i < num_atom; i++) {
+            EXPECT_EQ(in_buffer->equivalent_atoms[i],
+                      dataset->equivalent_atoms[i]);
+            EXPECT_EQ(in_buffer->wyckoffs[i], dataset->wyckoffs[i]);
+        }
+        ASSERT_EQ(in_buffer->n_std_atoms, dataset->n_std_atoms);
+        for (i = 0; i < dataset->n_std_atoms; i++) {
+            EXPECT_EQ(in_buffer->std_types[i], dataset->std_types[i]);
+        }
+    }
+
+    // Without workspace
+    in_buffer = spg_get_dataset_in_buffer(buffer, buffer_size, NULL, lattice,
+                                          position, types, num_atom, 1e-5);
+    ASSERT_NE(in_buffer, nullptr);
+    EXPECT_EQ(in_buffer->n_operations, dataset->n_operations);
+
+    in_buffer = spg_get_dataset_in_buffer(buffer, 100, workspace, lattice,
+                                          position, types, num_atom, 1e-5);
+    EXPECT_EQ(in_buffer, nullptr);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_ARRAY_SIZE_SHORTAGE);
+
+    spg_free_workspace(workspace);
+    workspace = NULL;
+    free(buffer);
+    buffer = NULL;
+    spg_free_dataset(dataset);
+    dataset = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_update_dataset) {
+    // Rutile doubled along c
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}};
+    double position[][3] = {
+        {0, 0, 0},        {0.5, 0.5, 0.25}, {0.3, 0.3, 0},    {0.7, 0.7, 0},
+        {0.2, 0.8, 0.25}, {0.8, 0.2, 0.25}, {0, 0, 0.5},      {0.5, 0.5, 0.75},
+        {0.3, 0.3, 0.5},  {0.7, 0.7, 0.5},  {0.2, 0.8, 0.75}, {0.8, 0.2, 0.75}};
+    // Displacements of the oxygen atoms keeping P4_2/mnm
+    double displacement[][2] = {{0, 0},   {0, 0},  {1, 1},   {-1, -1},
+                                {-1, 1},  {1, -1}, {0, 0},   {0, 0},
+                                {1, 1},   {-1, -1}, {-1, 1}, {1, -1}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2};
+    int const num_atom = 12;
+    int i, j, k, step, is_factorized;
+
+    SpglibDataset *prev, *updated, *dataset;
+
+    for (is_factorized = 0; is_factorized < 2; is_factorized++) {
+        if (is_factorized) {
+            prev = spg_get_factorized_dataset(lattice, position, types,
+                                              num_atom, 1e-5);
+        } else {
+            prev = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+        }
+        ASSERT_NE(prev, nullptr);
+
+        // Steps 0-2 keep the symmetry and step 3 breaks it.
+        for (step = 0; step < 4; step++) {
+            lattice[2][2] += 0.01;
+            for (i = 0; i < num_atom; i++) {
+                for (j = 0; j < 2; j++) {
+                    position[i][j] += 0.002 * displacement[i][j];
+                }
+            }
+            if (step == 3) {
+                position[2][0] += 0.01;
+            }
+
+            updated = spg_update_dataset(prev, lattice, position, types,
+                                         num_atom, 1e-5);
+            ASSERT_NE(updated, nullptr);
+            if (is_factorized) {
+                dataset = spg_get_factorized_dataset(lattice, position, types,
+                                                     num_atom, 1e-5);
+            } else {
+                dataset =
+                    spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+            }
+            ASSERT_NE(dataset, nullptr);
+            if (step < 3) {
+                EXPECT_EQ(updated->spacegroup_number, 136);
+            } else {
+                EXPECT_NE(updated->spacegroup_number, 136);
+            }
+
+            // Same as the dataset searched from scratch
+            EXPECT_EQ(updated->spacegroup_number, dataset->spacegroup_number);
+            EXPECT_EQ(updated->hall_number, dataset->hall_number);
+            EXPECT_EQ(updated->n_pure_translations,
+                      dataset->n_pure_translations);
+            ASSERT_EQ(updated->n_operations, dataset->n_operations);
+            for (i = 0; i < dataset->n_operations; i++) {
+                for (j = 0; j < 3; j++) {
+                    for (k = 0; k < 3; k++) {
+                        EXPECT_EQ(updated->rotations[i][j][k],
+                                  dataset->rotations[i][j][k]);
+                    }
+                    EXPECT_NEAR(updated->translations[i][j],
+                                dataset->translations[i][j], 1e-8);
+                }
+            }
+            for (i = 0; i < 3; i++) {
+                EXPECT_NEAR(updated->origin_shift[i], dataset->origin_shift[i],
+                            1e-8);
+                for (j = 0; j < 3; j++) {
+                    EXPECT_NEAR(updated->transformation_matrix[i][j],
+                                dataset->transformation_matrix[i][j], 1e-8);
+                }
+            }
+            for (i = 0; i < num_atom; i++) {
+                EXPECT_EQ(updated->equivalent_atoms[i],
+                          dataset->equivalent_atoms[i]);
+                EXPECT_EQ(updated->wyckoffs[i], dataset->wyckoffs[i]);
+            }
+
+            spg_free_dataset(dataset);
+            dataset = NULL;
+            spg_free_dataset(prev);
+            prev = updated;
+            updated = NULL;
+        }
+
+        spg_free_dataset(prev);
+        prev = NULL;
+
+        // Restore the cell for the next loop.
+        lattice[2][2] = 3;
+        position[2][0] -= 0.01;
+        for (i = 0; i < num_atom; i++) {
+            for (j = 0; j < 2; j++) {
+                position[i][j] -= 0.008 * displacement[i][j];
+            }
+        }
+    }
+
+    // At symprec = 0.1, three displaced oxygen atoms give Pm, which has 4
+    // operations in the cell. Moving them back by 26/27 of the displacement
+    // restores the 32 operations of the cell. The operations of the
+    // previous Hall number are still found at a reduced tolerance, which
+    // must not be accepted as the update.
+    int const distorted[] = {5, 8, 11};
+    double const distortion[][3] = {
+        {0, 0.25, 0.25}, {0.5, 0.25, 0.25}, {0.5, 0.5, 0.25}};
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            position[distorted[i]][j] += 0.027 * distortion[i][j];
+        }
+    }
+    prev = spg_get_dataset(lattice, position, types, num_atom, 0.1);
+    ASSERT_NE(prev, nullptr);
+    EXPECT_EQ(prev->n_operations, 4);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            position[distorted[i]][j] -= 0.026 * distortion[i][j];
+        }
+    }
+    updated = spg_update_dataset(prev, lattice, position, types, num_atom,
+                                 0.1);
+    ASSERT_NE(updated, nullptr);
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 0.1);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->n_operations, 32);
+    EXPECT_EQ(updated->hall_number, dataset->hall_number);
+    EXPECT_EQ(updated->n_operations, dataset->n_operations);
+
+    spg_free_dataset(dataset);
+    dataset = NULL;
+    spg_free_dataset(updated);
+    updated = NULL;
+    spg_free_dataset(prev);
+    prev = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_with_options) {
+    // Rutile two unit cells
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 6}};
+    double position[][3] = {
+        {0, 0, 0},        {0.5, 0.5, 0.25}, {0.3, 0.3, 0},    {0.7, 0.7, 0},
+        {0.2, 0.8, 0.25}, {0.8, 0.2, 0.25}, {0, 0, 0.5},      {0.5, 0.5, 0.75},
+        {0.3, 0.3, 0.5},  {0.7, 0.7, 0.5},  {0.2, 0.8, 0.75}, {0.8, 0.2, 0.75}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2};
+    int const num_atom = 12;
+    int i, j, k;
+
+    SpglibDataset *dataset, *dataset_ops, *dataset_type, *dataset_std;
+    SpglibDataset *updated;
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->spacegroup_number, 136);
+
+    dataset_ops = spg_get_dataset_with_options(lattice, position, types,
+                                               num_atom,
+                                               SPGLIB_DATASET_OPERATIONS, 1e-5);
+    ASSERT_NE(dataset_ops, nullptr);
+    EXPECT_EQ(dataset_ops->hall_number, dataset->hall_number);
+    ASSERT_EQ(dataset_ops->n_operations, dataset->n_operations);
+    for (i = 0; i < dataset->n_operations; i++) {
+        for (j = 0; j < 3; j++) {
+            for (k = 0; k < 3; k++) {
+                EXPECT_EQ(dataset_ops->rotations[i][j][k],
+                          dataset->rotations[i][j][k]);
+            }
+            EXPECT_EQ(dataset_ops->translations[i][j],
+                      dataset->translations[i][j]);
+        }
+    }
+    for (i = 0; i < num_atom; i++) {
+        EXPECT_EQ(dataset_ops->mapping_to_primitive[i],
+                  dataset->mapping_to_primitive[i]);
+    }
+    EXPECT_EQ(dataset_ops->wyckoffs, nullptr);
+    EXPECT_EQ(dataset_ops->equivalent_atoms, nullptr);
+    EXPECT_EQ(dataset_ops->n_std_atoms, 0);
+    EXPECT_EQ(dataset_ops->std_positions, nullptr);
+
+    dataset_type = spg_get_dataset_with_options(
+        lattice, position, types, num_atom, SPGLIB_DATASET_SPACEGROUP_TYPE,
+        1e-5);
+    ASSERT_NE(dataset_type, nullptr);
+    EXPECT_EQ(dataset_type->hall_number, dataset->hall_number);
+    EXPECT_STREQ(dataset_type->international_symbol,
+                 dataset->international_symbol);
+    EXPECT_STREQ(dataset_type->pointgroup_symbol, dataset->pointgroup_symbol);
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ(dataset_type->origin_shift[i], dataset->origin_shift[i]);
+        for (j = 0; j < 3; j++) {
+            EXPECT_EQ(dataset_type->transformation_matrix[i][j],
+                      dataset->transformation_matrix[i][j]);
+        }
+    }
+    EXPECT_EQ(dataset_type->n_operations, 0);
+    EXPECT_EQ(dataset_type->rotations, nullptr);
+
+    dataset_std = spg_get_dataset_with_options(
+        lattice, position, types, num_atom,
+        SPGLIB_DATASET_WYCKOFFS | SPGLIB_DATASET_STD_CELL, 1e-5);
+    ASSERT_NE(dataset_std, nullptr);
+    EXPECT_EQ(dataset_std->n_operations, 0);
+    for (i = 0; i < num_atom; i++) {
+        EXPECT_EQ(dataset_std->wyckoffs[i], dataset->wyckoffs[i]);
+        EXPECT_EQ(dataset_std->equivalent_atoms[i],
+                  dataset->equivalent_atoms[i]);
+    }
+    ASSERT_EQ(dataset_std->n_std_atoms, dataset->n_std_atoms);
+    for (i = 0; i < dataset->n_std_atoms; i++) {
+        EXPECT_EQ(dataset_std->std_types[i], dataset->std_types[i]);
+        for (j = 0; j < 3; j++) {
+            EXPECT_EQ(dataset_std->std_positions[i][j],
+                      dataset->std_positions[i][j]);
+        }
+    }
+
+    // Without the operations, the update searches from scratch.
+    updated = spg_update_dataset(dataset_type, lattice, position, types,
+                                 num_atom, 1e-5);
+    ASSERT_NE(updated, nullptr);
+    EXPECT_EQ(updated->hall_number, dataset->hall_number);
+    ASSERT_EQ(updated->n_operations, dataset->n_operations);
+    for (i = 0; i < dataset->n_operations; i++) {
+        for (j = 0; j < 3; j++) {
+            for (k = 0; k < 3; k++) {
+                EXPECT_EQ(updated->rotations[i][j][k],
+                          dataset->rotations[i][j][k]);
+            }
+        }
+    }
+    for (i = 0; i < num_atom; i++) {
+        EXPECT_EQ(updated->wyckoffs[i], dataset->wyckoffs[i]);
+    }
+
+    spg_free_dataset(dataset);
+    dataset = NULL;
+    spg_free_dataset(dataset_ops);
+    dataset_ops = NULL;
+    spg_free_dataset(dataset_type);
+    dataset_type = NULL;
+    spg_free_dataset(dataset_std);
+    dataset_std = NULL;
+    spg_free_dataset(updated);
+    updated = NULL;
+}
+
+namespace {
+// Distorted P2_1/m (POSCAR-11 of the distorted test structures) displaced
+// by amplitude, where the space group at symprec=0.14 is found only after
+// the tolerance is reduced.
+void set_distorted_cell(double lattice[3][3], double position[][3],
+                        int types[], double const amplitude) {
+    double const lattice0[3][3] = {{11.32741769, -2.84874166, 0},
+                                   {-0.10246116, 7.50332458, 0},
+                                   {0, 0, 8.49408944}};
+    double const position0[][3] = {
+        {0.90851861, 0.21051529, 0.25727981},
+        {0.46576773, 0.66183489, 0.26060525},
+        {0.09148139, 0.78948471, 0.75727981},
+        {0.53423227, 0.33816511, 0.76060525},
+        {0.27579235, 0.08858243, 0.2558383},
+        {0.72420765, 0.91141757, 0.7558383},
+        {0.78543563, 0.74489282, 0.023756},
+        {0.54751072, 0.19097495, 0.25401026},
+        {0.14379995, 0.71511876, 0.25898465},
+        {0.78800764, 0.74431709, 0.49152573},
+        {0.21456437, 0.25510718, 0.523756},
+        {0.45248928, 0.80902505, 0.75401026},
+        {0.85620005, 0.28488124, 0.75898465},
+        {0.21199236, 0.25568291, 0.99152573}};
+    int const types0[] = {1, 1, 1, 1, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3};
+    int i, j;
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            lattice[i][j] = lattice0[i][j];
+        }
+    }
+    for (i = 0; i < 14; i++) {
+        for (j = 0; j < 3; j++) {
+            position[i][j] =
+                position0[i][j] + amplitude * ((i * 7 + j * 3) % 5 - 2) / 4;
+        }
+        types[i] = types0[i];
+    }
+}
+}  // namespace
+
+TEST(SymmetrySearch, test_spg_get_international_of_distorted_cell) {
+    double lattice[3][3];
+    double position[14][3];
+    int types[14];
+    int const num_atom = 14;
+    double const symprecs[] = {1e-5, 0.01, 0.05, 0.1, 0.14, 0.2};
+    double const amplitudes[] = {0, 0.01};
+    int i, j, k, l, m, num_sym;
+    char symbol[11], schoenflies[7];
+    int rotations[48][3][3];
+    double translations[48][3];
+
+    SpglibDataset *dataset, *reduced;
+
+    for (i = 0; i < 2; i++) {
+        set_distorted_cell(lattice, position, types, amplitudes[i]);
+        for (l = 0; l < 6; l++) {
+            dataset = spg_get_dataset(lattice, position, types, num_atom,
+                                      symprecs[l]);
+            ASSERT_NE(dataset, nullptr);
+            EXPECT_EQ(spg_get_international(symbol, lattice, position, types,
+                                            num_atom, symprecs[l]),
+                      dataset->spacegroup_number);
+            EXPECT_STREQ(symbol, dataset->international_symbol);
+            EXPECT_EQ(spg_get_schoenflies(schoenflies, lattice, position, types,
+                                          num_atom, symprecs[l]),
+                      dataset->spacegroup_number);
+            EXPECT_EQ(spg_get_multiplicity(lattice, position, types, num_atom,
+                                           symprecs[l]),
+                      dataset->n_operations);
+            num_sym = spg_get_symmetry(rotations, translations, 48, lattice,
+                                       position, types, num_atom, symprecs[l]);
+            ASSERT_EQ(num_sym, dataset->n_operations);
+            for (j = 0; j < num_sym; j++) {
+                for (k = 0; k < 3; k++) {
+                    for (m = 0; m < 3; m++) {
+                        EXPECT_EQ(rotations[j][k][m],
+                                  dataset->rotations[j][k][m]);
+                    }
+                }
+            }
+            // The reduced options retry the same tolerances.
+            for (j = 0; j < 2; j++) {
+                reduced = spg_get_dataset_with_options(
+                    lattice, position, types, num_atom,
+                    j ? SPGLIB_DATASET_OPERATIONS
+                      : SPGLIB_DATASET_SPACEGROUP_TYPE,
+                    symprecs[l]);
+                ASSERT_NE(reduced, nullptr);
+                EXPECT_EQ(reduced->hall_number, dataset->hall_number);
+                EXPECT_EQ(reduced->n_operations, j * dataset->n_operations);
+                spg_free_dataset(reduced);
+                reduced = NULL;
+            }
+            spg_free_dataset(dataset);
+            dataset = NULL;
+        }
+    }
+}
+
+TEST(SymmetrySearch, test_tolerance_threads) {
+    double lattice[3][3];
+    double position[14][3];
+    int types[14];
+    int const num_atom = 14;
+    double const symprecs[] = {1e-5, 0.1, 0.14};
+    int i, j, k, l;
+
+    SpglibDataset *serial, *parallel;
+
+    // The first tolerance fails at symprec=0.14.
+    set_distorted_cell(lattice, position, types, 0.01);
+    for (l = 0; l < 3; l++) {
+        serial = spg_get_dataset(lattice, position, types, num_atom,
+                                 symprecs[l]);
+        ASSERT_NE(serial, nullptr);
+        ASSERT_EQ(setenv("SPGLIB_TOLERANCE_THREADS", "4", 1), 0);
+        parallel = spg_get_dataset(lattice, position, types, num_atom,
+                                   symprecs[l]);
+        ASSERT_EQ(setenv("SPGLIB_TOLERANCE_THREADS", "1", 1), 0);
+        ASSERT_NE(parallel, nullptr);
+
+        EXPECT_EQ(parallel->hall_number, serial->hall_number);
+        ASSERT_EQ(parallel->n_operations, serial->n_operations);
+        for (i = 0; i < serial->n_operations; i++) {
+            for (j = 0; j < 3; j++) {
+                for (k = 0; k < 3; k++) {
+                    EXPECT_EQ(parallel->rotations[i][j][k],
+                              serial->rotations[i][j][k]);
+                }
+                EXPECT_EQ(parallel->translations[i][j],
+                          serial->translations[i][j]);
+            }
+        }
+        for (i = 0; i < num_atom; i++) {
+            EXPECT_EQ(parallel->wyckoffs[i], serial->wyckoffs[i]);
+            EXPECT_EQ(parallel->equivalent_atoms[i],
+                      serial->equivalent_atoms[i]);
+        }
+        ASSERT_EQ(parallel->n_std_atoms, serial->n_std_atoms);
+        for (i = 0; i < serial->n_std_atoms; i++) {
+            for (j = 0; j < 3; j++) {
+                EXPECT_EQ(parallel->std_positions[i][j],
+                          serial->std_positions[i][j]);
+            }
+        }
+
+        spg_free_dataset(serial);
+        serial = NULL;
+        spg_free_dataset(parallel);
+        parallel = NULL;
+    }
+}
+
+TEST(SymmetrySearch, test_spg_get_dataset_tolerance_scan_of_distorted_cell) {
+    // The symmetry is not monotonic in symprec. With amplitude 0.005, P-1
+    // is found from 0.09 to 0.105 between P1 at 0.085 and 0.11. With 0.007,
+    // P2_1/m is found at 0.15 and 0.155 between P-1 at 0.145 and 0.16.
+    double lattice[3][3];
+    double position[14][3];
+    int types[14];
+    int const num_atom = 14;
+    double const amplitudes[] = {0.005, 0.007};
+    double symprecs[41];
+    int spacegroup_numbers[41], hall_numbers[41], n_operations[41];
+    int i, j;
+
+    SpglibDataset *dataset;
+
+    for (i = 0; i < 41; i++) {
+        symprecs[i] = 0.01 + 0.005 * i;
+    }
+
+    for (i = 0; i < 2; i++) {
+        set_distorted_cell(lattice, position, types, amplitudes[i]);
+        spg_get_dataset_tolerance_scan(spacegroup_numbers, hall_numbers,
+                                       n_operations, lattice, position,
+                                       types, num_atom, symprecs, 41);
+        for (j = 0; j < 41; j++) {
+            dataset = spg_get_dataset(lattice, position, types, num_atom,
+                                      symprecs[j]);
+            ASSERT_NE(dataset, nullptr);
+            EXPECT_EQ(hall_numbers[j], dataset->hall_number)
+                << "symprec=" << symprecs[j];
+            EXPECT_EQ(n_operations[j], dataset->n_operations)
+                << "symprec=" << symprecs[j];
+            spg_free_dataset(dataset);
+            dataset = NULL;
+        }
+    }
+}
+
+TEST(SymmetrySearch, test_spg_verify_symmetry_operations) {
+    // Rutile
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}};
+    double position[][3] = {{0, 0, 0},     {0.5, 0.5, 0.5}, {0.3, 0.3, 0},
+                            {0.7, 0.7, 0}, {0.2, 0.8, 0.5}, {0.8, 0.2, 0.5}};
+    int types[] = {1, 1, 2, 2, 2, 2};
+    int const num_atom = 6;
+    int rotations[17][3][3];
+    double translations[17][3];
+    int is_symmetry[17], permutations[17 * 6], is_mapped[6];
+    double max_displacements[17];
+    int i, j, num_sym;
+
+    SpglibDataset *dataset;
+
+    dataset = spg_get_dataset(lattice, position, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    ASSERT_EQ(dataset->n_operations, 16);
+    for (i = 0; i < 16; i++) {
+        for (j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+                rotations[i][j][k] = dataset->rotations[i][j][k];
+            }
+            translations[i][j] = dataset->translations[i][j];
+        }
+    }
+    // Identity with a translation that is not a symmetry
+    for (j = 0; j < 3; j++) {
+        for (int k = 0; k < 3; k++) {
+            rotations[16][j][k] = (j == k);
+        }
+        translations[16][j] = 0.1;
+    }
+
+    // Displace an oxygen atom within the tolerance.
+    position[2][0] += 0.01 / 4;
+    num_sym = spg_verify_symmetry_operations(
+        is_symmetry, permutations, max_displacements, rotations, translations,
+        17, lattice, position, types, num_atom, 0.1);
+    EXPECT_EQ(num_sym, 16);
+    for (i = 0; i < 16; i++) {
+        EXPECT_EQ(is_symmetry[i], 1);
+        for (j = 0; j < num_atom; j++) {
+            is_mapped[j] = 0;
+        }
+        for (j = 0; j < num_atom; j++) {
+            ASSERT_GE(permutations[i * num_atom + j], 0);
+            EXPECT_EQ(types[permutations[i * num_atom + j]], types[j]);
+            is_mapped[permutations[i * num_atom + j]] = 1;
+        }
+        for (j = 0; j < num_atom; j++) {
+            EXPECT_EQ(is_mapped[j], 1);
+        }
+        EXPECT_LT(max_displacements[i], 0.0201);
+    }
+    // The identity maps every atom onto itself.
+    for (j = 0; j < num_atom; j++) {
+        EXPECT_EQ(permutations[j], j);
+    }
+    EXPECT_NEAR(max_displacements[0], 0, 1e-10);
+    EXPECT_EQ(is_symmetry[16], 0);
+    EXPECT_EQ(max_displacements[16], -1);
+    for (j = 0; j < num_atom; j++) {
+        EXPECT_EQ(permutations[16 * num_atom + j], -1);
+    }
+
+    // The displaced atom breaks operations with a smaller tolerance except
+    // for the identity and the mirror perpendicular to c.
+    num_sym = spg_verify_symmetry_operations(is_symmetry, NULL, NULL,
+                                             rotations, translations, 17,
+                                             lattice, position, types,
+                                             num_atom, 1e-5);
+    EXPECT_EQ(num_sym, 2);
+    EXPECT_EQ(is_symmetry[0], 1);
+
+    // Failure is distinguished from no operation being a symmetry.
+    spg_set_work_budget(0, 1);
+    num_sym = spg_verify_symmetry_operations(is_symmetry, NULL, NULL,
+                                             rotations, translations, 17,
+                                             lattice, position, types,
+                                             num_atom, 0.1);
+    EXPECT_EQ(num_sym, -1);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_WORK_BUDGET_EXCEEDED);
+    spg_set_work_budget(0, 0);
+
+    spg_free_dataset(dataset);
+    dataset = NULL;
+}
+
+TEST(SymmetrySearch, test_spg_set_work_budget) {
+    // Two rutile cells packed in one array
+    double lattices[2][3][3] = {{{4, 0, 0}, {0, 4, 0}, {0, 0, 3}},
+                                {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}}};
+    double positions[][3] = {{0, 0, 0},       {0.5, 0.5, 0.5}, {0.3, 0.3, 0},
+                             {0.7, 0.7, 0},   {0.2, 0.8, 0.5}, {0.8, 0.2, 0.5},
+                             {0, 0, 0},       {0.5, 0.5, 0.5}, {0.3, 0.3, 0},
+                             {0.7, 0.7, 0},   {0.2, 0.8, 0.5}, {0.8, 0.2, 0.5}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2};
+    int offsets[] = {0, 6, 12};
+    int const num_atom = 6;
+    int i, num_found;
+
+    SpglibDataset *datasets[2];
+    SpglibError error_codes[2];
+    SpglibDataset *dataset;
+
+    // Too few overlap checks
+    spg_set_work_budget(0, 10);
+    dataset = spg_get_dataset(lattices[0], positions, types, num_atom, 1e-5);
+    EXPECT_EQ(dataset, nullptr);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_WORK_BUDGET_EXCEEDED);
+
+    // Too short time
+    spg_set_work_budget(1e-9, 0);
+    dataset = spg_get_dataset(lattices[0], positions, types, num_atom, 1e-5);
+    EXPECT_EQ(dataset, nullptr);
+    EXPECT_EQ(spg_get_error_code(), SPGERR_WORK_BUDGET_EXCEEDED);
+
+    spg_set_work_budget(60, 1000);
+    dataset = spg_get_dataset(lattices[0], positions, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->spacegroup_number, 136);
+    spg_free_dataset(dataset);
+    dataset = NULL;
+
+    // The budget is not shared by the cells, so that it is enough for each
+    // of them though not for both.
+    spg_set_work_budget(0, 50);
+    num_found = spg_get_datasets(datasets, error_codes, lattices, positions,
+                                 types, offsets, 2, 1e-5);
+    EXPECT_EQ(num_found, 2);
+    for (i = 0; i < 2; i++) {
+        ASSERT_NE(datasets[i], nullptr);
+        EXPECT_EQ(error_codes[i], SPGLIB_SUCCESS);
+        EXPECT_EQ(datasets[i]->spacegroup_number, 136);
+        spg_free_dataset(datasets[i]);
+        datasets[i] = NULL;
+    }
+
+    spg_set_work_budget(0, 0);
+    dataset = spg_get_dataset(lattices[0], positions, types, num_atom, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->spacegroup_number, 136);
+    spg_free_dataset(dataset);
+    dataset = NULL;
+}
@@ -1,10 +1,12 @@
 from __future__ import annotations
 
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 from typing import Callable
 
+import numpy as np
 import pytest
-from spglib import get_symmetry_dataset
+from spglib import get_symmetry, get_symmetry_dataset
 
 
 @pytest.mark.benchmark(group="space-group")
@@ -23,3 +25,65 @@ def test_get_symmetry_dataset(
             _ = get_symmetry_dataset(cell, symprec=1e-5)
 
     benchmark.pedantic(_get_symmetry_dataset_for_cells, rounds=4)
+
+
+@pytest.mark.benchmark(group="lattice-symmetry")
+@pytest.mark.parametrize(
+    "lattice",
+    [
+        [[4, 0, 0], [0, 4, 0], [0, 0, 4]],
+        [[0, 2, 2], [2, 0, 2], [2, 2, 0]],
+        [[4, 0, 0], [0.3, 5, 0], [0.2, 0.4, 6]],
+    ],
+    ids=["cubic", "fcc-primitive", "triclinic"],
+)
+def test_get_symmetry_single_atom(benchmark, lattice: list[list[float]]):
+    """Benchmarking get_symmetry on one-atom cells.
+
+    The search of the translations is trivial for one atom. The search of the
+    lattice symmetry is measured for the triclinic cell, where the dataset has
+    little else to do, and the other cells show its share of the total time.
+    """
+    cell = (np.array(lattice, dtype="double"), [[0, 0, 0]], [1])
+
+    def _get_symmetry():
+        return get_symmetry(cell, symprec=1e-5)
+
+    symmetry = benchmark.pedantic(_get_symmetry, rounds=100)
+    assert len(symmetry["rotations"]) in (48, 2)
+
+
+@pytest.mark.benchmark(group="space-group-threads")
+@pytest.mark.parametrize("num_threads", [1, 2, 4, 8])
+def test_get_symmetry_dataset_threads(
+    benchmark,
+    all_filenames: list[Path],
+    read_vasp: Callable,
+    num_threads: int,
+):
+    """Benchmarking get_symmetry_dataset on all structures under test/data
+    dispatched from a thread pool.
+
+    The GIL is released during the symmetry search, so the wall time should
+    decrease almost linearly with the number of threads up to the number of
+    available cores.
+    """
+    cells = [read_vasp(fname) for fname in all_filenames]
+
+    def _get_symmetry_dataset(cell):
+        return get_symmetry_dataset(cell, symprec=1e-5)
+
+    with ThreadPoolExecutor(max_workers=num_threads) as executor:
+
+        def _get_symmetry_dataset_for_cells():
+            return list(executor.map(_get_symmetry_dataset, cells))
+
+        datasets = benchmark.pedantic(_get_symmetry_dataset_for_cells, rounds=4)
+
+    # Results must not depend on the thread the search ran on
+    for cell, dataset in zip(cells, datasets):
+        expected = _get_symmetry_dataset(cell)
+        if expected is None:
+            assert dataset is None
+        else:
+            assert dataset.number == expected.number
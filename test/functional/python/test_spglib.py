@@ -1,18 +1,27 @@
+import gc
 import os
 import unittest
+from unittest import mock
 
 import numpy as np
 import yaml
 from spglib import (
     MagneticSpaceGroupType,
+    expand_symmetry_operations,
     find_primitive,
+    get_error_message,
+    get_factorized_symmetry_dataset,
     get_magnetic_spacegroup_type,
     get_magnetic_symmetry_from_database,
     get_pointgroup,
     get_spacegroup,
     get_spacegroup_type,
     get_symmetry_dataset,
+    get_symmetry_dataset_tolerance_scan,
+    get_symmetry_datasets,
+    set_work_budget,
     standardize_cell,
+    verify_symmetry_operations,
 )
 from vasp import read_vasp
 
@@ -132,6 +141,147 @@ class TestSpglib(unittest.TestCase):
             #     for w in dataset['wyckoffs']:
             #         f.write("- \"%s\"\n" % w)
 
+    def test_get_symmetry_datasets(self):
+        cells = [
+            read_vasp(fname)
+            for fname in self._filenames
+            if "distorted" not in fname
+        ]
+        # Two atoms at the same position
+        cells.append((np.eye(3) * 4, [[0, 0, 0], [0, 0, 0]], [1, 1]))
+        datasets = get_symmetry_datasets(cells, symprec=1e-5)
+        self.assertEqual(len(datasets), len(cells))
+        self.assertIsNone(datasets[-1])
+        self.assertEqual(get_error_message(), "too close distance between atoms")
+        for cell, dataset in zip(cells[:-1], datasets[:-1]):
+            ref = get_symmetry_dataset(cell, symprec=1e-5)
+            self.assertEqual(dataset.number, ref.number)
+            self.assertEqual(dataset.hall_number, ref.hall_number)
+            np.testing.assert_array_equal(dataset.rotations, ref.rotations)
+            np.testing.assert_allclose(dataset.translations, ref.translations)
+            np.testing.assert_array_equal(
+                dataset.equivalent_atoms, ref.equivalent_atoms
+            )
+        self.assertEqual(get_symmetry_datasets([]), [])
+
+    def test_get_factorized_symmetry_dataset(self):
+        for fname in self._filenames:
+            if "virtual_structure" not in fname:
+                continue
+            cell = read_vasp(fname)
+            dataset = get_symmetry_dataset(cell)
+            factorized = get_factorized_symmetry_dataset(cell)
+            self.assertIsNone(dataset.pure_translations)
+            num_pure = len(factorized.pure_translations)
+            self.assertEqual(
+                len(factorized.rotations) * num_pure,
+                len(dataset.rotations),
+                msg=fname,
+            )
+            np.testing.assert_array_equal(factorized.pure_translations[0], 0)
+            rotations, translations = expand_symmetry_operations(factorized)
+            np.testing.assert_array_equal(rotations, dataset.rotations)
+            np.testing.assert_allclose(
+                translations, dataset.translations, atol=1e-10
+            )
+
+    def test_get_symmetry_dataset_arrays_outlive_dataset(self):
+        cell = read_vasp(self._filenames[0])
+        dataset = get_symmetry_dataset(cell)
+        rotations = dataset.rotations
+        std_positions = dataset.std_positions.copy()
+        self.assertEqual(rotations.dtype, np.dtype("intc"))
+        self.assertTrue(rotations.flags.c_contiguous)
+        del dataset
+        gc.collect()
+        np.testing.assert_array_equal(
+            rotations, get_symmetry_dataset(cell).rotations
+        )
+        np.testing.assert_array_equal(
+            std_positions, get_symmetry_dataset(cell).std_positions
+        )
+
+    def test_get_symmetry_dataset_tolerance_scan(self):
+        symprecs = [1e-5, 1e-3, 1e-2, 3e-2, 0.1, 0.2]
+        for fname in self._filenames:
+            if "distorted" not in fname:
+                continue
+            cell = read_vasp(fname)
+            numbers, hall_numbers, n_operations = (
+                get_symmetry_dataset_tolerance_scan(cell, symprecs)
+            )
+            for i, symprec in enumerate(symprecs):
+                ref = get_symmetry_dataset(cell, symprec=symprec)
+                if ref is None:
+                    self.assertEqual(hall_numbers[i], 0)
+                    continue
+                self.assertEqual(numbers[i], ref.number, msg=fname)
+                self.assertEqual(hall_numbers[i], ref.hall_number, msg=fname)
+                self.assertEqual(n_operations[i], len(ref.rotations), msg=fname)
+
+    def test_get_symmetry_dataset_tolerance_threads(self):
+        symprecs = [1e-5, 1e-2, 0.1]
+        for fname in self._filenames:
+            if "distorted" not in fname:
+                continue
+            cell = read_vasp(fname)
+            for symprec in symprecs:
+                ref = get_symmetry_dataset(cell, symprec=symprec)
+                with mock.patch.dict(os.environ, {"SPGLIB_TOLERANCE_THREADS": "4"}):
+                    dataset = get_symmetry_dataset(cell, symprec=symprec)
+                if ref is None:
+                    self.assertIsNone(dataset, msg=fname)
+                    continue
+                self.assertEqual(dataset.hall_number, ref.hall_number, msg=fname)
+                np.testing.assert_array_equal(dataset.rotations, ref.rotations)
+                np.testing.assert_allclose(
+                    dataset.std_positions, ref.std_positions, atol=1e-12
+                )
+
+    def test_set_work_budget(self):
+        for fname in self._filenames[:10]:
+            cell = read_vasp(fname)
+            ref = get_symmetry_dataset(cell, symprec=1e-5)
+            try:
+                set_work_budget(max_overlap_checks=1)
+                dataset = get_symmetry_dataset(cell, symprec=1e-5)
+                self.assertIsNone(dataset, msg=fname)
+                self.assertEqual(get_error_message(), "work budget exceeded")
+                set_work_budget(max_seconds=60)
+                dataset = get_symmetry_dataset(cell, symprec=1e-5)
+            finally:
+                set_work_budget()
+            self.assertEqual(dataset.hall_number, ref.hall_number, msg=fname)
+
+    def test_verify_symmetry_operations(self):
+        for fname in self._filenames:
+            if "distorted" in fname:
+                continue
+            cell = read_vasp(fname)
+            dataset = get_symmetry_dataset(cell, symprec=1e-5)
+            rotations = np.append(
+                dataset.rotations, [-np.eye(3, dtype="intc")], axis=0
+            )
+            translations = np.append(
+                dataset.translations, [[0.1234, 0.0, 0.0]], axis=0
+            )
+            is_symmetry, permutations, max_displacements = (
+                verify_symmetry_operations(cell, rotations, translations)
+            )
+            n_ops = len(dataset.rotations)
+            self.assertTrue(is_symmetry[:n_ops].all(), msg=fname)
+            self.assertFalse(is_symmetry[n_ops], msg=fname)
+            self.assertEqual(permutations[n_ops, 0], -1, msg=fname)
+            self.assertEqual(max_displacements[n_ops], -1, msg=fname)
+            n_atoms = len(cell[1])
+            for perm in permutations[:n_ops]:
+                np.testing.assert_array_equal(
+                    np.sort(perm), np.arange(n_atoms), err_msg=fname
+                )
+            self.assertTrue((max_displacements[:n_ops] < 1e-5).all(), msg=fname)
+        with self.assertRaises(ValueError):
+            verify_symmetry_operations(cell, rotations, translations[:-1])
+
     def test_standardize_cell_and_pointgroup(self):
         for fname, spgnum in zip(self._filenames, self._spgnum_ref):
             cell = read_vasp(fname)
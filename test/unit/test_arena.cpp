@@ -0,0 +1,50 @@
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "arena.h"
+}
+
+TEST(Arena, realloc_keeps_contents) {
+    arn_begin();
+    int* values = (int*)arn_malloc(sizeof(int) * 4);
+    ASSERT_NE(values, nullptr);
+    for (int i = 0; i < 4; i++) values[i] = i;
+    values = (int*)arn_realloc(values, sizeof(int) * 1000);
+    ASSERT_NE(values, nullptr);
+    for (int i = 0; i < 4; i++) EXPECT_EQ(values[i], i);
+    arn_free(values);
+    arn_end();
+}
+
+TEST(Arena, calloc_clears_memory) {
+    arn_begin();
+    for (int n = 1; n < 100000; n *= 7) {
+        char* buffer = (char*)arn_calloc(n, sizeof(char));
+        ASSERT_NE(buffer, nullptr);
+        for (int i = 0; i < n; i++) ASSERT_EQ(buffer[i], 0);
+        std::memset(buffer, 1, n);
+        arn_free(buffer);
+    }
+    arn_end();
+}
+
+TEST(Arena, nested_scopes) {
+    // Memory taken outside of the scopes is in the heap, and memory of a
+    // nested scope is released only by arn_end of the outermost scope.
+    double* outer = (double*)arn_malloc(sizeof(double) * 3);
+    ASSERT_NE(outer, nullptr);
+    arn_begin();
+    arn_begin();
+    double* inner = (double*)arn_malloc(sizeof(double) * 3);
+    ASSERT_NE(inner, nullptr);
+    arn_end();
+    inner[2] = 2.5;
+    EXPECT_EQ(inner[2], 2.5);
+    arn_free(inner);
+    arn_end();
+    outer[2] = 1.5;
+    EXPECT_EQ(outer[2], 1.5);
+    arn_free(outer);
+}
@@ -1,3 +1,7 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
 #include <gtest/gtest.h>
 
 extern "C" {
@@ -11,3 +15,157 @@ TEST(DatasetAccess, test_spg_get_spacegroup_type) {
     ASSERT_EQ(spg_get_error_code(), SPGLIB_SUCCESS);
     EXPECT_EQ(spgtype.number, 156);
 }
+
+TEST(DatasetAccess, test_dataset_in_one_block) {
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 3}};
+    double position[][3] = {{0, 0, 0},     {0.5, 0.5, 0.5}, {0.3, 0.3, 0},
+                             {0.7, 0.7, 0}, {0.2, 0.8, 0.5}, {0.8, 0.2, 0.5}};
+    int types[] = {1, 1, 2, 2, 2, 2};
+    SpglibDataset *dataset = spg_get_dataset(lattice, position, types, 6, 1e-5);
+    ASSERT_NE(dataset, nullptr);
+
+    // The arrays follow the dataset in the same memory block without
+    // overlapping, and each of them is 16-byte aligned.
+    struct Array {
+        void const *ptr;
+        size_t size;
+    };
+    Array arrays[] = {
+        {dataset->rotations, sizeof(int[3][3]) * dataset->n_operations},
+        {dataset->translations, sizeof(double[3]) * dataset->n_operations},
+        {dataset->wyckoffs, sizeof(int) * dataset->n_atoms},
+        {dataset->equivalent_atoms, sizeof(int) * dataset->n_atoms},
+        {dataset->crystallographic_orbits, sizeof(int) * dataset->n_atoms},
+        {dataset->mapping_to_primitive, sizeof(int) * dataset->n_atoms},
+        {dataset->site_symmetry_symbols, sizeof(char[7]) * dataset->n_atoms},
+        {dataset->std_positions, sizeof(double[3]) * dataset->n_std_atoms},
+        {dataset->std_types, sizeof(int) * dataset->n_std_atoms},
+        {dataset->std_mapping_to_primitive,
+         sizeof(int) * dataset->n_std_atoms},
+    };
+    char const *end = (char const *)(dataset + 1);
+    for (auto const &array : arrays) {
+        ASSERT_NE(array.ptr, nullptr);
+        EXPECT_EQ((uintptr_t)array.ptr % 16, 0);
+        EXPECT_GE((char const *)array.ptr, end);
+        end = (char const *)array.ptr + array.size;
+    }
+    EXPECT_EQ(dataset->pure_translations, nullptr);
+    spg_free_dataset(dataset);
+}
+
+// Compares every array of the datasets and checks that the arrays of copy
+// are in its own block.
+static void expect_same_dataset(SpglibDataset const *copy,
+                                SpglibDataset const *dataset) {
+    char const *begin = (char const *)copy;
+    char const *end = begin + spg_get_dataset_size(copy);
+    auto expect_in_block = [&](void const *ptr) {
+        if (ptr != nullptr) {
+            EXPECT_GE((char const *)ptr, begin);
+            EXPECT_LT((char const *)ptr, end);
+        }
+    };
+
+    ASSERT_EQ(spg_get_dataset_size(copy), spg_get_dataset_size(dataset));
+    EXPECT_EQ(copy->spacegroup_number, dataset->spacegroup_number);
+    EXPECT_EQ(copy->hall_number, dataset->hall_number);
+    EXPECT_STREQ(copy->international_symbol, dataset->international_symbol);
+    ASSERT_EQ(copy->n_operations, dataset->n_operations);
+    ASSERT_EQ(copy->n_pure_translations, dataset->n_pure_translations);
+    ASSERT_EQ(copy->n_atoms, dataset->n_atoms);
+    ASSERT_EQ(copy->n_std_atoms, dataset->n_std_atoms);
+
+    for (int i = 0; i < dataset->n_operations; i++) {
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 3; k++) {
+                EXPECT_EQ(copy->rotations[i][j][k],
+                          dataset->rotations[i][j][k]);
+            }
+            EXPECT_EQ(copy->translations[i][j], dataset->translations[i][j]);
+        }
+    }
+    for (int i = 0; i < dataset->n_pure_translations; i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(copy->pure_translations[i][j],
+                      dataset->pure_translations[i][j]);
+        }
+    }
+    ASSERT_EQ(copy->wyckoffs == nullptr, dataset->wyckoffs == nullptr);
+    for (int i = 0; i < dataset->n_atoms; i++) {
+        if (dataset->wyckoffs != nullptr) {
+            EXPECT_EQ(copy->wyckoffs[i], dataset->wyckoffs[i]);
+            EXPECT_EQ(copy->equivalent_atoms[i], dataset->equivalent_atoms[i]);
+            EXPECT_EQ(copy->crystallographic_orbits[i],
+                      dataset->crystallographic_orbits[i]);
+            EXPECT_STREQ(copy->site_symmetry_symbols[i],
+                         dataset->site_symmetry_symbols[i]);
+        }
+        EXPECT_EQ(copy->mapping_to_primitive[i],
+                  dataset->mapping_to_primitive[i]);
+    }
+    for (int i = 0; i < dataset->n_std_atoms; i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(copy->std_positions[i][j], dataset->std_positions[i][j]);
+        }
+        EXPECT_EQ(copy->std_types[i], dataset->std_types[i]);
+        EXPECT_EQ(copy->std_mapping_to_primitive[i],
+                  dataset->std_mapping_to_primitive[i]);
+    }
+
+    for (void const *ptr :
+         {(void const *)copy->rotations, (void const *)copy->translations,
+          (void const *)copy->pure_translations, (void const *)copy->wyckoffs,
+          (void const *)copy->equivalent_atoms,
+          (void const *)copy->crystallographic_orbits,
+          (void const *)copy->mapping_to_primitive,
+          (void const *)copy->site_symmetry_symbols,
+          (void const *)copy->std_positions, (void const *)copy->std_types,
+          (void const *)copy->std_mapping_to_primitive}) {
+        expect_in_block(ptr);
+    }
+}
+
+TEST(DatasetAccess, test_copy_and_rebase_dataset) {
+    // Rutile doubled along c
+    double lattice[3][3] = {{4, 0, 0}, {0, 4, 0}, {0, 0, 6}};
+    double position[][3] = {
+        {0, 0, 0},        {0.5, 0.5, 0.25}, {0.3, 0.3, 0},    {0.7, 0.7, 0},
+        {0.2, 0.8, 0.25}, {0.8, 0.2, 0.25}, {0, 0, 0.5},      {0.5, 0.5, 0.75},
+        {0.3, 0.3, 0.5},  {0.7, 0.7, 0.5},  {0.2, 0.8, 0.75}, {0.8, 0.2, 0.75}};
+    int types[] = {1, 1, 2, 2, 2, 2, 1, 1, 2, 2, 2, 2};
+    int const num_atom = 12;
+
+    SpglibDataset *datasets[] = {
+        spg_get_dataset(lattice, position, types, num_atom, 1e-5),
+        spg_get_factorized_dataset(lattice, position, types, num_atom, 1e-5),
+        spg_get_dataset_with_options(lattice, position, types, num_atom,
+                                     SPGLIB_DATASET_OPERATIONS, 1e-5),
+    };
+    ASSERT_NE(datasets[1], nullptr);
+    EXPECT_GT(datasets[1]->n_pure_translations, 0);
+    ASSERT_NE(datasets[2], nullptr);
+    EXPECT_EQ(datasets[2]->wyckoffs, nullptr);
+
+    for (SpglibDataset *dataset : datasets) {
+        ASSERT_NE(dataset, nullptr);
+
+        // Byte copy of the block rebased into the new memory
+        size_t const size = spg_get_dataset_size(dataset);
+        void *block = malloc(size);
+        ASSERT_NE(block, nullptr);
+        memcpy(block, dataset, size);
+        SpglibDataset *copy = spg_rebase_dataset((SpglibDataset *)block);
+        EXPECT_EQ((void *)copy, block);
+        expect_same_dataset(copy, dataset);
+
+        // The original can be freed before the copy is used.
+        SpglibDataset *other = spg_copy_dataset(copy);
+        ASSERT_NE(other, nullptr);
+        free(block);
+        expect_same_dataset(other, dataset);
+
+        spg_free_dataset(other);
+        spg_free_dataset(dataset);
+    }
+}
@@ -0,0 +1,483 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "cell.h"
+#include "overlap.h"
+}
+
+namespace {
+int const identity[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+int const inversion[3][3] = {{-1, 0, 0}, {0, -1, 0}, {0, 0, -1}};
+int const four_fold_z[3][3] = {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}};
+int const three_fold_111[3][3] = {{0, 0, 1}, {1, 0, 0}, {0, 1, 0}};
+int const mirror_z[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, -1}};
+int const two_fold_x[3][3] = {{1, 0, 0}, {0, -1, 0}, {0, 0, -1}};
+
+int baseline_nint(double const a) {
+    return a < 0 ? (int)(a - 0.5) : (int)(a + 0.5);
+}
+
+// Whether the i_orig-th atom overlaps with the i_rot-th transformed atom.
+// Differences along the aperiodic axis of a layer are not wrapped.
+bool has_overlap(Cell const *cell, std::vector<double> const &pos_rot,
+                 int const i_orig, int const i_rot, double const symprec) {
+    double diff[3], norm2 = 0;
+
+    if (cell->types[i_orig] != cell->types[i_rot]) {
+        return false;
+    }
+    for (int k = 0; k < 3; k++) {
+        diff[k] = cell->position[i_orig][k] - pos_rot[3 * i_rot + k];
+        if (k != cell->aperiodic_axis) {
+            diff[k] -= baseline_nint(diff[k]);
+        }
+    }
+    for (int k = 0; k < 3; k++) {
+        double x = 0;
+        for (int l = 0; l < 3; l++) {
+            x += cell->lattice[k][l] * diff[l];
+        }
+        norm2 += x * x;
+    }
+    return std::sqrt(norm2) <= symprec;
+}
+
+std::vector<double> get_rotated_positions(Cell const *cell,
+                                          int const rot[3][3],
+                                          double const trans[3]) {
+    std::vector<double> pos_rot(3 * cell->size);
+
+    for (int i = 0; i < cell->size; i++) {
+        for (int k = 0; k < 3; k++) {
+            pos_rot[3 * i + k] = trans[k];
+            for (int l = 0; l < 3; l++) {
+                pos_rot[3 * i + k] += rot[k][l] * cell->position[i][l];
+            }
+        }
+    }
+    return pos_rot;
+}
+
+// Overlap check of spglib 2.5: each atom of the cell is greedily matched
+// with the first unmatched atom of the same type among the transformed
+// atoms.
+int check_overlap_by_greedy_search(Cell const *cell, int const rot[3][3],
+                                   double const trans[3],
+                                   double const symprec) {
+    std::vector<double> const pos_rot = get_rotated_positions(cell, rot, trans);
+    std::vector<int> found(cell->size, 0);
+
+    for (int i_orig = 0; i_orig < cell->size; i_orig++) {
+        int i_rot;
+        for (i_rot = 0; i_rot < cell->size; i_rot++) {
+            if (!found[i_rot] &&
+                has_overlap(cell, pos_rot, i_orig, i_rot, symprec)) {
+                found[i_rot] = 1;
+                break;
+            }
+        }
+        if (i_rot == cell->size) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+bool find_augmenting_path(Cell const *cell, std::vector<double> const &pos_rot,
+                          double const symprec, int const i_rot,
+                          std::vector<int> &matched,
+                          std::vector<int> &visited) {
+    for (int i_orig = 0; i_orig < cell->size; i_orig++) {
+        if (visited[i_orig] ||
+            !has_overlap(cell, pos_rot, i_orig, i_rot, symprec)) {
+            continue;
+        }
+        visited[i_orig] = 1;
+        if (matched[i_orig] == -1 ||
+            find_augmenting_path(cell, pos_rot, symprec, matched[i_orig],
+                                 matched, visited)) {
+            matched[i_orig] = i_rot;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether all the atoms can be matched with distinct transformed atoms.
+int check_overlap_by_matching(Cell const *cell, int const rot[3][3],
+                              double const trans[3], double const symprec) {
+    std::vector<double> const pos_rot = get_rotated_positions(cell, rot, trans);
+    std::vector<int> matched(cell->size, -1);
+
+    for (int i_rot = 0; i_rot < cell->size; i_rot++) {
+        std::vector<int> visited(cell->size, 0);
+        if (!find_augmenting_path(cell, pos_rot, symprec, i_rot, matched,
+                                  visited)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Compares the overlap checker with the brute-force checks for the
+// operations (rot, pos[j] - rot.pos[0] + shift) with each rotation in
+// rots, each atom j of the type of the first atom, and each shift. The
+// checker accepts an operation iff all the atoms can be matched, which is
+// the same as the greedy search of spglib 2.5 unless atoms are closer
+// than 2 * symprec, where the greedy search can miss the matching.
+// Returns the number of the operations found to be symmetries.
+int compare_with_brute_force(Cell const *cell,
+                             std::vector<int const (*)[3]> const &rots,
+                             std::vector<std::vector<double>> const &shifts,
+                             double const symprec,
+                             bool const has_near_duplicates) {
+    OverlapChecker *checker;
+    int num_overlap, is_identity, expected, greedy, actual;
+    double trans[3], max_distance;
+    std::vector<int> mapping(cell->size);
+
+    checker = ovl_overlap_checker_init(cell);
+    EXPECT_NE(checker, nullptr);
+    if (checker == nullptr) {
+        return 0;
+    }
+
+    num_overlap = 0;
+    for (auto rot : rots) {
+        is_identity = (rot == identity);
+        for (int j = 0; j < cell->size; j++) {
+            if (cell->types[j] != cell->types[0]) {
+                continue;
+            }
+            for (auto const &shift : shifts) {
+                for (int k = 0; k < 3; k++) {
+                    trans[k] = cell->position[j][k] + shift[k];
+                    for (int l = 0; l < 3; l++) {
+                        trans[k] -= rot[k][l] * cell->position[0][l];
+                    }
+                }
+                expected =
+                    check_overlap_by_matching(cell, rot, trans, symprec);
+                greedy = check_overlap_by_greedy_search(cell, rot, trans,
+                                                        symprec);
+                if (has_near_duplicates) {
+                    EXPECT_GE(expected, greedy);
+                } else {
+                    EXPECT_EQ(expected, greedy);
+                }
+                if (cell->aperiodic_axis == -1) {
+                    actual = ovl_check_total_overlap(checker, trans, rot,
+                                                     symprec, is_identity);
+                } else {
+                    actual = ovl_check_layer_total_overlap(
+                        checker, trans, rot, symprec, is_identity);
+                }
+                EXPECT_EQ(actual, expected)
+                    << "atom " << j << " shift " << shift[0] << " "
+                    << shift[1] << " " << shift[2];
+
+                // The mapping of a symmetry is a permutation within symprec.
+                if (actual == 1) {
+                    EXPECT_EQ(ovl_get_overlap_mapping(
+                                  mapping.data(), &max_distance, checker,
+                                  trans, rot, symprec, is_identity,
+                                  cell->aperiodic_axis != -1),
+                              1);
+                    EXPECT_LE(max_distance, symprec);
+                    std::vector<int> is_mapped(cell->size, 0);
+                    for (int i = 0; i < cell->size; i++) {
+                        EXPECT_GE(mapping[i], 0);
+                        if (mapping[i] < 0) {
+                            continue;
+                        }
+                        EXPECT_EQ(cell->types[mapping[i]], cell->types[i]);
+                        is_mapped[mapping[i]]++;
+                    }
+                    for (int i = 0; i < cell->size; i++) {
+                        EXPECT_EQ(is_mapped[i], 1);
+                    }
+                    num_overlap++;
+                }
+            }
+        }
+    }
+
+    ovl_overlap_checker_free(checker);
+    return num_overlap;
+}
+
+// Adds a random Cartesian displacement shorter than 'amplitude'.
+void displace(double pos[3], double const lattice[3][3],
+              double const amplitude, std::mt19937 &rng) {
+    std::uniform_real_distribution<double> uniform(-1, 1);
+    double disp[3], inv[3][3], det;
+
+    do {
+        for (int k = 0; k < 3; k++) {
+            disp[k] = uniform(rng);
+        }
+    } while (disp[0] * disp[0] + disp[1] * disp[1] + disp[2] * disp[2] > 1);
+
+    det = lattice[0][0] * (lattice[1][1] * lattice[2][2] -
+                           lattice[1][2] * lattice[2][1]) -
+          lattice[0][1] * (lattice[1][0] * lattice[2][2] -
+                           lattice[1][2] * lattice[2][0]) +
+          lattice[0][2] *
+              (lattice[1][0] * lattice[2][1] - lattice[1][1] * lattice[2][0]);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            int const i1 = (j + 1) % 3, i2 = (j + 2) % 3;
+            int const j1 = (i + 1) % 3, j2 = (i + 2) % 3;
+            inv[i][j] = (lattice[i1][j1] * lattice[i2][j2] -
+                         lattice[i1][j2] * lattice[i2][j1]) /
+                        det;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            pos[i] += inv[i][j] * disp[j] * amplitude;
+        }
+    }
+}
+
+// Shifts of the translations: exact ones, ones within and beyond the
+// tolerance, and ones across the cell boundary.
+std::vector<std::vector<double>> get_shifts(double const lattice_length,
+                                            double const symprec) {
+    double const small = 0.3 * symprec / lattice_length;
+    double const large = 3 * symprec / lattice_length;
+    return {{0, 0, 0},        {small, 0, -small}, {large, 0, 0},
+            {0, -large, 0},   {1, 0, -1},         {-1 + small, 1, 0},
+            {0, 0, 1 + large}};
+}
+}  // namespace
+
+TEST(Overlap, atoms_on_bin_and_cell_boundaries) {
+    // Simple cubic supercell of two types. The atoms of the first type are
+    // exactly on the boundaries of the bins of the cell list and slightly
+    // off them on both sides, including negative coordinates and ones
+    // just below 1.
+    int const n = 4;
+    double const a = 2.0 * n;
+    double const symprec = 0.05;
+    double const offsets[] = {0, -1e-12, 1e-12, -0.2 * symprec / a};
+    double lattice[3][3] = {{a, 0, 0}, {0, a, 0}, {0, 0, a}};
+    std::vector<double> positions;
+    std::vector<int> types;
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int k = 0; k < n; k++) {
+                double const offset = offsets[(i + j + k) % 4];
+                positions.insert(positions.end(),
+                                 {(double)i / n + offset, (double)j / n,
+                                  (double)k / n - offset});
+                types.push_back(1);
+                positions.insert(positions.end(),
+                                 {(i + 0.5) / n, (j + 0.5) / n,
+                                  (k + 0.5) / n + offset});
+                types.push_back(2);
+            }
+        }
+    }
+    // Wrap some coordinates to just below 1 and negative values.
+    for (size_t l = 0; l < positions.size(); l += 7) {
+        if (positions[l] < 1e-9) {
+            positions[l] += 1;
+        }
+    }
+    for (size_t l = 1; l < positions.size(); l += 11) {
+        if (positions[l] > 1 - 1e-9) {
+            positions[l] -= 1;
+        }
+    }
+
+    int const num_atom = (int)types.size();
+    Cell *cell = cel_alloc_cell(num_atom, NOSPIN);
+    ASSERT_NE(cell, nullptr);
+    cel_set_cell(cell, lattice, (double(*)[3])positions.data(), types.data());
+
+    // The bins of the first type are 1 / n wide.
+    OverlapChecker *checker = ovl_overlap_checker_init(cell);
+    ASSERT_NE(checker, nullptr);
+    for (int k = 0; k < 3; k++) {
+        EXPECT_EQ(checker->type_grid[0][k], n);
+    }
+    ovl_overlap_checker_free(checker);
+
+    int const num_overlap = compare_with_brute_force(
+        cell, {identity, inversion, four_fold_z, three_fold_111},
+        get_shifts(a, symprec), symprec, false);
+    EXPECT_GT(num_overlap, 0);
+
+    cel_free_cell(cell);
+}
+
+TEST(Overlap, skewed_lattice) {
+    // Supercell of a strongly skewed triclinic lattice whose angles are
+    // about 7 degrees, where the bins are long thin prisms and the
+    // Cartesian distances differ much from the fractional ones.
+    int const n = 5;
+    double const symprec = 0.02;
+    double lattice[3][3] = {{3.0 * n, 2.9 * n, 2.8 * n},
+                            {0, 0.4 * n, 0.2 * n},
+                            {0, 0, 0.35 * n}};
+    std::vector<double> positions;
+    std::vector<int> types;
+    std::mt19937 rng(12345);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int k = 0; k < n; k++) {
+                positions.insert(positions.end(), {(double)i / n,
+                                                   (double)j / n,
+                                                   (double)k / n});
+                types.push_back(1);
+                positions.insert(positions.end(),
+                                 {(i + 0.3) / n, (j + 0.6) / n,
+                                  (k + 0.1) / n});
+                types.push_back(2);
+            }
+        }
+    }
+    for (size_t l = 0; l < types.size(); l++) {
+        displace(&positions[3 * l], lattice, 0.2 * symprec, rng);
+    }
+
+    int const num_atom = (int)types.size();
+    Cell *cell = cel_alloc_cell(num_atom, NOSPIN);
+    ASSERT_NE(cell, nullptr);
+    cel_set_cell(cell, lattice, (double(*)[3])positions.data(), types.data());
+
+    int const num_overlap = compare_with_brute_force(
+        cell, {identity, inversion}, get_shifts(3.0 * n, symprec), symprec,
+        false);
+    EXPECT_GT(num_overlap, 0);
+
+    cel_free_cell(cell);
+}
+
+TEST(Overlap, layer_cells) {
+    // Atoms near both surfaces of a slab overlap with each other across
+    // the cell boundary along the aperiodic axis only for the bulk check.
+    int const n = 6;
+    double const symprec = 0.05;
+    double const a = 3.0 * n;
+    double const c = 10.0;
+    std::mt19937 rng(54321);
+
+    for (int aperiodic_axis = 0; aperiodic_axis < 3; aperiodic_axis++) {
+        int const u = (aperiodic_axis + 1) % 3;
+        int const v = (aperiodic_axis + 2) % 3;
+        int const w = aperiodic_axis;
+        double lattice[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+        std::vector<double> positions;
+        std::vector<int> types;
+        double pos[3];
+
+        lattice[u][u] = a;
+        lattice[v][v] = a;
+        lattice[w][w] = c;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                pos[u] = (double)i / n;
+                pos[v] = (double)j / n;
+                pos[w] = 0.999;
+                positions.insert(positions.end(), pos, pos + 3);
+                types.push_back(1);
+                pos[u] = (i + 0.5) / n;
+                pos[v] = (j + 0.5) / n;
+                pos[w] = 0.5;
+                positions.insert(positions.end(), pos, pos + 3);
+                types.push_back(2);
+            }
+        }
+        for (size_t l = 0; l < types.size(); l++) {
+            displace(&positions[3 * l], lattice, 0.1 * symprec, rng);
+        }
+
+        // Mirror and two-fold rotation reversing the aperiodic axis
+        int mirror[3][3], two_fold[3][3];
+        for (int k = 0; k < 3; k++) {
+            for (int l = 0; l < 3; l++) {
+                mirror[k][l] = mirror_z[(k + 2 - w) % 3][(l + 2 - w) % 3];
+                two_fold[k][l] = two_fold_x[(k + 3 - u) % 3][(l + 3 - u) % 3];
+            }
+        }
+
+        int const num_atom = (int)types.size();
+        Cell *layer_cell = cel_alloc_cell(num_atom, NOSPIN);
+        Cell *bulk_cell = cel_alloc_cell(num_atom, NOSPIN);
+        ASSERT_NE(layer_cell, nullptr);
+        ASSERT_NE(bulk_cell, nullptr);
+        cel_set_layer_cell(layer_cell, lattice,
+                           (double(*)[3])positions.data(), types.data(),
+                           aperiodic_axis);
+        cel_set_cell(bulk_cell, lattice, (double(*)[3])positions.data(),
+                     types.data());
+
+        int const num_layer_overlap = compare_with_brute_force(
+            layer_cell, {identity, inversion, mirror, two_fold},
+            get_shifts(a, symprec), symprec, false);
+        int const num_bulk_overlap = compare_with_brute_force(
+            bulk_cell, {identity, inversion, mirror, two_fold},
+            get_shifts(a, symprec), symprec, false);
+        EXPECT_GT(num_layer_overlap, 0);
+        EXPECT_GT(num_bulk_overlap, num_layer_overlap);
+
+        cel_free_cell(layer_cell);
+        cel_free_cell(bulk_cell);
+    }
+}
+
+TEST(Overlap, near_duplicate_atoms) {
+    // Pairs of atoms of the same type slightly farther apart than the
+    // tolerance, so that a transformed atom can be close to both of them.
+    int const n = 4;
+    double const symprec = 0.1;
+    double const a = 2.5 * n;
+    double lattice[3][3] = {{a, 0, 0}, {0, a, 0}, {0, 0, a}};
+    double const gaps[] = {1.2 * symprec, 1.6 * symprec, 2.5 * symprec};
+    std::vector<double> positions;
+    std::vector<int> types;
+    std::mt19937 rng(2024);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            for (int k = 0; k < n; k++) {
+                double const gap = gaps[(i + 2 * j + k) % 3] / a;
+                positions.insert(positions.end(),
+                                 {(double)i / n - gap / 2, (double)j / n,
+                                  (double)k / n});
+                types.push_back(1);
+                positions.insert(positions.end(),
+                                 {(double)i / n + gap / 2, (double)j / n,
+                                  (double)k / n});
+                types.push_back(1);
+                positions.insert(positions.end(),
+                                 {(i + 0.5) / n, (j + 0.5) / n,
+                                  (k + 0.5) / n});
+                types.push_back(2);
+            }
+        }
+    }
+    for (size_t l = 0; l < types.size(); l++) {
+        displace(&positions[3 * l], lattice, 0.05 * symprec, rng);
+    }
+
+    int const num_atom = (int)types.size();
+    Cell *cell = cel_alloc_cell(num_atom, NOSPIN);
+    ASSERT_NE(cell, nullptr);
+    cel_set_cell(cell, lattice, (double(*)[3])positions.data(), types.data());
+
+    int const num_overlap = compare_with_brute_force(
+        cell, {identity, inversion, two_fold_x}, get_shifts(a, symprec),
+        symprec, true);
+    EXPECT_GT(num_overlap, 0);
+
+    cel_free_cell(cell);
+}
@@ -0,0 +1,145 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "spacegroup.h"
+}
+
+namespace {
+// Cell with two general orbits of the operations of hall_number. The metric
+// is averaged over the rotations, so the lattice is compatible with the
+// setting, e.g., its unique axis and cell choice.
+int set_cell_of_hall_number(double lattice[3][3], double position[][3],
+                            int types[], int const hall_number) {
+    int rotations[192][3][3];
+    double translations[192][3];
+    double const metric0[3][3] = {{30, 3, 2}, {3, 40, 4}, {2, 4, 50}};
+    double const points[2][3] = {{0.11, 0.23, 0.37}, {0.31, 0.17, 0.06}};
+    double metric[3][3] = {};
+    double chol[3][3] = {};
+    double x[3], d;
+    int i, j, k, l, m, n, num_sym, num_atom, is_found;
+
+    num_sym = spg_get_symmetry_from_database(rotations, translations,
+                                             hall_number);
+
+    for (i = 0; i < num_sym; i++) {
+        for (j = 0; j < 3; j++) {
+            for (k = 0; k < 3; k++) {
+                for (l = 0; l < 3; l++) {
+                    for (m = 0; m < 3; m++) {
+                        metric[j][k] += rotations[i][l][j] * metric0[l][m] *
+                                        rotations[i][m][k] / num_sym;
+                    }
+                }
+            }
+        }
+    }
+
+    // metric = chol chol^T with the basis vectors in the columns of chol^T
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j <= i; j++) {
+            d = metric[i][j];
+            for (k = 0; k < j; k++) {
+                d -= chol[i][k] * chol[j][k];
+            }
+            chol[i][j] = (i == j) ? std::sqrt(d) : d / chol[j][j];
+        }
+    }
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++) {
+            lattice[i][j] = chol[j][i];
+        }
+    }
+
+    num_atom = 0;
+    for (n = 0; n < 2; n++) {
+        for (i = 0; i < num_sym; i++) {
+            for (j = 0; j < 3; j++) {
+                x[j] = translations[i][j];
+                for (k = 0; k < 3; k++) {
+                    x[j] += rotations[i][j][k] * points[n][k];
+                }
+                x[j] -= std::floor(x[j]);
+            }
+            is_found = 0;
+            for (j = 0; j < num_atom; j++) {
+                d = 0;
+                for (k = 0; k < 3; k++) {
+                    d += std::fabs(x[k] - position[j][k] -
+                                   std::nearbyint(x[k] - position[j][k]));
+                }
+                if (d < 1e-8) {
+                    is_found = 1;
+                    break;
+                }
+            }
+            if (!is_found) {
+                for (k = 0; k < 3; k++) {
+                    position[num_atom][k] = x[k];
+                }
+                types[num_atom] = n + 1;
+                num_atom++;
+            }
+        }
+    }
+
+    return num_atom;
+}
+
+int get_hall_number(double const lattice[3][3], double const position[][3],
+                    int const types[], int const num_atom,
+                    double const symprec, int const is_pruning) {
+    int hall_number;
+    SpglibDataset *dataset;
+
+    spa_set_fingerprint_pruning(is_pruning);
+    dataset = spg_get_dataset(lattice, position, types, num_atom, symprec);
+    spa_set_fingerprint_pruning(1);
+    if (dataset == NULL) {
+        return 0;
+    }
+    hall_number = dataset->hall_number;
+    spg_free_dataset(dataset);
+    return hall_number;
+}
+}  // namespace
+
+TEST(Spacegroup, test_fingerprint_pruning_in_nonstandard_settings) {
+    double lattice[3][3];
+    double position0[384][3], position[384][3];
+    int types[384];
+    double const amplitudes[] = {0, 0.0005, 0.001};
+    double const symprecs[] = {1e-5, 0.05, 0.1};
+    int i, j, k, hall_number, num_atom, pruned, unpruned;
+    SpglibSpacegroupType spg_type;
+
+    // All monoclinic and orthorhombic settings of the database
+    for (hall_number = 3; hall_number <= 348; hall_number++) {
+        spg_type = spg_get_spacegroup_type(hall_number);
+        ASSERT_GE(spg_type.number, 3);
+        ASSERT_LE(spg_type.number, 74);
+
+        num_atom = set_cell_of_hall_number(lattice, position0, types,
+                                           hall_number);
+        for (i = 0; i < 3; i++) {
+            // Noisy positions
+            for (j = 0; j < num_atom; j++) {
+                for (k = 0; k < 3; k++) {
+                    position[j][k] =
+                        position0[j][k] +
+                        amplitudes[i] * ((j * 7 + k * 3) % 5 - 2) / 2;
+                }
+            }
+            pruned = get_hall_number(lattice, position, types, num_atom,
+                                     symprecs[i], 1);
+            unpruned = get_hall_number(lattice, position, types, num_atom,
+                                       symprecs[i], 0);
+            EXPECT_EQ(pruned, unpruned)
+                << "hall_number=" << hall_number << " noise=" << i;
+            EXPECT_EQ(spg_get_spacegroup_type(pruned).number, spg_type.number)
+                << "hall_number=" << hall_number << " noise=" << i;
+        }
+    }
+}
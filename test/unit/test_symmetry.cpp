@@ -2,15 +2,19 @@
 
 extern "C" {
 #include "cell.h"
+#include "mathfunc.h"
+#include "primitive.h"
 #include "symmetry.h"
 #include "utils.h"
 }
 
 TEST(Symmetry, test_get_lattice_symmetry_layer) {
     Cell *cell;
+    SearchContext *context;
     Symmetry *symmetry;
 
     cell = nullptr;
+    context = nullptr;
     symmetry = nullptr;
 
     int const size = 1;
@@ -30,14 +34,190 @@ TEST(Symmetry, test_get_lattice_symmetry_layer) {
     for (int aperiodic_axis = 0; aperiodic_axis < 3; aperiodic_axis++) {
         cel_set_layer_cell(cell, lattice, positions, types, aperiodic_axis);
 
+        context = sym_alloc_search_context(cell);
+        ASSERT_NE(context, nullptr);
+
         // Bravais group of the two-dimensional lattice is 4/mmm
-        symmetry = sym_get_operation(cell, symprec, angle_tolerance);
+        symmetry = sym_get_operation(context, symprec, angle_tolerance);
         EXPECT_EQ(symmetry->size, 16);
 
         sym_free_symmetry(symmetry);
         symmetry = nullptr;
+        sym_free_search_context(context);
+        context = nullptr;
     }
 
     cel_free_cell(cell);
     cell = nullptr;
 }
+
+TEST(Symmetry, test_get_lattice_symmetry_bravais) {
+    Cell *cell;
+    SearchContext *context;
+    Symmetry *symmetry;
+
+    cell = nullptr;
+    context = nullptr;
+    symmetry = nullptr;
+
+    // Orders of the lattice point groups of one-atom cells
+    double const lattices[5][3][3] = {
+        {{4, 0, 0}, {0, 4, 0}, {0, 0, 4}},             // m-3m
+        {{0, 2, 2}, {2, 0, 2}, {2, 2, 0}},             // m-3m
+        {{3, -1.5, 0}, {0, 2.598076, 0}, {0, 0, 5}},   // 6/mmm
+        {{4, 0, 0}, {0, 4, 0}, {0, 0, 5}},             // 4/mmm
+        {{4, 0.3, 0.2}, {0, 5, 0.4}, {0, 0, 6}},       // -1
+    };
+    int const orders[5] = {48, 48, 24, 16, 2};
+    double positions[1][3] = {{0, 0, 0}};
+    int const types[1] = {0};
+    double const symprec = 1e-5;
+
+    cell = cel_alloc_cell(1, NOSPIN);
+    ASSERT_NE(cell, nullptr);
+    for (int i = 0; i < 5; i++) {
+        cel_set_cell(cell, lattices[i], positions, types);
+        context = sym_alloc_search_context(cell);
+        ASSERT_NE(context, nullptr);
+
+        // The result must not depend on the type of the angle tolerance
+        for (double const angle_tolerance : {-1.0, 1.0}) {
+            symmetry = sym_get_operation(context, symprec, angle_tolerance);
+            ASSERT_NE(symmetry, nullptr);
+            EXPECT_EQ(symmetry->size, orders[i]);
+            sym_free_symmetry(symmetry);
+            symmetry = nullptr;
+        }
+
+        sym_free_search_context(context);
+        context = nullptr;
+    }
+
+    cel_free_cell(cell);
+    cell = nullptr;
+}
+
+TEST(Symmetry, test_pure_translation_reuse) {
+    // 2x2x1 supercell of rocksalt with displaced atoms
+    double lattice[3][3] = {{8, 0, 0}, {0, 8, 0}, {0, 0, 4}};
+    double positions[16][3];
+    int types[16];
+    double const displacements[8] = {0.004, -0.003, 0.002,  0.0,
+                                      -0.004, 0.003, -0.001, 0.001};
+
+    for (int i = 0; i < 4; i++) {
+        double const x = 0.5 * (i % 2), y = 0.5 * (i / 2);
+        double const sites[4][3] = {{0, 0, 0},
+                                    {0.25, 0.25, 0},
+                                    {0.25, 0, 0.5},
+                                    {0, 0.25, 0.5}};
+        for (int j = 0; j < 4; j++) {
+            positions[4 * i + j][0] = x + sites[j][0] + displacements[i + j];
+            positions[4 * i + j][1] = y + sites[j][1];
+            positions[4 * i + j][2] = sites[j][2];
+            types[4 * i + j] = j < 2 ? 1 : 2;
+        }
+    }
+
+    Cell *cell = cel_alloc_cell(16, NOSPIN);
+    ASSERT_NE(cell, nullptr);
+    cel_set_cell(cell, lattice, positions, types);
+
+    // Pure translations at the reduced tolerances are searched among
+    // those found before and must be the same as searched from scratch.
+    SearchContext *context = sym_alloc_search_context(cell);
+    ASSERT_NE(context, nullptr);
+    for (double const symprec : {0.1, 0.05, 0.02, 1e-3, 0.1}) {
+        VecDBL *pure_trans = sym_get_pure_translation(context, symprec);
+        SearchContext *new_context = sym_alloc_search_context(cell);
+        ASSERT_NE(new_context, nullptr);
+        VecDBL *expected = sym_get_pure_translation(new_context, symprec);
+        ASSERT_NE(pure_trans, nullptr);
+        ASSERT_NE(expected, nullptr);
+        ASSERT_EQ(pure_trans->size, expected->size);
+        for (int i = 0; i < pure_trans->size; i++) {
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(pure_trans->vec[i][j], expected->vec[i][j]);
+            }
+        }
+        mat_free_VecDBL(pure_trans);
+        mat_free_VecDBL(expected);
+        sym_free_search_context(new_context);
+    }
+    // The first search and the one with the increased tolerance are not
+    // reused.
+    EXPECT_EQ(context->num_pure_trans_reuses, 3);
+
+    sym_free_search_context(context);
+    cel_free_cell(cell);
+}
+
+TEST(Symmetry, test_retried_search_reuses_context) {
+    // The tolerances are reduced as in the retries of det_determine_all
+    // when the space group is not found. The searches with one context
+    // reuse its state and must give the same results as new contexts.
+    double lattice[3][3] = {{7.9, 0.1, 0}, {0, 8.1, 0}, {0.2, 0, 4}};
+    double positions[8][3] = {
+        {0, 0, 0},         {0.502, 0.001, 0}, {0.001, 0.498, 0},
+        {0.499, 0.5, 0.003}, {0.25, 0.25, 0.5}, {0.753, 0.249, 0.5},
+        {0.25, 0.751, 0.5}, {0.748, 0.75, 0.502}};
+    int types[8] = {1, 1, 1, 1, 2, 2, 2, 2};
+    double const angle_tolerance = -1;
+
+    Cell *cell = cel_alloc_cell(8, NOSPIN);
+    ASSERT_NE(cell, nullptr);
+    cel_set_cell(cell, lattice, positions, types);
+
+    SearchContext *context = sym_alloc_search_context(cell);
+    ASSERT_NE(context, nullptr);
+    int num_retries = 0;
+    for (double tolerance = 0.1; tolerance > 1e-3; tolerance *= 0.95) {
+        SearchContext *new_context = sym_alloc_search_context(cell);
+        ASSERT_NE(new_context, nullptr);
+
+        Primitive *primitive =
+            prm_get_primitive(context, tolerance, angle_tolerance);
+        Primitive *expected =
+            prm_get_primitive(new_context, tolerance, angle_tolerance);
+        ASSERT_NE(primitive, nullptr);
+        ASSERT_NE(expected, nullptr);
+        EXPECT_EQ(primitive->cell->size, expected->cell->size);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(primitive->cell->lattice[i][j],
+                          expected->cell->lattice[i][j]);
+            }
+        }
+        prm_free_primitive(primitive);
+        prm_free_primitive(expected);
+
+        Symmetry *symmetry =
+            sym_get_operation(context, tolerance, angle_tolerance);
+        Symmetry *expected_symmetry =
+            sym_get_operation(new_context, tolerance, angle_tolerance);
+        ASSERT_NE(symmetry, nullptr);
+        ASSERT_NE(expected_symmetry, nullptr);
+        EXPECT_EQ(symmetry->size, expected_symmetry->size);
+        sym_free_symmetry(symmetry);
+        sym_free_symmetry(expected_symmetry);
+
+        sym_free_search_context(new_context);
+        num_retries++;
+    }
+    EXPECT_EQ(context->num_pure_trans_reuses, num_retries - 1);
+    EXPECT_EQ(context->num_lattice_sym_reuses, num_retries - 1);
+
+    // Failures are remembered for the exact tolerances and steps only.
+    EXPECT_EQ(context->num_failed_searches, 0);
+    sym_set_failed(context, SEARCH_STEP_SPACEGROUP, 0.1, angle_tolerance);
+    EXPECT_EQ(context->num_failed_searches, 1);
+    EXPECT_TRUE(
+        sym_has_failed(context, SEARCH_STEP_SPACEGROUP, 0.1, angle_tolerance));
+    EXPECT_FALSE(
+        sym_has_failed(context, SEARCH_STEP_PRIMITIVE, 0.1, angle_tolerance));
+    EXPECT_FALSE(sym_has_failed(context, SEARCH_STEP_SPACEGROUP, 0.1 * 0.95,
+                                angle_tolerance));
+
+    sym_free_search_context(context);
+    cel_free_cell(cell);
+}